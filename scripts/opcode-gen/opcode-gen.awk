@@ -177,42 +177,13 @@ emission == "dexbox-opcode-names" {
     }
 }
 
-emission == "dexbox-widths" {
+emission == "dexbox-infos" {
     emissionHandled = 1;
 
-    col = 1;
     for (i = 0; i <= MAX_PACKED_OPCODE; i++) {
-        value = sprintf("%d,", packedWidth[i]);
-        col = colPrint(value, (i == MAX_PACKED_OPCODE), col, 16, 2, "    ");
-    }
-}
-
-emission == "dexbox-flags" {
-    emissionHandled = 1;
-
-    for (i = 0; i <= MAX_PACKED_OPCODE; i++) {
-        value = flagsToC(packedFlags[i]);
-        printf("    %s,\n", value);
-    }
-}
-
-emission == "dexbox-formats" {
-    emissionHandled = 1;
-
-    col = 1;
-    for (i = 0; i <= MAX_PACKED_OPCODE; i++) {
-        value = sprintf("DX_INSTR_FMT_%s,", packedFormat[i]);
-        col = colPrint(value, (i == MAX_PACKED_OPCODE), col, 7, 9, "    ");
-    }
-}
-
-emission == "dexbox-index-types" {
-    emissionHandled = 1;
-
-    col = 1;
-    for (i = 0; i <= MAX_PACKED_OPCODE; i++) {
-        value = sprintf("%s,", indexTypeValues[packedIndexType[i]]);
-        col = colPrint(value, (i == MAX_PACKED_OPCODE), col, 3, 19, "    ");
+        printf("    DX_INSTR_INFO(DX_INSTR_FMT_%s, %s, %s, %d), // %02x %s\n",
+               packedFormat[i], indexTypeValues[packedIndexType[i]],
+               flagsToC(packedFlags[i]), packedWidth[i], i, packedName[i]);
     }
 }
 
@@ -231,19 +202,6 @@ emission != "" {
 # Helper functions.
 #
 
-# Helper to print out an element in a multi-column fashion. It returns
-# the (one-based) column number that the next element will be printed
-# in.
-function colPrint(value, isLast, col, numCols, colWidth, linePrefix) {
-    isLast = (isLast || (col == numCols));
-    printf("%s%-*s%s",
-        (col == 1) ? linePrefix : " ",
-        isLast ? 1 : colWidth, value,
-        isLast ? "\n" : "");
-
-    return (col % numCols) + 1;
-}
-
 # Read the bytecode description file.
 function readBytecodes(i, parts, line, cmd, status, count) {
     # locals: parts, line, cmd, status, count
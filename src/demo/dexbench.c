@@ -0,0 +1,1702 @@
+/*!A lightweight dex file parsing library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2015-2020, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        dexbench.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "dexbox/dexbox.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the bench function type
+typedef tb_void_t           (*dx_bench_func_t)(tb_char_t const* url, tb_size_t loop);
+
+// the bench type
+typedef struct __dx_bench_t
+{
+    // the name
+    tb_char_t const*        name;
+
+    // the function
+    dx_bench_func_t         func;
+
+}dx_bench_t;
+
+// the urls type of the batch bench
+typedef struct __dx_bench_urls_t
+{
+    // the urls
+    tb_char_t const**       urls;
+
+    // the url count
+    tb_size_t               size;
+
+    // the url maxn
+    tb_size_t               maxn;
+
+}dx_bench_urls_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t dx_bench_visit_method(dx_file_ref_t file, dx_file_visit_class_ref_t clazz, dx_file_visit_method_ref_t method, tb_cpointer_t udata)
+{
+    // count the methods with code
+    if (method->code_off) (*((tb_size_t*)udata))++;
+    return tb_true;
+}
+static tb_long_t dx_bench_batch_walk(tb_char_t const* path, tb_file_info_t const* info, tb_cpointer_t priv)
+{
+    // collect the dex files
+    dx_bench_urls_t*    urls = (dx_bench_urls_t*)priv;
+    tb_size_t           n = tb_strlen(path);
+    if (info->type == TB_FILE_TYPE_FILE && n > 4 && !tb_stricmp(path + n - 4, ".dex"))
+    {
+        // grow urls
+        if (urls->size == urls->maxn)
+        {
+            tb_size_t           maxn = urls->maxn? urls->maxn << 1 : 1024;
+            tb_char_t const**   data = (tb_char_t const**)tb_ralloc((tb_pointer_t)urls->urls, maxn * sizeof(tb_char_t const*));
+            tb_assert_and_check_return_val(data, TB_DIRECTORY_WALK_CODE_END);
+            urls->urls = data;
+            urls->maxn = maxn;
+        }
+        urls->urls[urls->size++] = tb_strdup(path);
+    }
+    return TB_DIRECTORY_WALK_CODE_CONTINUE;
+}
+static tb_bool_t dx_bench_batch_func(tb_char_t const* url, tb_size_t index, dx_file_ref_t file, tb_cpointer_t udata)
+{
+    // count the classes and exit it
+    if (file)
+    {
+        (*((tb_size_t*)udata)) += dx_file_class_size(file);
+        dx_file_exit(file);
+    }
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * benches
+ */
+static tb_void_t dx_bench_adler32(tb_char_t const* url, tb_size_t loop)
+{
+    // load dex file without checksum
+    dx_file_ref_t dexfile = dx_file_load_from_url(url, tb_false);
+    tb_assert_and_check_return(dexfile);
+
+    // skip magic and checksum
+    tb_byte_t const*    data = dx_file_data(dexfile) + 12;
+    tb_size_t           size = dx_file_size(dexfile) - 12;
+
+    // the serial tbox implementation
+    tb_size_t   i = 0;
+    tb_uint32_t adler0 = 0;
+    tb_hong_t   time0 = tb_uclock();
+    for (i = 0; i < loop; i++) adler0 = tb_adler32_make(data, size, 1);
+    time0 = tb_uclock() - time0;
+
+    // the vectorized kernel
+    tb_uint32_t adler1 = 0;
+    tb_hong_t   time1 = tb_uclock();
+    for (i = 0; i < loop; i++) adler1 = dx_adler32_make(data, size, 1);
+    time1 = tb_uclock() - time1;
+
+    // the chunked kernel on multiple threads
+    tb_uint32_t adler2 = 0;
+    tb_hong_t   time2 = tb_uclock();
+    for (i = 0; i < loop; i++) adler2 = dx_adler32_make_parallel(data, size, 1, 0);
+    time2 = tb_uclock() - time2;
+
+    // trace
+    tb_printf("adler32: %lu bytes x %lu\n", size, loop);
+    tb_printf("    serial:     %lld us, %#08x\n", time0, adler0);
+    tb_printf("    vectorized: %lld us, %#08x %s\n", time1, adler1, adler1 == adler0? "ok" : "mismatch");
+    tb_printf("    parallel:   %lld us, %#08x %s\n", time2, adler2, adler2 == adler0? "ok" : "mismatch");
+
+    // exit dex file
+    dx_file_exit(dexfile);
+}
+
+static tb_void_t dx_bench_checksum(tb_char_t const* url, tb_size_t loop)
+{
+    // load and iterate all classes with the given checksum mode
+    tb_size_t   i = 0;
+    tb_size_t   mode = 0;
+    tb_hong_t   times[3] = {0};
+    for (mode = DX_FILE_CHECKSUM_NONE; mode <= DX_FILE_CHECKSUM_ASYNC; mode++)
+    {
+        tb_hong_t time = tb_uclock();
+        for (i = 0; i < loop; i++)
+        {
+            // load dex file
+            dx_file_ref_t dexfile = dx_file_load_from_url(url, mode);
+            tb_assert_and_check_return(dexfile);
+
+            // load all classes
+            tb_size_t j = 0;
+            tb_size_t n = dx_file_class_size(dexfile);
+            for (j = 0; j < n; j++) dx_file_class(dexfile, j);
+
+            // wait the verification
+            if (dx_file_verify_wait(dexfile, -1) == DX_FILE_VERIFY_FAILED)
+                tb_printf("bad checksum!\n");
+
+            // exit dex file
+            dx_file_exit(dexfile);
+        }
+        times[mode] = tb_uclock() - time;
+    }
+
+    // trace
+    tb_printf("checksum: load and iterate classes x %lu\n", loop);
+    tb_printf("    none:  %lld us\n", times[DX_FILE_CHECKSUM_NONE]);
+    tb_printf("    sync:  %lld us\n", times[DX_FILE_CHECKSUM_SYNC]);
+    tb_printf("    async: %lld us\n", times[DX_FILE_CHECKSUM_ASYNC]);
+}
+
+static tb_void_t dx_bench_find(tb_char_t const* url, tb_size_t loop)
+{
+    // load dex file
+    dx_file_ref_t dexfile = dx_file_load_from_url(url, tb_false);
+    tb_assert_and_check_return(dexfile);
+
+    // the class count
+    tb_size_t i = 0;
+    tb_size_t j = 0;
+    tb_size_t k = 0;
+    tb_size_t n = dx_file_class_size(dexfile);
+
+    // find all classes with the linear scan
+    tb_size_t   found0 = 0;
+    tb_hong_t   time0 = tb_uclock();
+    for (i = 0; i < loop; i++)
+    {
+        for (j = 0; j < n; j++)
+        {
+            tb_char_t const* descriptor = dx_class_descriptor(dx_file_class(dexfile, j));
+            for (k = 0; k < n; k++)
+            {
+                if (!tb_strcmp(dx_class_descriptor(dx_file_class(dexfile, k)), descriptor))
+                {
+                    found0++;
+                    break;
+                }
+            }
+        }
+    }
+    time0 = tb_uclock() - time0;
+
+    // find all classes with the hash index
+    tb_size_t   found1 = 0;
+    tb_hong_t   time1 = tb_uclock();
+    for (i = 0; i < loop; i++)
+    {
+        for (j = 0; j < n; j++)
+        {
+            if (dx_file_class_find(dexfile, dx_class_descriptor(dx_file_class(dexfile, j))) == dx_file_class(dexfile, j))
+                found1++;
+        }
+    }
+    time1 = tb_uclock() - time1;
+
+    // trace
+    tb_printf("find: %lu classes x %lu\n", n, loop);
+    tb_printf("    linear: %lld us, found: %lu\n", time0, found0);
+    tb_printf("    hash:   %lld us, found: %lu %s\n", time1, found1, found1 == found0? "ok" : "mismatch");
+
+    // exit dex file
+    dx_file_exit(dexfile);
+}
+
+static tb_void_t dx_bench_arena(tb_char_t const* url, tb_size_t loop)
+{
+    // init the shared arena
+    dx_arena_ref_t arena = dx_arena_init(0);
+    tb_assert_and_check_return(arena);
+
+    // load all classes with the own arena and the shared arena
+    tb_size_t   i = 0;
+    tb_size_t   j = 0;
+    tb_size_t   k = 0;
+    tb_hong_t   times[2] = {0};
+    for (k = 0; k < 2; k++)
+    {
+        tb_hong_t time = tb_uclock();
+        for (i = 0; i < loop; i++)
+        {
+            // load dex file
+            dx_file_ref_t dexfile = dx_file_load_from_url(url, tb_false);
+            tb_assert_and_check_break(dexfile);
+
+            // use the shared arena
+            if (k) dx_file_arena_set(dexfile, arena);
+
+            // load all classes
+            tb_size_t n = dx_file_class_size(dexfile);
+            for (j = 0; j < n; j++) dx_file_class(dexfile, j);
+
+            // exit dex file
+            dx_file_exit(dexfile);
+
+            // reuse the shared arena
+            if (k) dx_arena_clear(arena);
+        }
+        times[k] = tb_uclock() - time;
+    }
+
+    // trace
+    tb_printf("arena: load all classes x %lu\n", loop);
+    tb_printf("    owned:  %lld us\n", times[0]);
+    tb_printf("    shared: %lld us\n", times[1]);
+
+    // exit the shared arena
+    dx_arena_exit(arena);
+}
+
+static tb_void_t dx_bench_walk(tb_char_t const* url, tb_size_t loop)
+{
+    // init arena for getting the memory usage
+    dx_arena_ref_t arena = dx_arena_init(0);
+    tb_assert_and_check_return(arena);
+
+    // walk all methods of all classes
+    tb_size_t   i = 0;
+    tb_size_t   j = 0;
+    tb_size_t   k = 0;
+    tb_size_t   memory = 0;
+    tb_size_t   methods = 0;
+    tb_size_t   params = 0;
+    tb_hong_t   time = tb_uclock();
+    for (i = 0; i < loop; i++)
+    {
+        // load dex file
+        dx_file_ref_t dexfile = dx_file_load_from_url(url, tb_false);
+        tb_assert_and_check_break(dexfile);
+        dx_file_arena_set(dexfile, arena);
+
+        // walk all classes
+        tb_size_t n = dx_file_class_size(dexfile);
+        for (j = 0; j < n; j++)
+        {
+            dx_class_ref_t clazz = dx_file_class(dexfile, j);
+            if (!clazz) continue;
+
+            // walk all methods
+            tb_size_t direct_size = dx_class_method_direct_size(clazz);
+            tb_size_t method_size = direct_size + dx_class_method_virtual_size(clazz);
+            for (k = 0; k < method_size; k++)
+            {
+                dx_method_ref_t method = k < direct_size? dx_class_method_direct(clazz, k) : dx_class_method_virtual(clazz, k - direct_size);
+                if (dx_method_code(method) || dx_method_access(method)) methods++;
+                params += dx_proto_param_size(dx_method_proto(method));
+            }
+        }
+
+        // exit dex file
+        memory = dx_arena_size(arena);
+        dx_file_exit(dexfile);
+        dx_arena_clear(arena);
+    }
+    time = tb_uclock() - time;
+
+    // trace
+    tb_printf("walk: all methods of all classes x %lu\n", loop);
+    tb_printf("    time:   %lld us, methods: %lu, params: %lu\n", time, methods / (loop? loop : 1), params / (loop? loop : 1));
+    tb_printf("    memory: %lu bytes of classes, fields and methods\n", memory);
+
+    // exit arena
+    dx_arena_exit(arena);
+}
+
+static tb_void_t dx_bench_loadall(tb_char_t const* url, tb_size_t loop)
+{
+    // load all classes with 1, 2, 4, ... workers
+    tb_size_t nthreads = 1;
+    tb_size_t nthreads_max = tb_processor_count();
+    for (nthreads = 1; nthreads <= nthreads_max; nthreads <<= 1)
+    {
+        // done
+        tb_size_t               i = 0;
+        tb_size_t               n = 0;
+        tb_hong_t               time = 0;
+        dx_file_load_stat_t     stats[DX_FILE_LOAD_WORKER_MAXN];
+        dx_file_load_stat_t     total[DX_FILE_LOAD_WORKER_MAXN];
+        tb_memset(total, 0, sizeof(total));
+        for (i = 0; i < loop; i++)
+        {
+            // load dex file
+            dx_file_ref_t dexfile = dx_file_load_from_url(url, tb_false);
+            tb_assert_and_check_break(dexfile);
+
+            // load all classes
+            tb_hong_t t = tb_uclock();
+            n = dx_file_load_all(dexfile, nthreads, stats);
+            time += tb_uclock() - t;
+
+            // sum statistics
+            tb_size_t j = 0;
+            for (j = 0; j < n; j++)
+            {
+                total[j].classes += stats[j].classes;
+                total[j].methods += stats[j].methods;
+                total[j].time    += stats[j].time;
+            }
+
+            // exit dex file
+            dx_file_exit(dexfile);
+        }
+
+        // trace
+        tb_printf("loadall: %lu workers x %lu, %lld us\n", n, loop, time);
+        for (i = 0; i < n; i++)
+            tb_printf("    worker[%lu]: %lu classes, %lu methods, %lld us\n", i, total[i].classes, total[i].methods, total[i].time);
+    }
+}
+
+static tb_void_t dx_bench_visit(tb_char_t const* url, tb_size_t loop)
+{
+    // load dex file
+    dx_file_ref_t dexfile = dx_file_load_from_url(url, tb_false);
+    tb_assert_and_check_return(dexfile);
+
+    // count the methods with code by the caching classes
+    tb_size_t   i = 0;
+    tb_size_t   j = 0;
+    tb_size_t   k = 0;
+    tb_size_t   count0 = 0;
+    tb_hong_t   time0 = tb_uclock();
+    for (i = 0; i < loop; i++)
+    {
+        // we need reload it to discard the cached classes
+        dx_file_ref_t file = dx_file_load_from_data(dx_file_data(dexfile), dx_file_size(dexfile), tb_false);
+        tb_assert_and_check_break(file);
+
+        tb_size_t n = dx_file_class_size(file);
+        for (j = 0; j < n; j++)
+        {
+            dx_class_ref_t clazz = dx_file_class(file, j);
+            if (!clazz) continue;
+
+            tb_size_t direct_size = dx_class_method_direct_size(clazz);
+            tb_size_t method_size = direct_size + dx_class_method_virtual_size(clazz);
+            for (k = 0; k < method_size; k++)
+            {
+                dx_method_ref_t method = k < direct_size? dx_class_method_direct(clazz, k) : dx_class_method_virtual(clazz, k - direct_size);
+                if (dx_method_code(method)) count0++;
+            }
+        }
+        dx_file_exit(file);
+    }
+    time0 = tb_uclock() - time0;
+
+    // count the methods with code by the visitor
+    tb_size_t           count1 = 0;
+    dx_file_visitor_t   visitor = {tb_null, tb_null, dx_bench_visit_method};
+    tb_hong_t           time1 = tb_uclock();
+    for (i = 0; i < loop; i++)
+    {
+        dx_file_ref_t file = dx_file_load_from_data(dx_file_data(dexfile), dx_file_size(dexfile), tb_false);
+        tb_assert_and_check_break(file);
+
+        dx_file_visit(file, &visitor, &count1);
+        dx_file_exit(file);
+    }
+    time1 = tb_uclock() - time1;
+
+    // trace
+    tb_printf("visit: count methods with code x %lu\n", loop);
+    tb_printf("    class:   %lld us, %lu methods\n", time0, count0);
+    tb_printf("    visitor: %lld us, %lu methods %s\n", time1, count1, count1 == count0? "ok" : "mismatch");
+
+    // exit dex file
+    dx_file_exit(dexfile);
+}
+
+static tb_void_t dx_bench_cache(tb_char_t const* url, tb_size_t loop)
+{
+    // load dex file
+    dx_file_ref_t dexfile = dx_file_load_from_url(url, tb_false);
+    tb_assert_and_check_return(dexfile);
+
+    // get the memory size of all classes
+    dx_file_cache_stat_t stat;
+    dx_file_load_all(dexfile, 1, tb_null);
+    dx_file_cache_stat(dexfile, &stat);
+    tb_size_t memsize = stat.size;
+
+    // access classes with 1/4, 1/2 and full budgets, 80% accesses hit the hot 20% classes
+    tb_size_t i = 0;
+    tb_size_t j = 0;
+    tb_size_t class_size = dx_file_class_size(dexfile);
+    tb_size_t hot_size = tb_max(class_size / 5, 1);
+    for (i = 1; i <= 4; i <<= 1)
+    {
+        dx_file_ref_t file = dx_file_load_from_data(dx_file_data(dexfile), dx_file_size(dexfile), tb_false);
+        tb_assert_and_check_break(file);
+
+        tb_size_t maxn = tb_max(memsize * i / 4, 1);
+        dx_file_cache_set(file, maxn);
+
+        tb_uint32_t seed = 2166136261u;
+        tb_hong_t   time = tb_uclock();
+        for (j = 0; j < loop * class_size; j++)
+        {
+            seed = seed * 1103515245 + 12345;
+            tb_size_t r = seed >> 8;
+            dx_class_ref_t clazz = dx_file_class(file, (r % 10) < 8? (r / 10) % hot_size : (r / 10) % class_size);
+            if (clazz) dx_file_class_release(file, clazz);
+        }
+        time = tb_uclock() - time;
+
+        // trace
+        dx_file_cache_stat(file, &stat);
+        tb_printf("cache: budget %lu/%lu bytes x %lu, %lld us\n", maxn, memsize, loop, time);
+        tb_printf("    %lu classes, %lu bytes, hits: %lu, misses: %lu, evictions: %lu\n", stat.count, stat.size, stat.hits, stat.misses, stat.evictions);
+        dx_file_exit(file);
+    }
+
+    // exit dex file
+    dx_file_exit(dexfile);
+}
+
+static tb_void_t dx_bench_dexset(tb_char_t const* url, tb_size_t loop)
+{
+    // load dex file
+    dx_file_ref_t dexfile = dx_file_load_from_url(url, tb_false);
+    tb_assert_and_check_return(dexfile);
+
+    // build the class index of 16 dex files with 1, 2, 4, ... workers
+    tb_size_t i = 0;
+    tb_size_t j = 0;
+    tb_size_t nthreads = 1;
+    tb_size_t nthreads_max = tb_processor_count();
+    for (nthreads = 1; nthreads <= nthreads_max; nthreads <<= 1)
+    {
+        tb_hong_t time = 0;
+        for (i = 0; i < loop; i++)
+        {
+            dx_dexset_ref_t dexset = dx_dexset_init();
+            tb_assert_and_check_break(dexset);
+
+            for (j = 0; j < 16; j++)
+                dx_dexset_add(dexset, dx_file_load_from_data(dx_file_data(dexfile), dx_file_size(dexfile), tb_false));
+
+            tb_hong_t t = tb_uclock();
+            dx_dexset_build(dexset, nthreads);
+            time += tb_uclock() - t;
+            dx_dexset_exit(dexset);
+        }
+        tb_printf("dexset: build 16 files with %lu workers x %lu, %lld us\n", nthreads, loop, time);
+    }
+
+    // find all classes in the dex set
+    dx_dexset_ref_t dexset = dx_dexset_init();
+    if (dexset)
+    {
+        for (j = 0; j < 16; j++)
+            dx_dexset_add(dexset, dx_file_load_from_data(dx_file_data(dexfile), dx_file_size(dexfile), tb_false));
+        dx_dexset_build(dexset, 0);
+
+        tb_size_t   count = 0;
+        tb_size_t   class_size = dx_file_class_size(dexfile);
+        tb_hong_t   time = tb_uclock();
+        for (i = 0; i < loop; i++)
+        {
+            for (j = 0; j < class_size; j++)
+            {
+                dx_class_ref_t clazz = dx_file_class(dexfile, j);
+                if (clazz && dx_dexset_class_find(dexset, dx_class_descriptor(clazz))) count++;
+            }
+        }
+        time = tb_uclock() - time;
+        tb_printf("dexset: find %lu classes x %lu, %lld us, %lu found\n", class_size, loop, time, count);
+        dx_dexset_exit(dexset);
+    }
+
+    // exit dex file
+    dx_file_exit(dexfile);
+}
+
+static tb_void_t dx_bench_batch(tb_char_t const* url, tb_size_t loop)
+{
+    // load all dex files in the given directory loop times, or load the same file loop times
+    tb_size_t       i = 0;
+    tb_size_t       j = 0;
+    tb_size_t       round = 1;
+    tb_file_info_t  info;
+    dx_bench_urls_t urls = {0};
+    tb_bool_t       is_dir = tb_file_info(url, &info) && info.type == TB_FILE_TYPE_DIRECTORY;
+    if (is_dir)
+    {
+        tb_directory_walk(url, -1, tb_true, dx_bench_batch_walk, &urls);
+        round = loop;
+    }
+    else
+    {
+        urls.urls = tb_nalloc0_type(loop, tb_char_t const*);
+        tb_assert_and_check_return(urls.urls);
+        for (i = 0; i < loop; i++) urls.urls[i] = url;
+        urls.size = loop;
+    }
+
+    // done
+    do
+    {
+        // no dex files?
+        tb_check_break(urls.size);
+
+        // load them serially
+        tb_size_t count = 0;
+        tb_hong_t time = tb_uclock();
+        for (j = 0; j < round; j++)
+        {
+            for (i = 0; i < urls.size; i++)
+                dx_bench_batch_func(urls.urls[i], i, dx_file_load_from_url(urls.urls[i], DX_FILE_CHECKSUM_SYNC), &count);
+        }
+        time = tb_uclock() - time;
+        tb_printf("batch: load %lu files x %lu serially, %lld us, %lu classes\n", urls.size, round, time, count);
+
+        // load them in batch with 1, 2, 4, ... workers by the default io and io_uring
+        tb_size_t io = 0;
+        tb_size_t nthreads = 1;
+        tb_size_t nthreads_max = tb_processor_count();
+        for (io = DX_FILE_BATCH_IO_DEFAULT; io <= DX_FILE_BATCH_IO_URING; io++)
+        {
+            for (nthreads = 1; nthreads <= nthreads_max; nthreads <<= 1)
+            {
+                dx_file_batch_opt_t opt = {nthreads, 0, DX_FILE_CHECKSUM_SYNC, io};
+                tb_size_t loaded = 0;
+                count = 0;
+                time = tb_uclock();
+                for (j = 0; j < round; j++)
+                    loaded += dx_file_load_batch(urls.urls, urls.size, &opt, dx_bench_batch_func, &count);
+                time = tb_uclock() - time;
+                tb_printf("batch: load %lu/%lu files x %lu with %lu workers by %s, %lld us, %lu classes\n", loaded / round, urls.size, round, nthreads, io == DX_FILE_BATCH_IO_URING? "io_uring" : "default io", time, count);
+            }
+        }
+
+    } while (0);
+
+    // exit urls
+    if (is_dir)
+    {
+        for (i = 0; i < urls.size; i++) tb_free((tb_pointer_t)urls.urls[i]);
+    }
+    if (urls.urls) tb_free((tb_pointer_t)urls.urls);
+}
+
+static tb_void_t dx_bench_validate(tb_char_t const* url, tb_size_t loop)
+{
+    // load dex file without validation
+    dx_file_ref_t dexfile = dx_file_load_from_url(url, DX_FILE_CHECKSUM_NONE);
+    tb_assert_and_check_return(dexfile);
+
+    // load dex file from data without validation, it only checks the header
+    tb_size_t i = 0;
+    tb_hong_t time = tb_uclock();
+    for (i = 0; i < loop; i++)
+    {
+        dx_file_ref_t file = dx_file_load_from_data(dx_file_data(dexfile), dx_file_size(dexfile), DX_FILE_CHECKSUM_NONE);
+        if (file) dx_file_exit(file);
+    }
+    tb_hong_t load_time = tb_uclock() - time;
+
+    // load dex file from data and validate the structure
+    tb_size_t ok = 0;
+    time = tb_uclock();
+    for (i = 0; i < loop; i++)
+    {
+        dx_file_ref_t file = dx_file_load_from_data(dx_file_data(dexfile), dx_file_size(dexfile), DX_FILE_CHECKSUM_NONE | DX_FILE_VALIDATE);
+        if (file) 
+        {
+            ok++;
+            dx_file_exit(file);
+        }
+    }
+    tb_hong_t validate_time = tb_uclock() - time;
+
+    // the adler32 checksum for comparison
+    time = tb_uclock();
+    for (i = 0; i < loop; i++) dx_adler32_make(dx_file_data(dexfile) + 12, dx_file_size(dexfile) - 12, 1);
+    tb_hong_t adler32_time = tb_uclock() - time;
+
+    // trace
+    tb_printf("validate: %lu bytes x %lu, %s\n", dx_file_size(dexfile), loop, dx_file_validate(dexfile)? "validated" : "malformed");
+    tb_printf("    load:     %lld us\n", load_time);
+    tb_printf("    validate: %lld us, %lu ok\n", validate_time, ok);
+    tb_printf("    adler32:  %lld us\n", adler32_time);
+
+    // exit dex file
+    dx_file_exit(dexfile);
+}
+
+static tb_void_t dx_bench_probe(tb_char_t const* url, tb_size_t loop)
+{
+    // probe the header and map_list
+    tb_size_t       i = 0;
+    tb_size_t       ok = 0;
+    dx_file_probe_t probe;
+    tb_hong_t       time = tb_uclock();
+    for (i = 0; i < loop; i++)
+    {
+        if (dx_file_probe_from_url(url, &probe)) ok++;
+    }
+    tb_hong_t probe_time = tb_uclock() - time;
+
+    // load the whole dex file without checksum for comparison
+    time = tb_uclock();
+    for (i = 0; i < loop; i++)
+    {
+        dx_file_ref_t dexfile = dx_file_load_from_url(url, DX_FILE_CHECKSUM_NONE);
+        if (dexfile) dx_file_exit(dexfile);
+    }
+    tb_hong_t load_time = tb_uclock() - time;
+
+    // trace
+    tb_printf("probe: x %lu, %lu ok\n", loop, ok);
+    tb_printf("    probe: %lld us\n", probe_time);
+    tb_printf("    load:  %lld us\n", load_time);
+    if (ok)
+    {
+        tb_printf("    version: %03u, size: %u, strings: %u, types: %u, methods: %u, classes: %u, code_items: %u\n"
+            , probe.version, probe.file_size, probe.strings, probe.types, probe.methods, probe.classes, probe.code_items);
+    }
+}
+
+/* the reference decoder of the decode bench
+ *
+ * it keeps the shape of the old decoder: the width, format, index type and flags 
+ * are looked up from the separate tables, the width is recomputed for each instruction 
+ * and the operands are decoded by one large switch over the format.
+ *
+ * the tables are copied from the generated tables of the old decoder, 
+ * so they are independent of dx_instr_decode() and the results of both decoders are checked against each other.
+ */
+
+// the instruction width table
+static tb_uint8_t const g_bench_ref_widths[] = 
+{
+    1, 1, 2, 3, 1, 2, 3, 1, 2, 3, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 2, 3, 2, 2, 3, 5, 2, 2, 3, 2, 1, 1, 2,
+    2, 1, 2, 2, 3, 3, 3, 1, 1, 2, 3, 3, 3, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 0, 0,
+    0, 0, 0, 0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 3,
+    3, 3, 3, 0, 3, 3, 3, 3, 3, 0, 0, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 0, 2, 3, 3,
+    3, 1, 2, 0, 0, 0, 0, 0, 0, 0, 4, 4, 3, 3, 2, 2,
+};
+
+// the instruction flags table
+static tb_uint8_t const g_bench_ref_flags[] = 
+{
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_RETURN,
+    DX_INSTR_FLAGS_CAN_RETURN,
+    DX_INSTR_FLAGS_CAN_RETURN,
+    DX_INSTR_FLAGS_CAN_RETURN,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_BRANCH,
+    DX_INSTR_FLAGS_CAN_BRANCH,
+    DX_INSTR_FLAGS_CAN_BRANCH,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_SWITCH,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_SWITCH,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
+    0,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
+    0,
+    0,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    0,
+    DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
+    DX_INSTR_FLAGS_CAN_RETURN,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
+};
+
+// the instruction format table
+static tb_uint8_t const g_bench_ref_formats[] = 
+{
+    DX_INSTR_FMT_10x, DX_INSTR_FMT_12x, DX_INSTR_FMT_22x, DX_INSTR_FMT_32x, DX_INSTR_FMT_12x, DX_INSTR_FMT_22x, DX_INSTR_FMT_32x,
+    DX_INSTR_FMT_12x, DX_INSTR_FMT_22x, DX_INSTR_FMT_32x, DX_INSTR_FMT_11x, DX_INSTR_FMT_11x, DX_INSTR_FMT_11x, DX_INSTR_FMT_11x,
+    DX_INSTR_FMT_10x, DX_INSTR_FMT_11x, DX_INSTR_FMT_11x, DX_INSTR_FMT_11x, DX_INSTR_FMT_11n, DX_INSTR_FMT_21s, DX_INSTR_FMT_31i,
+    DX_INSTR_FMT_21h, DX_INSTR_FMT_21s, DX_INSTR_FMT_31i, DX_INSTR_FMT_51l, DX_INSTR_FMT_21h, DX_INSTR_FMT_21c, DX_INSTR_FMT_31c,
+    DX_INSTR_FMT_21c, DX_INSTR_FMT_11x, DX_INSTR_FMT_11x, DX_INSTR_FMT_21c, DX_INSTR_FMT_22c, DX_INSTR_FMT_12x, DX_INSTR_FMT_21c,
+    DX_INSTR_FMT_22c, DX_INSTR_FMT_35c, DX_INSTR_FMT_3rc, DX_INSTR_FMT_31t, DX_INSTR_FMT_11x, DX_INSTR_FMT_10t, DX_INSTR_FMT_20t,
+    DX_INSTR_FMT_30t, DX_INSTR_FMT_31t, DX_INSTR_FMT_31t, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x,
+    DX_INSTR_FMT_23x, DX_INSTR_FMT_22t, DX_INSTR_FMT_22t, DX_INSTR_FMT_22t, DX_INSTR_FMT_22t, DX_INSTR_FMT_22t, DX_INSTR_FMT_22t,
+    DX_INSTR_FMT_21t, DX_INSTR_FMT_21t, DX_INSTR_FMT_21t, DX_INSTR_FMT_21t, DX_INSTR_FMT_21t, DX_INSTR_FMT_21t, DX_INSTR_FMT_00x,
+    DX_INSTR_FMT_00x, DX_INSTR_FMT_00x, DX_INSTR_FMT_00x, DX_INSTR_FMT_00x, DX_INSTR_FMT_00x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x,
+    DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x,
+    DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c,
+    DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c,
+    DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c,
+    DX_INSTR_FMT_21c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c,
+    DX_INSTR_FMT_21c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c, DX_INSTR_FMT_35c, DX_INSTR_FMT_35c,
+    DX_INSTR_FMT_35c, DX_INSTR_FMT_35c, DX_INSTR_FMT_35c, DX_INSTR_FMT_00x, DX_INSTR_FMT_3rc, DX_INSTR_FMT_3rc, DX_INSTR_FMT_3rc,
+    DX_INSTR_FMT_3rc, DX_INSTR_FMT_3rc, DX_INSTR_FMT_00x, DX_INSTR_FMT_00x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x,
+    DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x,
+    DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x,
+    DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x,
+    DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x,
+    DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x,
+    DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x,
+    DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x,
+    DX_INSTR_FMT_23x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x,
+    DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x,
+    DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x,
+    DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x,
+    DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_22s, DX_INSTR_FMT_22s,
+    DX_INSTR_FMT_22s, DX_INSTR_FMT_22s, DX_INSTR_FMT_22s, DX_INSTR_FMT_22s, DX_INSTR_FMT_22s, DX_INSTR_FMT_22s, DX_INSTR_FMT_22b,
+    DX_INSTR_FMT_22b, DX_INSTR_FMT_22b, DX_INSTR_FMT_22b, DX_INSTR_FMT_22b, DX_INSTR_FMT_22b, DX_INSTR_FMT_22b, DX_INSTR_FMT_22b,
+    DX_INSTR_FMT_22b, DX_INSTR_FMT_22b, DX_INSTR_FMT_22b, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c,
+    DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c, DX_INSTR_FMT_00x, DX_INSTR_FMT_20bc,
+    DX_INSTR_FMT_35mi, DX_INSTR_FMT_3rmi, DX_INSTR_FMT_35c, DX_INSTR_FMT_10x, DX_INSTR_FMT_22cs, DX_INSTR_FMT_00x, DX_INSTR_FMT_00x,
+    DX_INSTR_FMT_00x, DX_INSTR_FMT_00x, DX_INSTR_FMT_00x, DX_INSTR_FMT_00x, DX_INSTR_FMT_00x, DX_INSTR_FMT_45cc, DX_INSTR_FMT_4rcc,
+    DX_INSTR_FMT_35c, DX_INSTR_FMT_3rc, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c,
+};
+
+// the instruction index type table
+static tb_uint8_t const g_bench_ref_index_types[] = 
+{
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_STRING_REF,
+    DX_INSTR_INDEX_TYPE_STRING_REF, DX_INSTR_INDEX_TYPE_TYPE_REF, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_TYPE_REF, DX_INSTR_INDEX_TYPE_TYPE_REF,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_TYPE_REF, DX_INSTR_INDEX_TYPE_TYPE_REF,
+    DX_INSTR_INDEX_TYPE_TYPE_REF, DX_INSTR_INDEX_TYPE_TYPE_REF, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_UNKNOWN,
+    DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_UNKNOWN,
+    DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
+    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
+    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
+    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
+    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
+    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
+    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
+    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
+    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
+    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_METHOD_REF,
+    DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_INDEX_TYPE_METHOD_REF,
+    DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_METHOD_REF,
+    DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_INDEX_TYPE_METHOD_REF,
+    DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_UNKNOWN,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
+    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_FIELD_REF,
+    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
+    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
+    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_UNKNOWN,
+    DX_INSTR_INDEX_TYPE_VARIES, DX_INSTR_INDEX_TYPE_INLINE_METHOD, DX_INSTR_INDEX_TYPE_INLINE_METHOD,
+    DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_FIELD_OFFSET,
+    DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_UNKNOWN,
+    DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_UNKNOWN,
+    DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_METHOD_AND_PROTO_REF, DX_INSTR_INDEX_TYPE_METHOD_AND_PROTO_REF,
+    DX_INSTR_INDEX_TYPE_CALL_SITE_REF, DX_INSTR_INDEX_TYPE_CALL_SITE_REF, DX_INSTR_INDEX_TYPE_METHOD_HANDLE_REF,
+    DX_INSTR_INDEX_TYPE_PROTO_REF,
+};
+static tb_size_t dx_bench_ref_width(tb_uint16_t const* instr)
+{
+    tb_size_t   width = 0;
+    tb_uint16_t instr_unit = instr[0];
+    if (instr_unit == DX_INSTR_IDENT_PACKED_SWITCH_PAYLOAD) 
+        width = 4 + (instr[1] << 1);
+    else if (instr_unit == DX_INSTR_IDENT_SPARSE_SWITCH_PAYLOAD)
+        width = 2 + (instr[1] << 2);
+    else if (instr_unit == DX_INSTR_IDENT_FILL_ARRAY_DATA)
+    {
+        tb_hize_t w = instr[1];
+        tb_hize_t n = instr[2] | ((tb_uint32_t)instr[3] << 16);
+        tb_hize_t v = 4 + (((n * w) + 1) >> 1);
+        width = (tb_size_t)(v <= TB_MAXU32? v : TB_MAXU32);
+    }
+    else width = g_bench_ref_widths[instr_unit & 0xff];
+    return width;
+}
+static tb_bool_t dx_bench_ref_decode(tb_uint16_t const* instr, dx_instruction_ref_t instruction)
+{
+    // get instruction code and opcode
+    tb_uint16_t instr_unit  = instr[0];
+    tb_uint16_t opcode      = instr_unit & 0xff;
+    tb_check_return_val(g_bench_ref_formats[opcode] != DX_INSTR_FMT_00x, tb_false);
+
+    // get the instruction info from the separate tables
+    instruction->instr      = instr;
+    instruction->opcode     = opcode;
+    instruction->width      = (tb_uint32_t)dx_bench_ref_width(instr);
+    instruction->index_type = g_bench_ref_index_types[opcode];
+    instruction->flags      = g_bench_ref_flags[opcode];
+    instruction->format     = g_bench_ref_formats[opcode];
+
+    // decode the operands by the format
+    switch (instruction->format)
+    {
+    case DX_INSTR_FMT_10x:
+    case DX_INSTR_FMT_11x:
+        instruction->vA = instr_unit >> 8;
+        break;
+    case DX_INSTR_FMT_12x:
+        instruction->vA = (instr_unit >> 8) & 0x0f;
+        instruction->vB = instr_unit >> 12;
+        break;
+    case DX_INSTR_FMT_11n:
+        instruction->vA = (instr_unit >> 8) & 0x0f;
+        instruction->vB = (tb_sint32_t)((tb_uint32_t)(instr_unit >> 12) << 28) >> 28;
+        break;
+    case DX_INSTR_FMT_10t:
+        instruction->vA = (tb_sint8_t)(instr_unit >> 8);
+        break;
+    case DX_INSTR_FMT_20t:
+        instruction->vA = (tb_sint16_t)instr[1];
+        break;
+    case DX_INSTR_FMT_20bc:
+    case DX_INSTR_FMT_21c:
+    case DX_INSTR_FMT_22x:
+    case DX_INSTR_FMT_21h:
+        instruction->vA = instr_unit >> 8;
+        instruction->vB = instr[1];
+        break;
+    case DX_INSTR_FMT_21s:
+    case DX_INSTR_FMT_21t:
+        instruction->vA = instr_unit >> 8;
+        instruction->vB = (tb_sint16_t)instr[1];
+        break;
+    case DX_INSTR_FMT_23x:
+        instruction->vA = instr_unit >> 8;
+        instruction->vB = instr[1] & 0xff;
+        instruction->vC = instr[1] >> 8;
+        break;
+    case DX_INSTR_FMT_22b:
+        instruction->vA = instr_unit >> 8;
+        instruction->vB = instr[1] & 0xff;
+        instruction->vC = (tb_sint8_t)(instr[1] >> 8);
+        break;
+    case DX_INSTR_FMT_22s:
+    case DX_INSTR_FMT_22t:
+        instruction->vA = (instr_unit >> 8) & 0x0f;
+        instruction->vB = instr_unit >> 12;
+        instruction->vC = (tb_sint16_t)instr[1];
+        break;
+    case DX_INSTR_FMT_22c:
+    case DX_INSTR_FMT_22cs:
+        instruction->vA = (instr_unit >> 8) & 0x0f;
+        instruction->vB = instr_unit >> 12;
+        instruction->vC = instr[1];
+        break;
+    case DX_INSTR_FMT_30t:
+        instruction->vA = instr[1] | ((tb_uint32_t)instr[2] << 16);
+        break;
+    case DX_INSTR_FMT_31t:
+    case DX_INSTR_FMT_31i:
+    case DX_INSTR_FMT_31c:
+        instruction->vA = instr_unit >> 8;
+        instruction->vB = instr[1] | ((tb_uint32_t)instr[2] << 16);
+        break;
+    case DX_INSTR_FMT_32x:
+        instruction->vA = instr[1];
+        instruction->vB = instr[2];
+        break;
+    case DX_INSTR_FMT_35c:
+    case DX_INSTR_FMT_35ms:
+    case DX_INSTR_FMT_35mi:
+        {
+            tb_uint16_t regs = instr[2];
+            instruction->vA = instr_unit >> 12;
+            instruction->vB = instr[1];
+            switch (instruction->vA) 
+            {
+            case 5: 
+                tb_check_return_val(instruction->format != DX_INSTR_FMT_35mi, tb_false);
+                instruction->arg[4] = (instr_unit >> 8) & 0x0f;
+            case 4: instruction->arg[3] = (regs >> 12) & 0x0f;
+            case 3: instruction->arg[2] = (regs >> 8) & 0x0f;
+            case 2: instruction->arg[1] = (regs >> 4) & 0x0f;
+            case 1: instruction->vC = instruction->arg[0] = regs & 0x0f; break;
+            case 0: break;
+            default: return tb_false;
+            }
+        }
+        break;
+    case DX_INSTR_FMT_3rc:
+    case DX_INSTR_FMT_3rms:
+    case DX_INSTR_FMT_3rmi:
+        instruction->vA = instr_unit >> 8;
+        instruction->vB = instr[1];
+        instruction->vC = instr[2];
+        break;
+    case DX_INSTR_FMT_51l:
+        instruction->vA       = instr_unit >> 8;
+        instruction->vB_wide  = (instr[1] | ((tb_uint32_t)instr[2] << 16)) | ((tb_uint64_t)(instr[3] | ((tb_uint32_t)instr[4] << 16)) << 32);
+        break;
+    default:
+        return tb_false;
+    }
+    return tb_true;
+}
+static tb_bool_t dx_bench_ref_equal(dx_instruction_ref_t a, dx_instruction_ref_t b)
+{
+    return a->opcode == b->opcode && a->width == b->width && a->format == b->format 
+        && a->index_type == b->index_type && a->flags == b->flags 
+        && a->vA == b->vA && a->vB == b->vB && a->vC == b->vC && a->vB_wide == b->vB_wide
+        && !tb_memcmp(a->arg, b->arg, sizeof(a->arg));
+}
+static tb_void_t dx_bench_decode(tb_char_t const* url, tb_size_t loop)
+{
+    // load dex file
+    dx_file_ref_t dexfile = dx_file_load_from_url(url, DX_FILE_CHECKSUM_NONE);
+    tb_assert_and_check_return(dexfile);
+
+    // collect the codes of all methods first, we only measure the decoder
+    tb_size_t       i = 0;
+    tb_size_t       j = 0;
+    tb_size_t       k = 0;
+    tb_size_t       codes_size = 0;
+    tb_size_t       codes_maxn = 0;
+    dx_code_ref_t*  codes = tb_null;
+    tb_size_t       n = dx_file_class_size(dexfile);
+    for (i = 0; i < n; i++)
+    {
+        dx_class_ref_t clazz = dx_file_class(dexfile, i);
+        if (clazz) codes_maxn += dx_class_method_direct_size(clazz) + dx_class_method_virtual_size(clazz);
+    }
+    if (codes_maxn) codes = tb_nalloc_type(codes_maxn, dx_code_ref_t);
+    for (i = 0; i < n && codes; i++)
+    {
+        dx_class_ref_t clazz = dx_file_class(dexfile, i);
+        if (!clazz) continue;
+
+        tb_size_t direct_size = dx_class_method_direct_size(clazz);
+        tb_size_t method_size = direct_size + dx_class_method_virtual_size(clazz);
+        for (k = 0; k < method_size; k++)
+        {
+            dx_method_ref_t method = k < direct_size? dx_class_method_direct(clazz, k) : dx_class_method_virtual(clazz, k - direct_size);
+            dx_code_ref_t   code = dx_method_code(method);
+            if (code) codes[codes_size++] = code;
+        }
+    }
+
+    // compare the results of both decoders for all instructions first
+    tb_size_t count = 0;
+    tb_size_t failed = 0;
+    tb_size_t mismatch = 0;
+    for (j = 0; j < codes_size; j++)
+    {
+        tb_size_t           instr_idx = 0;
+        tb_size_t           instr_size = dx_code_instr_size(codes[j]);
+        tb_uint16_t const*  instr_data = dx_code_instr_data(codes[j]);
+        while (instr_idx < instr_size)
+        {
+            dx_instruction_t instruction = {0};
+            dx_instruction_t instruction_ref = {0};
+            if (!dx_instr_decode(instr_data, &instruction) || !instruction.width || instruction.width > instr_size - instr_idx)
+            {
+                failed++;
+                break;
+            }
+            if (!dx_bench_ref_decode(instr_data, &instruction_ref) || !dx_bench_ref_equal(&instruction, &instruction_ref))
+                mismatch++;
+            instr_idx   += instruction.width;
+            instr_data  += instruction.width;
+            count++;
+        }
+    }
+
+    // decode all instructions of all methods
+    tb_hize_t sum0 = 0;
+    tb_hong_t time0 = tb_uclock();
+    for (i = 0; i < loop; i++)
+    {
+        for (j = 0; j < codes_size; j++)
+        {
+            tb_size_t           instr_idx = 0;
+            tb_size_t           instr_size = dx_code_instr_size(codes[j]);
+            tb_uint16_t const*  instr_data = dx_code_instr_data(codes[j]);
+            while (instr_idx < instr_size)
+            {
+                dx_instruction_t instruction;
+                if (!dx_instr_decode(instr_data, &instruction) || !instruction.width || instruction.width > instr_size - instr_idx) break;
+                sum0 += instruction.vA + instruction.vB + instruction.format;
+                instr_idx   += instruction.width;
+                instr_data  += instruction.width;
+            }
+        }
+    }
+    time0 = tb_uclock() - time0;
+
+    // decode all instructions of all methods by the reference decoder
+    tb_hize_t sum1 = 0;
+    tb_hong_t time1 = tb_uclock();
+    for (i = 0; i < loop; i++)
+    {
+        for (j = 0; j < codes_size; j++)
+        {
+            tb_size_t           instr_idx = 0;
+            tb_size_t           instr_size = dx_code_instr_size(codes[j]);
+            tb_uint16_t const*  instr_data = dx_code_instr_data(codes[j]);
+            while (instr_idx < instr_size)
+            {
+                dx_instruction_t instruction;
+                if (!dx_bench_ref_decode(instr_data, &instruction) || !instruction.width || instruction.width > instr_size - instr_idx) break;
+                sum1 += instruction.vA + instruction.vB + instruction.format;
+                instr_idx   += instruction.width;
+                instr_data  += instruction.width;
+            }
+        }
+    }
+    time1 = tb_uclock() - time1;
+
+    // trace
+    count *= loop;
+    tb_printf("decode: %lu methods x %lu, %lu instructions, %lu failed, %lu mismatched\n", codes_size, loop, count, failed, mismatch);
+    tb_printf("    decode:    %lld us, %lld ns/instr\n", time0, count? (time0 * 1000) / (tb_hong_t)count : 0);
+    tb_printf("    reference: %lld us, %lld ns/instr, %s\n", time1, count? (time1 * 1000) / (tb_hong_t)count : 0, sum0 == sum1? "ok" : "mismatch");
+
+    // exit codes
+    if (codes) tb_free(codes);
+
+    // exit dex file
+    dx_file_exit(dexfile);
+}
+
+static tb_void_t dx_bench_predecode(tb_char_t const* url, tb_size_t loop)
+{
+    // load dex file
+    dx_file_ref_t dexfile = dx_file_load_from_url(url, DX_FILE_CHECKSUM_NONE);
+    tb_assert_and_check_return(dexfile);
+
+    // collect all methods with code
+    tb_size_t           i = 0;
+    tb_size_t           j = 0;
+    tb_size_t           k = 0;
+    tb_size_t           methods_size = 0;
+    tb_size_t           methods_maxn = 0;
+    dx_method_ref_t*    methods = tb_null;
+    tb_size_t           n = dx_file_class_size(dexfile);
+    for (i = 0; i < n; i++)
+    {
+        dx_class_ref_t clazz = dx_file_class(dexfile, i);
+        if (clazz) methods_maxn += dx_class_method_direct_size(clazz) + dx_class_method_virtual_size(clazz);
+    }
+    if (methods_maxn) methods = tb_nalloc_type(methods_maxn, dx_method_ref_t);
+    for (i = 0; i < n && methods; i++)
+    {
+        dx_class_ref_t clazz = dx_file_class(dexfile, i);
+        if (!clazz) continue;
+
+        tb_size_t direct_size = dx_class_method_direct_size(clazz);
+        tb_size_t method_size = direct_size + dx_class_method_virtual_size(clazz);
+        for (k = 0; k < method_size; k++)
+        {
+            dx_method_ref_t method = k < direct_size? dx_class_method_direct(clazz, k) : dx_class_method_virtual(clazz, k - direct_size);
+            if (dx_method_code(method)) methods[methods_size++] = method;
+        }
+    }
+
+    // decode all instructions for each pass
+    tb_hize_t   sum0 = 0;
+    tb_hong_t   time0 = tb_uclock();
+    for (i = 0; i < loop; i++)
+    {
+        for (j = 0; j < methods_size; j++)
+        {
+            dx_code_ref_t       code = dx_method_code(methods[j]);
+            tb_size_t           instr_idx = 0;
+            tb_size_t           instr_size = dx_code_instr_size(code);
+            tb_uint16_t const*  instr_data = dx_code_instr_data(code);
+            while (instr_idx < instr_size)
+            {
+                tb_size_t instr_width = dx_instr_width(instr_data);
+                if (!instr_width) break;
+
+                dx_instruction_t instruction = {0};
+                if (!dx_instr_decode(instr_data, &instruction)) break;
+
+                sum0 += instr_idx + instruction.opcode + instruction.vA;
+                instr_idx   += instr_width;
+                instr_data  += instr_width;
+            }
+        }
+    }
+    time0 = tb_uclock() - time0;
+
+    // iterate the predecoded instructions for each pass, they are predecoded at the first pass
+    tb_hize_t   sum1 = 0;
+    tb_hong_t   time1 = tb_uclock();
+    for (i = 0; i < loop; i++)
+    {
+        for (j = 0; j < methods_size; j++)
+        {
+            dx_code_predecode_ref_t predecode = dx_method_predecode(methods[j]);
+            if (!predecode) continue;
+
+            dx_code_instr_t const*  instr = predecode->instrs;
+            dx_code_instr_t const*  instr_end = instr + predecode->size;
+            for (; instr < instr_end; instr++) sum1 += (tb_size_t)instr->pc + instr->opcode + instr->vA;
+        }
+    }
+    time1 = tb_uclock() - time1;
+
+    // get the memory of the predecoded codes
+    dx_file_cache_stat_t stat;
+    dx_file_cache_stat(dexfile, &stat);
+
+    // trace
+    tb_printf("predecode: %lu methods x %lu\n", methods_size, loop);
+    tb_printf("    decode:    %lld us\n", time0);
+    tb_printf("    predecode: %lld us, %lu bytes, %s\n", time1, stat.codes, sum0 == sum1? "ok" : "mismatch");
+
+    // exit methods
+    if (methods) tb_free(methods);
+
+    // exit dex file
+    dx_file_exit(dexfile);
+}
+
+static __tb_inline__ tb_sint32_t dx_bench_switch_value(tb_uint16_t const* payload, tb_size_t k)
+{
+    // the empty switch? it is always missed
+    tb_size_t size = payload[1];
+    tb_check_return_val(size, (tb_sint32_t)k);
+
+    // get the key, the packed keys follow the first key
+    tb_size_t   index = (k >> 1) % size;
+    tb_uint32_t key = 0;
+    if (payload[0] == DX_INSTR_IDENT_PACKED_SWITCH_PAYLOAD)
+        key = (payload[2] | ((tb_uint32_t)payload[3] << 16)) + (tb_uint32_t)index;
+    else key = payload[2 + (index << 1)] | ((tb_uint32_t)payload[3 + (index << 1)] << 16);
+
+    // the values are the keys and their next values, so most sparse values are hit or missed alternately
+    return (tb_sint32_t)((k & 1)? key + 1 : key);
+}
+static tb_void_t dx_bench_switch(tb_char_t const* url, tb_size_t loop)
+{
+    // load dex file
+    dx_file_ref_t dexfile = dx_file_load_from_url(url, DX_FILE_CHECKSUM_NONE);
+    tb_assert_and_check_return(dexfile);
+
+    // collect the switch payloads and jump tables of all methods
+    tb_size_t               i = 0;
+    tb_size_t               j = 0;
+    tb_size_t               k = 0;
+    tb_size_t               tables_size = 0;
+    tb_size_t               tables_maxn = 0;
+    tb_uint16_t const**     payloads = tb_null;
+    dx_code_switch_ref_t*   tables = tb_null;
+    tb_size_t               n = dx_file_class_size(dexfile);
+    for (i = 0; i < n; i++)
+    {
+        dx_class_ref_t clazz = dx_file_class(dexfile, i);
+        if (!clazz) continue;
+
+        tb_size_t direct_size = dx_class_method_direct_size(clazz);
+        tb_size_t method_size = direct_size + dx_class_method_virtual_size(clazz);
+        for (k = 0; k < method_size; k++)
+        {
+            dx_method_ref_t         method = k < direct_size? dx_class_method_direct(clazz, k) : dx_class_method_virtual(clazz, k - direct_size);
+            dx_code_switches_ref_t  switches = dx_method_switches(method);
+            if (!switches) continue;
+
+            tb_uint16_t const* instr_data = dx_code_instr_data(dx_method_code(method));
+            for (j = 0; j < switches->size; j++)
+            {
+                // grow tables
+                if (tables_size == tables_maxn)
+                {
+                    tables_maxn = tables_maxn? tables_maxn << 1 : 256;
+                    payloads = (tb_uint16_t const**)tb_ralloc((tb_pointer_t)payloads, tables_maxn * sizeof(tb_uint16_t const*));
+                    tables = (dx_code_switch_ref_t*)tb_ralloc((tb_pointer_t)tables, tables_maxn * sizeof(dx_code_switch_ref_t));
+                    tb_assert_and_check_break(payloads && tables);
+                }
+
+                // save the payload and jump table
+                dx_code_switch_ref_t    table = (dx_code_switch_ref_t)&switches->switches[j];
+                tb_uint16_t const*      instr = instr_data + table->pc;
+                payloads[tables_size]   = instr + (tb_sint32_t)(instr[1] | ((tb_uint32_t)instr[2] << 16));
+                tables[tables_size]     = table;
+                tables_size++;
+            }
+        }
+    }
+
+    // dispatch the values around the keys by the payloads, the sparse-switch payloads are searched
+    tb_hize_t   sum0 = 0;
+    tb_hong_t   time0 = tb_uclock();
+    for (i = 0; i < loop; i++)
+    {
+        for (j = 0; j < tables_size; j++)
+        {
+            tb_uint16_t const* payload = payloads[j];
+            for (k = 0; k < 64; k++)
+            {
+                tb_sint32_t value = dx_bench_switch_value(payload, k);
+                sum0 += (tb_size_t)(payload[0] == DX_INSTR_IDENT_PACKED_SWITCH_PAYLOAD? dx_instr_packed_switch(payload, value) : dx_instr_sparse_switch(payload, value));
+            }
+        }
+    }
+    time0 = tb_uclock() - time0;
+
+    // dispatch the same values by the precompiled jump tables
+    tb_hize_t   sum1 = 0;
+    tb_hong_t   time1 = tb_uclock();
+    for (i = 0; i < loop; i++)
+    {
+        for (j = 0; j < tables_size; j++)
+        {
+            for (k = 0; k < 64; k++)
+                sum1 += (tb_size_t)dx_code_switch_jump(tables[j], dx_bench_switch_value(payloads[j], k));
+        }
+    }
+    time1 = tb_uclock() - time1;
+
+    // trace
+    tb_printf("switch: %lu switches x %lu x 64 values\n", tables_size, loop);
+    tb_printf("    payload: %lld us\n", time0);
+    tb_printf("    table:   %lld us, %s\n", time1, sum0 == sum1? "ok" : "mismatch");
+
+    // exit tables
+    if (payloads) tb_free((tb_pointer_t)payloads);
+    if (tables) tb_free(tables);
+
+    // exit dex file
+    dx_file_exit(dexfile);
+}
+
+static tb_void_t dx_bench_cfg(tb_char_t const* url, tb_size_t loop)
+{
+    // init the arena of the graphs, it will be cleared for each pass
+    dx_arena_ref_t arena = dx_arena_init(0);
+    tb_assert_and_check_return(arena);
+
+    // load dex file
+    dx_file_ref_t dexfile = dx_file_load_from_url(url, DX_FILE_CHECKSUM_NONE);
+    if (!dexfile)
+    {
+        dx_arena_exit(arena);
+        return;
+    }
+
+    // build the graphs of all methods for each pass
+    tb_size_t   i = 0;
+    tb_size_t   j = 0;
+    tb_size_t   k = 0;
+    tb_size_t   methods = 0;
+    tb_size_t   failed = 0;
+    tb_size_t   blocks = 0;
+    tb_size_t   edges = 0;
+    tb_size_t   n = dx_file_class_size(dexfile);
+    tb_hong_t   time = tb_uclock();
+    for (i = 0; i < loop; i++)
+    {
+        methods = failed = blocks = edges = 0;
+        for (j = 0; j < n; j++)
+        {
+            dx_class_ref_t clazz = dx_file_class(dexfile, j);
+            if (!clazz) continue;
+
+            tb_size_t direct_size = dx_class_method_direct_size(clazz);
+            tb_size_t method_size = direct_size + dx_class_method_virtual_size(clazz);
+            for (k = 0; k < method_size; k++)
+            {
+                dx_method_ref_t method = k < direct_size? dx_class_method_direct(clazz, k) : dx_class_method_virtual(clazz, k - direct_size);
+                dx_code_ref_t   code = dx_method_code(method);
+                if (!code) continue;
+
+                dx_cfg_ref_t cfg = dx_cfg_build_from_code(dexfile, code, arena);
+                if (cfg)
+                {
+                    blocks += cfg->blocks_size;
+                    edges += cfg->edges_size;
+                }
+                else failed++;
+                methods++;
+            }
+        }
+        dx_arena_clear(arena);
+    }
+    time = tb_uclock() - time;
+
+    // trace
+    tb_printf("cfg: %lu methods x %lu, %lu failed, %lu blocks, %lu edges\n", methods, loop, failed, blocks, edges);
+    tb_printf("    build: %lld us, %lld ns/method\n", time, methods? (time * 1000) / (tb_hong_t)(methods * loop) : 0);
+
+    // exit arena
+    dx_arena_exit(arena);
+
+    // exit dex file
+    dx_file_exit(dexfile);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+static dx_bench_t g_benches[] =
+{
+    {"adler32",     dx_bench_adler32    },
+    {"checksum",    dx_bench_checksum   },
+    {"find",        dx_bench_find       },
+    {"arena",       dx_bench_arena      },
+    {"walk",        dx_bench_walk       },
+    {"loadall",     dx_bench_loadall    },
+    {"visit",       dx_bench_visit      },
+    {"cache",       dx_bench_cache      },
+    {"dexset",      dx_bench_dexset     },
+    {"batch",       dx_bench_batch      },
+    {"validate",    dx_bench_validate   },
+    {"probe",       dx_bench_probe      },
+    {"decode",      dx_bench_decode     },
+    {"predecode",   dx_bench_predecode  },
+    {"switch",      dx_bench_switch     },
+    {"cfg",         dx_bench_cfg        }
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t main(tb_int_t argc, tb_char_t** argv)
+{
+    // check
+    if (argc < 3)
+    {
+        tb_printf("usage: dexbench [adler32|checksum|find|arena|walk|loadall|visit|cache|dexset|batch|validate|probe|decode|predecode|switch|cfg] file.dex|dexdir [loop]\n");
+        return -1;
+    }
+
+    // init tbox
+    if (!tb_init(tb_null, tb_native_allocator())) return -1;
+
+    // the loop count
+    tb_size_t loop = argc > 3? (tb_size_t)tb_atoi(argv[3]) : 100;
+
+    // done bench
+    tb_size_t i = 0;
+    for (i = 0; i < tb_arrayn(g_benches); i++)
+    {
+        if (!tb_strcmp(g_benches[i].name, argv[1]))
+        {
+            g_benches[i].func(argv[2], loop);
+            break;
+        }
+    }
+
+    // not found?
+    if (i == tb_arrayn(g_benches)) tb_printf("unknown bench: %s\n", argv[1]);
+
+    // exit tbox
+    tb_exit();
+
+    // ok
+    return 0;
+}
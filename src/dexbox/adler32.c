@@ -0,0 +1,263 @@
+/*!A lightweight dex file parsing library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2015-2020, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        adler32.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "adler32"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "adler32.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define DX_ADLER32_SSE2
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the largest prime smaller than 65536
+#define DX_ADLER32_BASE             (65521)
+
+/* the largest n such that 255n(n+1)/2 + (n+1)(BASE-1) <= 2^32-1,
+ * and it is a multiple of 16 for the vectorized kernel
+ */
+#define DX_ADLER32_NMAX             (5552)
+
+// the minimum chunk size for each worker
+#define DX_ADLER32_CHUNK_MINN       (512 * 1024)
+
+// the maximum worker count
+#define DX_ADLER32_WORKER_MAXN      (16)
+
+// update the checksum with one byte
+#define DX_ADLER32_DO1(p, i)        { s1 += (p)[i]; s2 += s1; }
+#define DX_ADLER32_DO4(p, i)        DX_ADLER32_DO1(p, i); DX_ADLER32_DO1(p, i + 1); DX_ADLER32_DO1(p, i + 2); DX_ADLER32_DO1(p, i + 3);
+#define DX_ADLER32_DO16(p)          DX_ADLER32_DO4(p, 0); DX_ADLER32_DO4(p, 4); DX_ADLER32_DO4(p, 8); DX_ADLER32_DO4(p, 12);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the adler32 chunk type
+typedef struct __dx_adler32_chunk_t
+{
+    // the data
+    tb_byte_t const*        data;
+
+    // the size
+    tb_size_t               size;
+
+    // the seed
+    tb_uint32_t             seed;
+
+    // the checksum of this chunk
+    tb_uint32_t             adler;
+
+}dx_adler32_chunk_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifdef DX_ADLER32_SSE2
+static __tb_inline__ tb_uint64_t dx_adler32_sse2_hsum(__m128i v)
+{
+    tb_uint32_t lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, v);
+    return (tb_uint64_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+#endif
+static tb_uint32_t dx_adler32_kernel(tb_byte_t const* data, tb_size_t size, tb_uint32_t seed)
+{
+    // split the seed
+    tb_uint32_t s1 = seed & 0xffff;
+    tb_uint32_t s2 = (seed >> 16) & 0xffff;
+
+#ifdef DX_ADLER32_SSE2
+    // the weights of the 16 bytes for s2
+    __m128i const zero  = _mm_setzero_si128();
+    __m128i const wlo   = _mm_setr_epi16(16, 15, 14, 13, 12, 11, 10, 9);
+    __m128i const whi   = _mm_setr_epi16(8, 7, 6, 5, 4, 3, 2, 1);
+#endif
+
+    // done
+    while (size)
+    {
+        // the block size, we need reduce sums before they overflow
+        tb_size_t n = tb_min(size, DX_ADLER32_NMAX);
+        size -= n;
+
+#ifdef DX_ADLER32_SSE2
+        /* for each 16 bytes: s2 += 16 * s1 + sum((16 - i) * b[i]), s1 += sum(b[i])
+         *
+         * vs1: the sum of all bytes in this block
+         * vps: the sum of vs1 before each 16 bytes
+         * vs2: the weighted sum of all bytes
+         */
+        tb_size_t blocks = n >> 4;
+        if (blocks)
+        {
+            tb_size_t   i;
+            __m128i     vs1 = zero;
+            __m128i     vps = zero;
+            __m128i     vs2 = zero;
+            for (i = 0; i < blocks; i++, data += 16)
+            {
+                __m128i v = _mm_loadu_si128((__m128i const*)data);
+                vps = _mm_add_epi32(vps, vs1);
+                vs1 = _mm_add_epi32(vs1, _mm_sad_epu8(v, zero));
+                vs2 = _mm_add_epi32(vs2, _mm_madd_epi16(_mm_unpacklo_epi8(v, zero), wlo));
+                vs2 = _mm_add_epi32(vs2, _mm_madd_epi16(_mm_unpackhi_epi8(v, zero), whi));
+            }
+
+            // reduce it
+            tb_uint64_t sum2 = (tb_uint64_t)s2 + (tb_uint64_t)s1 * (blocks << 4) + (dx_adler32_sse2_hsum(vps) << 4) + dx_adler32_sse2_hsum(vs2);
+            s1 = (tb_uint32_t)((s1 + dx_adler32_sse2_hsum(vs1)) % DX_ADLER32_BASE);
+            s2 = (tb_uint32_t)(sum2 % DX_ADLER32_BASE);
+            n -= blocks << 4;
+        }
+#else
+        // unroll it for the scalar kernel
+        while (n >= 16)
+        {
+            DX_ADLER32_DO16(data);
+            data += 16;
+            n -= 16;
+        }
+#endif
+
+        // the left bytes
+        while (n--)
+        {
+            s1 += *data++;
+            s2 += s1;
+        }
+
+        // reduce it
+        s1 %= DX_ADLER32_BASE;
+        s2 %= DX_ADLER32_BASE;
+    }
+
+    // ok
+    return (s2 << 16) | s1;
+}
+static tb_int_t dx_adler32_worker(tb_cpointer_t priv)
+{
+    // check
+    dx_adler32_chunk_t* chunk = (dx_adler32_chunk_t*)priv;
+    tb_assert_and_check_return_val(chunk, -1);
+
+    // make checksum of this chunk
+    chunk->adler = dx_adler32_kernel(chunk->data, chunk->size, chunk->seed);
+    return 0;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_uint32_t dx_adler32_make(tb_byte_t const* data, tb_size_t size, tb_uint32_t seed)
+{
+    // check
+    tb_check_return_val(data, 1);
+
+    // make it
+    return dx_adler32_kernel(data, size, seed);
+}
+tb_uint32_t dx_adler32_make_parallel(tb_byte_t const* data, tb_size_t size, tb_uint32_t seed, tb_size_t threads)
+{
+    // check
+    tb_check_return_val(data, 1);
+
+    // too small? make it directly
+    if (size < (DX_ADLER32_CHUNK_MINN << 1)) return dx_adler32_kernel(data, size, seed);
+
+    // get the worker count
+    if (!threads) threads = tb_processor_count();
+    threads = tb_min(threads, size / DX_ADLER32_CHUNK_MINN);
+    threads = tb_min(threads, DX_ADLER32_WORKER_MAXN);
+    if (threads <= 1) return dx_adler32_kernel(data, size, seed);
+
+    // split data to chunks, only the first chunk uses the given seed
+    tb_size_t           i;
+    tb_size_t           chunk_size = size / threads;
+    dx_adler32_chunk_t  chunks[DX_ADLER32_WORKER_MAXN];
+    tb_thread_ref_t     workers[DX_ADLER32_WORKER_MAXN] = {0};
+    for (i = 0; i < threads; i++)
+    {
+        chunks[i].data  = data + i * chunk_size;
+        chunks[i].size  = (i + 1 < threads)? chunk_size : size - i * chunk_size;
+        chunks[i].seed  = i? 1 : seed;
+        chunks[i].adler = 1;
+    }
+
+    /* start workers for the other chunks
+     *
+     * they are created and joined for each call, the chunk size (>= DX_ADLER32_CHUNK_MINN) 
+     * keeps the thread cost small compared with the checksum of the chunk.
+     */
+    for (i = 1; i < threads; i++)
+        workers[i] = tb_thread_init(tb_null, dx_adler32_worker, &chunks[i], 0);
+
+    // make the first chunk in the current thread
+    dx_adler32_worker(&chunks[0]);
+
+    // wait workers and combine all checksums
+    tb_uint32_t adler = chunks[0].adler;
+    for (i = 1; i < threads; i++)
+    {
+        if (workers[i])
+        {
+            tb_thread_wait(workers[i], -1, tb_null);
+            tb_thread_exit(workers[i]);
+        }
+        // this worker has been not started? make it directly
+        else dx_adler32_worker(&chunks[i]);
+
+        // combine it
+        adler = dx_adler32_combine(adler, chunks[i].adler, chunks[i].size);
+    }
+
+    // trace
+    tb_trace_d("make: %lu bytes with %lu workers: %#08x", size, threads, adler);
+
+    // ok
+    return adler;
+}
+tb_uint32_t dx_adler32_combine(tb_uint32_t adler1, tb_uint32_t adler2, tb_size_t size2)
+{
+    /* s1 = s1(A) + s1(B) - 1
+     * s2 = s2(A) + s2(B) + size(B) * (s1(A) - 1)
+     */
+    tb_uint32_t rem     = (tb_uint32_t)(size2 % DX_ADLER32_BASE);
+    tb_uint32_t sum1    = adler1 & 0xffff;
+    tb_uint32_t sum2    = (tb_uint32_t)(((tb_uint64_t)rem * sum1) % DX_ADLER32_BASE);
+    sum1 += (adler2 & 0xffff) + DX_ADLER32_BASE - 1;
+    sum2 += ((adler1 >> 16) & 0xffff) + ((adler2 >> 16) & 0xffff) + DX_ADLER32_BASE - rem;
+    if (sum1 >= DX_ADLER32_BASE) sum1 -= DX_ADLER32_BASE;
+    if (sum1 >= DX_ADLER32_BASE) sum1 -= DX_ADLER32_BASE;
+    if (sum2 >= (DX_ADLER32_BASE << 1)) sum2 -= (DX_ADLER32_BASE << 1);
+    if (sum2 >= DX_ADLER32_BASE) sum2 -= DX_ADLER32_BASE;
+    return (sum2 << 16) | sum1;
+}
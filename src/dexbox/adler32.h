@@ -0,0 +1,86 @@
+/*!A lightweight dex file parsing library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2015-2020, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        adler32.h
+ *
+ */
+#ifndef DX_ADLER32_H
+#define DX_ADLER32_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! make the adler32 checksum
+ *
+ * the result is the same as tb_adler32_make(), but it uses the vectorized kernel if possible.
+ *
+ * @param data          the data
+ * @param size          the size
+ * @param seed          the seed, the initial value is 1
+ *
+ * @return              the adler32 checksum
+ */
+tb_uint32_t             dx_adler32_make(tb_byte_t const* data, tb_size_t size, tb_uint32_t seed);
+
+/*! make the adler32 checksum with multiple threads
+ *
+ * the data will be split into chunks and the partial checksums will be combined,
+ * it falls back to dx_adler32_make() if the data is too small.
+ *
+ * the workers are not reused, each call creates and joins up to threads - 1 (at most 15) threads,
+ * so every chunk is at least 512KB to amortize the thread creation.
+ *
+ * @param data          the data
+ * @param size          the size
+ * @param seed          the seed, the initial value is 1
+ * @param threads       the worker count, uses the processor count if be zero
+ *
+ * @return              the adler32 checksum
+ */
+tb_uint32_t             dx_adler32_make_parallel(tb_byte_t const* data, tb_size_t size, tb_uint32_t seed, tb_size_t threads);
+
+/*! combine two adler32 checksums
+ *
+ * adler32(A + B) = dx_adler32_combine(adler32(A), adler32(B), size(B))
+ *
+ * @param adler1        the checksum of the first data
+ * @param adler2        the checksum of the second data, it was made with the initial seed
+ * @param size2         the size of the second data
+ *
+ * @return              the adler32 checksum
+ */
+tb_uint32_t             dx_adler32_combine(tb_uint32_t adler1, tb_uint32_t adler2, tb_size_t size2);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
+
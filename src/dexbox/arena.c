@@ -0,0 +1,261 @@
+/*!A lightweight dex file parsing library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2015-2020, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        arena.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "arena"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "arena.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default chunk size
+#define DX_ARENA_CHUNK_SIZE_DEFAULT     (64 * 1024)
+
+// the data alignment
+#define DX_ARENA_ALIGN                  (8)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the arena chunk type
+typedef struct __dx_arena_chunk_t
+{
+    // the next chunk
+    struct __dx_arena_chunk_t*  next;
+
+    // the data size
+    tb_size_t                   size;
+
+    // the used size
+    tb_size_t                   used;
+
+    // the padding for aligning data
+    tb_size_t                   padding;
+
+}dx_arena_chunk_t;
+
+// the arena type
+typedef struct __dx_arena_t
+{
+    // the chunks, the first chunk is the current chunk for allocation
+    dx_arena_chunk_t*           chunks;
+
+    // the chunk size
+    tb_size_t                   chunk_size;
+
+    // the allocated size
+    tb_size_t                   size;
+
+    // the lock
+    tb_spinlock_t               lock;
+
+}dx_arena_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static dx_arena_chunk_t* dx_arena_chunk_init(tb_size_t size)
+{
+    // make chunk, the data follows the chunk header
+    dx_arena_chunk_t* chunk = (dx_arena_chunk_t*)tb_malloc(sizeof(dx_arena_chunk_t) + size);
+    tb_assert_and_check_return_val(chunk, tb_null);
+
+    // init it
+    chunk->next = tb_null;
+    chunk->size = size;
+    chunk->used = 0;
+    return chunk;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+dx_arena_ref_t dx_arena_init(tb_size_t chunk_size)
+{
+    // make arena
+    dx_arena_t* arena = tb_malloc0_type(dx_arena_t);
+    tb_assert_and_check_return_val(arena, tb_null);
+
+    // init lock
+    if (!tb_spinlock_init(&arena->lock))
+    {
+        tb_free(arena);
+        return tb_null;
+    }
+
+    // init it, the first chunk will be allocated lazily
+    arena->chunk_size = tb_align(chunk_size? chunk_size : DX_ARENA_CHUNK_SIZE_DEFAULT, DX_ARENA_ALIGN);
+    return (dx_arena_ref_t)arena;
+}
+tb_void_t dx_arena_exit(dx_arena_ref_t arena)
+{
+    // check
+    dx_arena_t* impl = (dx_arena_t*)arena;
+    tb_assert_and_check_return(impl);
+
+    // exit all chunks
+    dx_arena_chunk_t* chunk = impl->chunks;
+    while (chunk)
+    {
+        dx_arena_chunk_t* next = chunk->next;
+        tb_free(chunk);
+        chunk = next;
+    }
+    impl->chunks = tb_null;
+
+    // exit lock
+    tb_spinlock_exit(&impl->lock);
+
+    // exit it
+    tb_free(impl);
+}
+tb_void_t dx_arena_clear(dx_arena_ref_t arena)
+{
+    // check
+    dx_arena_t* impl = (dx_arena_t*)arena;
+    tb_assert_and_check_return(impl);
+
+    // enter
+    tb_spinlock_enter(&impl->lock);
+
+    // keep the current chunk if it is a normal chunk
+    dx_arena_chunk_t* chunk = impl->chunks;
+    if (chunk && chunk->size == impl->chunk_size)
+    {
+        chunk->used = 0;
+        chunk = chunk->next;
+        impl->chunks->next = tb_null;
+    }
+    else impl->chunks = tb_null;
+
+    // exit the other chunks
+    while (chunk)
+    {
+        dx_arena_chunk_t* next = chunk->next;
+        tb_free(chunk);
+        chunk = next;
+    }
+
+    // clear size
+    impl->size = 0;
+
+    // leave
+    tb_spinlock_leave(&impl->lock);
+}
+tb_pointer_t dx_arena_malloc0(dx_arena_ref_t arena, tb_size_t size)
+{
+    // check
+    dx_arena_t* impl = (dx_arena_t*)arena;
+    tb_assert_and_check_return_val(impl && size, tb_null);
+
+    // align size
+    size = tb_align(size, DX_ARENA_ALIGN);
+
+    // enter, the arena may be shared by multiple threads
+    tb_spinlock_enter(&impl->lock);
+
+    // done
+    tb_pointer_t data = tb_null;
+    do
+    {
+        // no enough space in the current chunk?
+        dx_arena_chunk_t* chunk = impl->chunks;
+        if (!chunk || chunk->used + size > chunk->size)
+        {
+            // the large data? allocate a dedicated chunk and do not change the current chunk
+            if (size > (impl->chunk_size >> 2))
+            {
+                chunk = dx_arena_chunk_init(size);
+                tb_assert_and_check_break(chunk);
+
+                if (impl->chunks)
+                {
+                    chunk->next = impl->chunks->next;
+                    impl->chunks->next = chunk;
+                }
+                else impl->chunks = chunk;
+            }
+            else
+            {
+                // make a new current chunk
+                chunk = dx_arena_chunk_init(impl->chunk_size);
+                tb_assert_and_check_break(chunk);
+
+                chunk->next = impl->chunks;
+                impl->chunks = chunk;
+            }
+        }
+
+        // allocate it
+        data = (tb_byte_t*)&chunk[1] + chunk->used;
+        chunk->used += size;
+        impl->size += size;
+
+    } while (0);
+
+    // leave
+    tb_spinlock_leave(&impl->lock);
+
+    // clear it
+    if (data) tb_memset(data, 0, size);
+    return data;
+}
+tb_void_t dx_arena_free(dx_arena_ref_t arena, tb_pointer_t data, tb_size_t size)
+{
+    // check
+    dx_arena_t* impl = (dx_arena_t*)arena;
+    tb_assert_and_check_return(impl && data && size);
+
+    // align size
+    size = tb_align(size, DX_ARENA_ALIGN);
+
+    // enter
+    tb_spinlock_enter(&impl->lock);
+
+    // is the last data of the current chunk? roll it back
+    dx_arena_chunk_t* chunk = impl->chunks;
+    if (chunk && chunk->used >= size && (tb_byte_t*)&chunk[1] + chunk->used - size == (tb_byte_t*)data)
+    {
+        chunk->used -= size;
+        impl->size -= size;
+    }
+
+    // leave
+    tb_spinlock_leave(&impl->lock);
+}
+tb_size_t dx_arena_size(dx_arena_ref_t arena)
+{
+    // check
+    dx_arena_t* impl = (dx_arena_t*)arena;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // get it
+    return impl->size;
+}
@@ -0,0 +1,97 @@
+/*!A lightweight dex file parsing library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2015-2020, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        arena.h
+ *
+ */
+#ifndef DX_ARENA_H
+#define DX_ARENA_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the arena
+ *
+ * the arena is a bump-pointer allocator, all allocated data will be freed at once 
+ * when it is cleared or exited. it can be shared with multiple dex files by dx_file_arena_set(),
+ * and allocating data from it is thread-safe.
+ *
+ * @param chunk_size    the chunk size, uses the default size if be zero
+ *
+ * @return              the arena
+ */
+dx_arena_ref_t          dx_arena_init(tb_size_t chunk_size);
+
+/*! exit the arena and free all data
+ *
+ * @param arena         the arena
+ */
+tb_void_t               dx_arena_exit(dx_arena_ref_t arena);
+
+/*! clear the arena and free all data, but the first chunk will be reused
+ *
+ * @param arena         the arena
+ */
+tb_void_t               dx_arena_clear(dx_arena_ref_t arena);
+
+/*! allocate the zeroed data from the arena
+ *
+ * @param arena         the arena
+ * @param size          the size
+ *
+ * @return              the data, it is aligned by 8 bytes
+ */
+tb_pointer_t            dx_arena_malloc0(dx_arena_ref_t arena, tb_size_t size);
+
+/*! free the data allocated from the arena
+ *
+ * only the last allocated data can be freed and reused directly,
+ * the other data will be freed when the arena is cleared or exited.
+ *
+ * @param arena         the arena
+ * @param data          the data
+ * @param size          the data size
+ */
+tb_void_t               dx_arena_free(dx_arena_ref_t arena, tb_pointer_t data, tb_size_t size);
+
+/*! get the allocated size of the arena
+ *
+ * @param arena         the arena
+ *
+ * @return              the allocated size
+ */
+tb_size_t               dx_arena_size(dx_arena_ref_t arena);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
+
@@ -38,6 +38,7 @@ tb_bool_t dx_catch_init(dx_catch_ref_t trycatch, dx_file_ref_t file, dx_code_ref
 
     // the data
     tb_byte_t const* data = dx_get_catch_handle_data(dexcode) + offset;
+    tb_check_return_val(dexfile->validated || (data >= dexfile->data && data < dexfile->data + dexfile->size), tb_false);
 
     // init stream
     if (!tb_static_stream_init(&trycatch->stream, (tb_byte_t*)data, dexfile->data + dexfile->size - data)) return tb_false;
@@ -99,6 +100,10 @@ tb_bool_t dx_catch_find(dx_catch_ref_t trycatch, dx_file_ref_t file, dx_code_ref
     dx_try_ref_t tries = dx_code_tries(code);
     tb_assert_and_check_return_val(tries, tb_false);
 
+    // the tries must be in this dex file if it has been not validated
+    dx_file_t* dexfile = (dx_file_t*)file;
+    tb_check_return_val(dexfile->validated || (tb_byte_t const*)(tries + tries_size) <= dexfile->data + dexfile->size, tb_false);
+
     // find offset
     tb_uint32_t offset = -1;
     if (tries_size == 1)
@@ -0,0 +1,475 @@
+/*!A lightweight dex file parsing library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2015-2020, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        cfg.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "cfg"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "dexbox.h"
+#include "impl/impl.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the pc is the start of an instruction
+#define DX_CFG_MARK_INSTR               (1)
+
+// the pc starts a new block if it is an instruction
+#define DX_CFG_MARK_LEADER              (2)
+
+// the pc is the branch, switch or handler target, it must be an instruction
+#define DX_CFG_MARK_TARGET              (4)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the cfg builder type
+typedef struct __dx_cfg_builder_t
+{
+    // the code
+    dx_code_t*              code;
+
+    // the pc marks, tb_byte_t[insns_size + 1]
+    tb_byte_t*              marks;
+
+    // the blocks
+    dx_cfg_block_t*         blocks;
+
+    // the block count
+    tb_size_t               blocks_size;
+
+    // the edges
+    tb_uint32_t*            edges;
+
+    // the edge count
+    tb_size_t               edges_size;
+
+    // the edge maxn
+    tb_size_t               edges_maxn;
+
+    // the stamps of the added successors for each block, it is used to remove the duplicate edges
+    tb_size_t*              stamps;
+
+}dx_cfg_builder_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t dx_cfg_branch_offset(dx_instruction_ref_t instruction, tb_sint32_t* offset)
+{
+    // get the branch offset from the format
+    switch (instruction->format)
+    {
+    case DX_INSTR_FMT_10t:
+    case DX_INSTR_FMT_20t:
+    case DX_INSTR_FMT_30t:
+        *offset = (tb_sint32_t)instruction->vA;
+        break;
+    case DX_INSTR_FMT_21t:
+        *offset = (tb_sint32_t)instruction->vB;
+        break;
+    case DX_INSTR_FMT_22t:
+        *offset = (tb_sint32_t)instruction->vC;
+        break;
+    default:
+        return tb_false;
+    }
+    return tb_true;
+}
+static tb_uint16_t const* dx_cfg_switch_payload(dx_code_t* code, tb_size_t pc, dx_instruction_ref_t instruction)
+{
+    // get the payload, it must be in the code
+    tb_hong_t payload_pc = (tb_hong_t)pc + (tb_sint32_t)instruction->vB;
+    tb_check_return_val(payload_pc >= 0 && payload_pc + 2 <= (tb_hong_t)code->insns_size, tb_null);
+
+    // check the payload ident and size
+    tb_uint16_t const* payload = code->insns + (tb_size_t)payload_pc;
+    tb_check_return_val(payload[0] == (instruction->opcode == DX_OPCODE_PACKED_SWITCH? DX_INSTR_IDENT_PACKED_SWITCH_PAYLOAD : DX_INSTR_IDENT_SPARSE_SWITCH_PAYLOAD), tb_null);
+    tb_check_return_val(dx_instr_width(payload) <= code->insns_size - (tb_size_t)payload_pc, tb_null);
+    return payload;
+}
+static tb_bool_t dx_cfg_mark_target(dx_cfg_builder_t* builder, tb_hong_t target)
+{
+    // the target must be in the code
+    tb_check_return_val(target >= 0 && target < (tb_hong_t)builder->code->insns_size, tb_false);
+    builder->marks[(tb_size_t)target] |= DX_CFG_MARK_LEADER | DX_CFG_MARK_TARGET;
+    return tb_true;
+}
+static tb_uint16_t const* dx_cfg_switch_targets(tb_uint16_t const* payload)
+{
+    // get the raw relative targets after the first key or the sorted keys
+    return payload + (payload[0] == DX_INSTR_IDENT_PACKED_SWITCH_PAYLOAD? 4 : 2 + ((tb_size_t)payload[1] << 1));
+}
+static tb_bool_t dx_cfg_mark_switch(dx_cfg_builder_t* builder, tb_size_t pc, tb_uint16_t const* payload)
+{
+    // the unsorted sparse keys are malformed, they are rejected like dx_code_switches()
+    if (payload[0] == DX_INSTR_IDENT_SPARSE_SWITCH_PAYLOAD && !dx_instr_sparse_switch_sorted(payload)) return tb_false;
+
+    // mark all switch targets from the raw target list, the same list will be used to add the edges
+    tb_size_t           i = 0;
+    tb_size_t           size = payload[1];
+    tb_uint16_t const*  targets = dx_cfg_switch_targets(payload);
+    for (i = 0; i < size; i++)
+    {
+        tb_sint32_t offset = (tb_sint32_t)(targets[i << 1] | ((tb_uint32_t)targets[(i << 1) + 1] << 16));
+        if (!dx_cfg_mark_target(builder, (tb_hong_t)pc + offset)) return tb_false;
+    }
+    return tb_true;
+}
+static tb_bool_t dx_cfg_mark_tries(dx_cfg_builder_t* builder, dx_file_ref_t file)
+{
+    // no tries?
+    dx_code_t*  code = builder->code;
+    tb_size_t   tries_size = code->tries_size;
+    tb_check_return_val(tries_size, tb_true);
+
+    // get tries
+    dx_try_ref_t tries = dx_code_tries((dx_code_ref_t)code);
+    tb_assert_and_check_return_val(tries, tb_false);
+
+    // mark the try boundaries and handlers
+    tb_size_t i = 0;
+    for (i = 0; i < tries_size; i++)
+    {
+        // the try range must be in the code
+        tb_size_t start = tries[i].start_addr;
+        tb_size_t end = start + tries[i].insn_count;
+        tb_check_return_val(end <= code->insns_size, tb_false);
+        builder->marks[start] |= DX_CFG_MARK_LEADER;
+        builder->marks[end] |= DX_CFG_MARK_LEADER;
+
+        // mark the handlers
+        dx_catch_t              trycatch;
+        dx_catch_handler_ref_t  handler = tb_null;
+        if (!dx_catch_init(&trycatch, file, (dx_code_ref_t)code, tries[i].handler_off)) return tb_false;
+        while ((handler = dx_catch_next(&trycatch)))
+        {
+            if (!dx_cfg_mark_target(builder, handler->address)) return tb_false;
+        }
+    }
+    return tb_true;
+}
+static tb_bool_t dx_cfg_mark(dx_cfg_builder_t* builder, dx_file_ref_t file)
+{
+    // mark the entry
+    builder->marks[0] |= DX_CFG_MARK_LEADER | DX_CFG_MARK_TARGET;
+
+    // mark the instructions and leaders in one linear pass, the payloads are skipped
+    dx_code_t*              code = builder->code;
+    tb_size_t               next = 0;
+    dx_code_iter_t          iter;
+    dx_instruction_ref_t    instruction = tb_null;
+    if (!dx_code_iter_init(&iter, (dx_code_ref_t)code, DX_CODE_ITER_MODE_SKIP_PAYLOAD)) return tb_false;
+    while ((instruction = dx_code_iter_next(&iter)))
+    {
+        // mark this instruction, it starts a new block if it follows the skipped payload
+        tb_size_t pc = dx_code_iter_pc(&iter);
+        builder->marks[pc] |= DX_CFG_MARK_INSTR;
+        if (pc != next) builder->marks[pc] |= DX_CFG_MARK_LEADER;
+        next = pc + dx_code_iter_width(&iter);
+
+        // mark the branch target
+        tb_size_t flags = instruction->flags;
+        if (flags & DX_INSTR_FLAGS_CAN_BRANCH)
+        {
+            tb_sint32_t offset = 0;
+            if (!dx_cfg_branch_offset(instruction, &offset)) return tb_false;
+            if (!dx_cfg_mark_target(builder, (tb_hong_t)pc + offset)) return tb_false;
+        }
+
+        // mark the switch targets
+        if (flags & DX_INSTR_FLAGS_CAN_SWITCH)
+        {
+            tb_uint16_t const* payload = dx_cfg_switch_payload(code, pc, instruction);
+            if (!payload || !dx_cfg_mark_switch(builder, pc, payload)) return tb_false;
+        }
+
+        // the next instruction starts a new block after the branch, switch, return and throw
+        if ((flags & (DX_INSTR_FLAGS_CAN_BRANCH | DX_INSTR_FLAGS_CAN_SWITCH)) || !(flags & DX_INSTR_FLAGS_CAN_CONTINUE))
+            builder->marks[next] |= DX_CFG_MARK_LEADER;
+    }
+    tb_check_return_val(!dx_code_iter_failed(&iter), tb_false);
+
+    // mark the try boundaries and handlers
+    return dx_cfg_mark_tries(builder, file);
+}
+static tb_long_t dx_cfg_block_index(dx_cfg_builder_t* builder, tb_size_t pc)
+{
+    // find the block starting at this pc by the binary search
+    tb_size_t l = 0;
+    tb_size_t r = builder->blocks_size;
+    while (l < r)
+    {
+        tb_size_t m = (l + r) >> 1;
+        if (builder->blocks[m].start < pc) l = m + 1;
+        else r = m;
+    }
+    return (l < builder->blocks_size && builder->blocks[l].start == pc)? (tb_long_t)l : -1;
+}
+static tb_bool_t dx_cfg_add_edge(dx_cfg_builder_t* builder, tb_size_t pc, tb_size_t stamp)
+{
+    // get the target block
+    tb_long_t index = dx_cfg_block_index(builder, pc);
+    tb_check_return_val(index >= 0, tb_false);
+
+    // has been added to the current block?
+    if (builder->stamps[index] == stamp) return tb_true;
+    builder->stamps[index] = stamp;
+
+    // grow edges
+    if (builder->edges_size == builder->edges_maxn)
+    {
+        tb_size_t       maxn = builder->edges_maxn? builder->edges_maxn << 1 : 64;
+        tb_uint32_t*    edges = (tb_uint32_t*)tb_ralloc(builder->edges, maxn * sizeof(tb_uint32_t));
+        tb_assert_and_check_return_val(edges, tb_false);
+        builder->edges = edges;
+        builder->edges_maxn = maxn;
+    }
+
+    // add edge
+    builder->edges[builder->edges_size++] = (tb_uint32_t)index;
+    return tb_true;
+}
+static tb_bool_t dx_cfg_add_block_edges(dx_cfg_builder_t* builder, dx_file_ref_t file, tb_size_t index, tb_size_t pc, dx_instruction_ref_t instruction, tb_bool_t can_throw)
+{
+    // add the normal successors of the last instruction
+    dx_code_t*      code = builder->code;
+    dx_cfg_block_t* block = &builder->blocks[index];
+    tb_size_t       flags = instruction->flags;
+    tb_size_t       stamp = (index << 1) + 1;
+    block->succs = (tb_uint32_t)builder->edges_size;
+    if (flags & DX_INSTR_FLAGS_CAN_BRANCH)
+    {
+        tb_sint32_t offset = 0;
+        dx_cfg_branch_offset(instruction, &offset);
+        if (!dx_cfg_add_edge(builder, (tb_size_t)((tb_hong_t)pc + offset), stamp)) return tb_false;
+    }
+    if (flags & DX_INSTR_FLAGS_CAN_SWITCH)
+    {
+        // the payload has been checked when marking
+        tb_size_t           i = 0;
+        tb_uint16_t const*  payload = dx_cfg_switch_payload(code, pc, instruction);
+        tb_size_t           size = payload[1];
+        tb_uint16_t const*  targets = dx_cfg_switch_targets(payload);
+        for (i = 0; i < size; i++)
+        {
+            tb_sint32_t offset = (tb_sint32_t)(targets[i << 1] | ((tb_uint32_t)targets[(i << 1) + 1] << 16));
+            if (!dx_cfg_add_edge(builder, (tb_size_t)((tb_hong_t)pc + offset), stamp)) return tb_false;
+        }
+    }
+    if (flags & DX_INSTR_FLAGS_CAN_CONTINUE)
+    {
+        /* it cannot fall through to the end of the code or the payload,
+         * but the nop may be only the padding before the aligned payload, it has no successor
+         */
+        tb_size_t next = pc + instruction->width;
+        tb_bool_t fallthrough = next < code->insns_size && (builder->marks[next] & DX_CFG_MARK_INSTR);
+        tb_check_return_val(fallthrough || instruction->opcode == DX_OPCODE_NOP, tb_false);
+        if (fallthrough && !dx_cfg_add_edge(builder, next, stamp)) return tb_false;
+    }
+    block->succs_size = (tb_uint32_t)(builder->edges_size - block->succs);
+
+    // add the catch handlers if this block can throw, the whole block is in the same try range
+    dx_catch_t trycatch;
+    if (can_throw && dx_catch_find(&trycatch, file, (dx_code_ref_t)code, block->start))
+    {
+        dx_catch_handler_ref_t handler = tb_null;
+        while ((handler = dx_catch_next(&trycatch)))
+        {
+            if (!dx_cfg_add_edge(builder, handler->address, stamp + 1)) return tb_false;
+        }
+    }
+    block->catches_size = (tb_uint32_t)(builder->edges_size - block->succs - block->succs_size);
+    return tb_true;
+}
+static tb_bool_t dx_cfg_split(dx_cfg_builder_t* builder, dx_file_ref_t file)
+{
+    // make the blocks at all leaders, the leaders of the branch and handler targets must be instructions
+    tb_size_t   pc = 0;
+    tb_size_t   index = 0;
+    dx_code_t*  code = builder->code;
+    tb_byte_t*  marks = builder->marks;
+    for (pc = 0; pc < code->insns_size; pc++)
+    {
+        tb_size_t mark = marks[pc];
+        if (mark & DX_CFG_MARK_TARGET) tb_check_return_val(mark & DX_CFG_MARK_INSTR, tb_false);
+        if ((mark & (DX_CFG_MARK_INSTR | DX_CFG_MARK_LEADER)) == (DX_CFG_MARK_INSTR | DX_CFG_MARK_LEADER))
+            builder->blocks[index++].start = (tb_uint32_t)pc;
+    }
+    tb_assert_and_check_return_val(index == builder->blocks_size, tb_false);
+
+    // add the block edges at the last instruction of each block
+    tb_bool_t               can_throw = tb_false;
+    dx_code_iter_t          iter;
+    dx_instruction_ref_t    instruction = tb_null;
+    index = 0;
+    dx_code_iter_init(&iter, (dx_code_ref_t)code, DX_CODE_ITER_MODE_SKIP_PAYLOAD);
+    while ((instruction = dx_code_iter_next(&iter)))
+    {
+        // is the last instruction of this block?
+        pc = dx_code_iter_pc(&iter);
+        tb_size_t next = pc + dx_code_iter_width(&iter);
+        if (instruction->flags & DX_INSTR_FLAGS_CAN_THROW) can_throw = tb_true;
+        if (next < code->insns_size && (marks[next] & DX_CFG_MARK_INSTR) && !(marks[next] & DX_CFG_MARK_LEADER)) continue;
+
+        // end this block
+        tb_assert_and_check_return_val(index < builder->blocks_size, tb_false);
+        builder->blocks[index].end = (tb_uint32_t)next;
+        if (!dx_cfg_add_block_edges(builder, file, index, pc, instruction, can_throw)) return tb_false;
+        can_throw = tb_false;
+        index++;
+    }
+    return index == builder->blocks_size;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+dx_cfg_ref_t dx_cfg_build(dx_method_ref_t method)
+{
+    // check
+    dx_method_t* dexmethod = (dx_method_t*)method;
+    tb_assert_and_check_return_val(dexmethod && dexmethod->dexfile, tb_null);
+
+    // get the cached graph
+    dx_file_t* dexfile = dexmethod->dexfile;
+    tb_check_return_val(dexmethod->method_idx < dexfile->cfgs.size, tb_null);
+    tb_pointer_t cfg = dx_ptable_get(&dexfile->cfgs, dexmethod->method_idx);
+    if (!cfg)
+    {
+        // get code
+        dx_code_t* code = dx_method_get_code(dexfile, dexmethod);
+        tb_check_return_val(code, tb_null);
+
+        // build it to the codes arena of this dex file
+        dx_arena_ref_t arena = dx_file_codes_arena(dexfile);
+        tb_assert_and_check_return_val(arena, tb_null);
+
+        cfg = dx_cfg_build_from_code((dx_file_ref_t)dexfile, (dx_code_ref_t)code, arena);
+
+        /* publish it or the failure, the malformed code will not be built again,
+         * another thread may have published it and ours will be freed with the arena
+         */
+        cfg = dx_ptable_publish(&dexfile->cfgs, dexmethod->method_idx, cfg? cfg : DX_PTABLE_FAILED);
+    }
+
+    // ok?
+    return cfg != DX_PTABLE_FAILED? (dx_cfg_ref_t)cfg : tb_null;
+}
+dx_cfg_ref_t dx_cfg_build_from_code(dx_file_ref_t file, dx_code_ref_t code, dx_arena_ref_t arena)
+{
+    // check
+    dx_code_t* dexcode = (dx_code_t*)code;
+    tb_assert_and_check_return_val(file && dexcode && arena, tb_null);
+
+    // empty code?
+    tb_check_return_val(dexcode->insns_size, tb_null);
+
+    // done
+    dx_cfg_t*           cfg = tb_null;
+    tb_size_t           cfg_size = 0;
+    dx_cfg_builder_t    builder = {0};
+    builder.code = dexcode;
+    do
+    {
+        // mark the instructions and leaders, the end of the code may be marked as leader
+        builder.marks = (tb_byte_t*)tb_malloc0(dexcode->insns_size + 1);
+        tb_assert_and_check_break(builder.marks);
+        if (!dx_cfg_mark(&builder, file)) break;
+
+        // count the blocks
+        tb_size_t pc = 0;
+        for (pc = 0; pc < dexcode->insns_size; pc++)
+        {
+            if ((builder.marks[pc] & (DX_CFG_MARK_INSTR | DX_CFG_MARK_LEADER)) == (DX_CFG_MARK_INSTR | DX_CFG_MARK_LEADER))
+                builder.blocks_size++;
+        }
+        tb_check_break(builder.blocks_size);
+
+        // make the graph, the blocks follow it
+        cfg_size = sizeof(dx_cfg_t) + builder.blocks_size * sizeof(dx_cfg_block_t);
+        cfg = (dx_cfg_t*)dx_arena_malloc0(arena, cfg_size);
+        tb_assert_and_check_break(cfg);
+        builder.blocks = (dx_cfg_block_t*)(cfg + 1);
+
+        // split the blocks and add the edges
+        builder.stamps = tb_nalloc0_type(builder.blocks_size, tb_size_t);
+        tb_assert_and_check_break(builder.stamps);
+        if (!dx_cfg_split(&builder, file)) break;
+
+        // copy the edges to the arena
+        tb_uint32_t* edges = tb_null;
+        if (builder.edges_size)
+        {
+            edges = (tb_uint32_t*)dx_arena_malloc0(arena, builder.edges_size * sizeof(tb_uint32_t));
+            tb_assert_and_check_break(edges);
+            tb_memcpy(edges, builder.edges, builder.edges_size * sizeof(tb_uint32_t));
+        }
+
+        // ok
+        cfg->blocks_size    = builder.blocks_size;
+        cfg->blocks         = builder.blocks;
+        cfg->edges_size     = builder.edges_size;
+        cfg->edges          = edges;
+
+    } while (0);
+
+    // failed? give back the graph if it is still the last allocated data of the arena
+    if (cfg && !cfg->blocks)
+    {
+        dx_arena_free(arena, cfg, cfg_size);
+        cfg = tb_null;
+    }
+
+    // exit the builder
+    if (builder.marks) tb_free(builder.marks);
+    if (builder.edges) tb_free(builder.edges);
+    if (builder.stamps) tb_free(builder.stamps);
+
+    // trace
+    tb_trace_d("build: %lu blocks, %lu edges, %s", builder.blocks_size, builder.edges_size, cfg? "ok" : "failed");
+
+    // ok?
+    return cfg;
+}
+dx_cfg_block_ref_t dx_cfg_block_find(dx_cfg_ref_t cfg, tb_size_t pc)
+{
+    // check
+    tb_assert_and_check_return_val(cfg, tb_null);
+
+    // find the last block starting before or at this pc by the binary search
+    tb_size_t l = 0;
+    tb_size_t r = cfg->blocks_size;
+    while (l < r)
+    {
+        tb_size_t m = (l + r) >> 1;
+        if (cfg->blocks[m].start <= pc) l = m + 1;
+        else r = m;
+    }
+    return (l && pc < cfg->blocks[l - 1].end)? (dx_cfg_block_ref_t)&cfg->blocks[l - 1] : tb_null;
+}
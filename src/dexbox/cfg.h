@@ -0,0 +1,133 @@
+/*!A lightweight dex file parsing library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2015-2020, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        cfg.h
+ *
+ */
+#ifndef DX_CFG_H
+#define DX_CFG_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the basic block of the control flow graph, it is 20 bytes
+typedef struct __dx_cfg_block_t
+{
+    /// the pc of the first instruction
+    tb_uint32_t             start;
+
+    /// the pc after the last instruction, the block contains the instructions in [start, end)
+    tb_uint32_t             end;
+
+    /// the index of the first successor in dx_cfg_t.edges
+    tb_uint32_t             succs;
+
+    /// the count of the normal successors, e.g. the branch, switch and fall-through targets
+    tb_uint32_t             succs_size;
+
+    /// the count of the exceptional successors, they are the catch handlers and follow the normal successors
+    tb_uint32_t             catches_size;
+
+}dx_cfg_block_t, *dx_cfg_block_ref_t;
+
+/*! the control flow graph of the method
+ *
+ * @code
+ *  dx_cfg_ref_t cfg = dx_cfg_build(method);
+ *  for (i = 0; cfg && i < cfg->blocks_size; i++)
+ *  {
+ *      dx_cfg_block_t const* block = &cfg->blocks[i];
+ *      for (j = 0; j < block->succs_size + block->catches_size; j++)
+ *      {
+ *          dx_cfg_block_t const* succ = &cfg->blocks[cfg->edges[block->succs + j]];
+ *          // ...
+ *      }
+ *  }
+ * @endcode
+ */
+typedef struct __dx_cfg_t
+{
+    /// the block count
+    tb_size_t               blocks_size;
+
+    /// the blocks, they are sorted by pc and the entry block is the first
+    dx_cfg_block_t const*   blocks;
+
+    /// the edge count
+    tb_size_t               edges_size;
+
+    /// the successor block indices of all blocks
+    tb_uint32_t const*      edges;
+
+}dx_cfg_t, *dx_cfg_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! build the control flow graph of the method, it will be built and cached at the first time
+ *
+ * the graph is kept until the dex file is exited or dx_file_codes_clear() is called.
+ *
+ * @param method        the dex method
+ *
+ * @return              the control flow graph, tb_null if there is no code or the code is malformed
+ */
+dx_cfg_ref_t            dx_cfg_build(dx_method_ref_t method);
+
+/*! build the control flow graph of the code
+ *
+ * the code is split into the basic blocks at the branch, switch and catch handler targets,
+ * the try boundaries and after the instructions which cannot continue.
+ * the block in the try range has the exceptional edges to all handlers if it can throw.
+ *
+ * @param file          the dex file
+ * @param code          the dex code
+ * @param arena         the arena, the graph will be freed with it
+ *
+ * @return              the control flow graph, tb_null if the code is malformed, e.g. the unsorted sparse-switch keys
+ */
+dx_cfg_ref_t            dx_cfg_build_from_code(dx_file_ref_t file, dx_code_ref_t code, dx_arena_ref_t arena);
+
+/*! find the block containing the given pc
+ *
+ * @param cfg           the control flow graph
+ * @param pc            the instruction pc
+ *
+ * @return              the block, tb_null if not found
+ */
+dx_cfg_block_ref_t      dx_cfg_block_find(dx_cfg_ref_t cfg, tb_size_t pc);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
+
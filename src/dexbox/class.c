@@ -61,6 +61,15 @@ tb_char_t const* dx_class_descriptor_super(dx_class_ref_t clasz)
     // get it
     return dx_file_get_string_by_type_idx(dexclass->dexfile, dexclass->class_def->superclass_idx);
 }
+dx_file_ref_t dx_class_dexfile(dx_class_ref_t clasz)
+{
+    // check
+    dx_class_t* dexclass = (dx_class_t*)clasz;
+    tb_assert_and_check_return_val(dexclass, tb_null);
+
+    // get it
+    return (dx_file_ref_t)dexclass->dexfile;
+}
 dx_method_ref_t dx_class_method_direct(dx_class_ref_t clasz, tb_size_t method_idx)
 {
     // check
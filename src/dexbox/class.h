@@ -59,6 +59,14 @@ tb_char_t const*        dx_class_descriptor(dx_class_ref_t clasz);
  */
 tb_char_t const*        dx_class_descriptor_super(dx_class_ref_t clasz);
 
+/*! get the dex file of the given class
+ *
+ * @param clasz         the class 
+ *
+ * @return              the dex file
+ */
+dx_file_ref_t           dx_class_dexfile(dx_class_ref_t clasz);
+
 /*! get the direct method 
  *
  * @param clasz         the dex class
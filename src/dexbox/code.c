@@ -31,6 +31,211 @@
 #include "dexbox.h"
 #include "impl/impl.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros 
+ */
+
+// fetch four bytes from the instruction offset
+#define DX_CODE_FETCH_u4(instr, offset)             ((instr)[(offset)] | ((tb_uint32_t)((instr)[(offset) + 1]) << 16))
+
+// the size of the switch instruction, it is the pc offset if the value is not matched
+#define DX_CODE_SWITCH_MISSED                       (3)
+
+// the sparse-switch will be compiled to the direct table if its key range is not larger than (size * 2 + 16)
+#define DX_CODE_SWITCH_DIRECT_MINN                  (16)
+
+// the maximum keys of the perfect hash table, the large sparse-switch will use the binary search
+#define DX_CODE_SWITCH_HASH_MAXN                    (128)
+
+// the maximum tries of finding the perfect hash for each table size
+#define DX_CODE_SWITCH_HASH_TRIES                   (64)
+
+// the maximum growth of the perfect hash table, the slots will be 8 times of the keys at most
+#define DX_CODE_SWITCH_HASH_GROWS                   (2)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation 
+ */
+static tb_size_t dx_code_instr_width(tb_uint16_t const* instr, tb_size_t left)
+{
+    // the payload header must be in the code
+    tb_uint16_t instr_unit = instr[0];
+    if (instr_unit == DX_INSTR_IDENT_SPARSE_SWITCH_PAYLOAD) tb_check_return_val(left >= 2, 0);
+    else if (instr_unit == DX_INSTR_IDENT_PACKED_SWITCH_PAYLOAD || instr_unit == DX_INSTR_IDENT_FILL_ARRAY_DATA) tb_check_return_val(left >= 4, 0);
+
+    // the whole instruction must be in the code
+    tb_size_t width = dx_instr_width(instr);
+    return width <= left? width : 0;
+}
+static tb_bool_t dx_code_instr_count(dx_code_t* dexcode, tb_size_t* psize, tb_size_t* pswitches)
+{
+    // walk all instructions by their widths only, they will be decoded at the next pass
+    tb_size_t           pc = 0;
+    tb_size_t           size = 0;
+    tb_size_t           switches = 0;
+    tb_size_t           insns_size = dexcode->insns_size;
+    tb_uint16_t const*  insns = dexcode->insns;
+    while (pc < insns_size)
+    {
+        // the whole instruction must be in the code
+        tb_size_t width = dx_code_instr_width(insns + pc, insns_size - pc);
+        tb_check_return_val(width, tb_false);
+
+        // is switch? the low byte of the payload idents is zero
+        tb_uint16_t opcode = insns[pc] & 0xff;
+        if (opcode == DX_OPCODE_PACKED_SWITCH || opcode == DX_OPCODE_SPARSE_SWITCH) switches++;
+        pc += width;
+        size++;
+    }
+
+    // ok
+    if (psize) *psize = size;
+    if (pswitches) *pswitches = switches;
+    return tb_true;
+}
+static __tb_inline__ tb_size_t dx_code_switch_hash(tb_sint32_t value, tb_uint32_t mul, tb_size_t shift)
+{
+    // the multiplicative hash, the high bits are used
+    return (tb_size_t)(((tb_uint32_t)value * mul) >> shift);
+}
+static tb_bool_t dx_code_switch_make_hash(dx_code_switch_t* table, tb_uint16_t const* payload, tb_size_t size, dx_arena_ref_t arena)
+{
+    // the keys and targets of the sparse-switch payload
+    tb_uint16_t const*  keys = payload + 2;
+    tb_uint16_t const*  targets = payload + 2 + (size << 1);
+
+    // find the perfect hash, the slots are at least twice as many as the keys
+    tb_size_t   i = 0;
+    tb_size_t   bits = 2;
+    tb_size_t   grow = 0;
+    tb_size_t   tries = 0;
+    tb_uint32_t mul = 0x9e3779b1;
+    tb_byte_t*  used = tb_null;
+    tb_bool_t   found = tb_false;
+    while (((tb_size_t)1 << bits) < (size << 1)) bits++;
+    for (grow = 0; grow <= DX_CODE_SWITCH_HASH_GROWS && !found; grow++)
+    {
+        // make the used slots
+        tb_size_t slots = (tb_size_t)1 << bits;
+        tb_byte_t* data = (tb_byte_t*)tb_ralloc(used, slots);
+        tb_assert_and_check_break(data);
+        used = data;
+
+        // try the multipliers
+        for (tries = 0; tries < DX_CODE_SWITCH_HASH_TRIES; tries++)
+        {
+            tb_memset(used, 0, slots);
+            for (i = 0; i < size; i++)
+            {
+                tb_size_t slot = dx_code_switch_hash((tb_sint32_t)DX_CODE_FETCH_u4(keys, i << 1), mul, 32 - bits);
+                if (used[slot]) break;
+                used[slot] = 1;
+            }
+            if (i == size)
+            {
+                found = tb_true;
+                break;
+            }
+
+            // the next odd multiplier
+            mul = (mul * 1664525 + 1013904223) | 1;
+        }
+
+        // grow the slots
+        if (!found) bits++;
+    }
+    if (used) tb_free(used);
+    tb_check_return_val(found, tb_false);
+
+    /* make the hash table
+     *
+     * the empty slots use the first key, it is never hashed to them, so they are always missed.
+     */
+    tb_size_t       slots = (tb_size_t)1 << bits;
+    tb_sint32_t*    data = (tb_sint32_t*)dx_arena_malloc0(arena, (slots << 1) * sizeof(tb_sint32_t));
+    tb_assert_and_check_return_val(data, tb_false);
+    for (i = 0; i < slots; i++)
+    {
+        data[i]         = (tb_sint32_t)DX_CODE_FETCH_u4(keys, 0);
+        data[slots + i] = DX_CODE_SWITCH_MISSED;
+    }
+    for (i = 0; i < size; i++)
+    {
+        tb_sint32_t key = (tb_sint32_t)DX_CODE_FETCH_u4(keys, i << 1);
+        tb_size_t   slot = dx_code_switch_hash(key, mul, 32 - bits);
+        data[slot]          = key;
+        data[slots + slot]  = (tb_sint32_t)DX_CODE_FETCH_u4(targets, i << 1);
+    }
+    table->mode     = DX_CODE_SWITCH_MODE_HASH;
+    table->shift    = (tb_uint16_t)(32 - bits);
+    table->mul      = mul;
+    table->size     = (tb_uint32_t)slots;
+    table->keys     = data;
+    table->targets  = data + slots;
+    return tb_true;
+}
+static tb_bool_t dx_code_switch_make(dx_code_switch_t* table, tb_uint16_t const* payload, tb_bool_t packed, dx_arena_ref_t arena)
+{
+    // the packed-switch? make the direct table
+    tb_size_t i = 0;
+    tb_size_t size = payload[1];
+    if (packed)
+    {
+        tb_sint32_t* targets = size? (tb_sint32_t*)dx_arena_malloc0(arena, size * sizeof(tb_sint32_t)) : tb_null;
+        tb_assert_and_check_return_val(targets || !size, tb_false);
+        for (i = 0; i < size; i++) targets[i] = (tb_sint32_t)DX_CODE_FETCH_u4(payload, 4 + (i << 1));
+
+        table->mode         = DX_CODE_SWITCH_MODE_DIRECT;
+        table->first_key    = (tb_sint32_t)DX_CODE_FETCH_u4(payload, 2);
+        table->size         = (tb_uint32_t)size;
+        table->targets      = targets;
+        return tb_true;
+    }
+
+    // the empty sparse-switch? it is always missed
+    table->mode = DX_CODE_SWITCH_MODE_DIRECT;
+    tb_check_return_val(size, tb_true);
+
+    // the keys must be sorted low-to-high
+    tb_check_return_val(dx_instr_sparse_switch_sorted(payload), tb_false);
+    tb_uint16_t const* keys = payload + 2;
+    tb_uint16_t const* targets = payload + 2 + (size << 1);
+
+    // the dense keys? make the direct table
+    tb_sint32_t first_key = (tb_sint32_t)DX_CODE_FETCH_u4(keys, 0);
+    tb_hong_t   range = (tb_hong_t)(tb_sint32_t)DX_CODE_FETCH_u4(keys, (size - 1) << 1) - first_key + 1;
+    if (range <= (tb_hong_t)((size << 1) + DX_CODE_SWITCH_DIRECT_MINN))
+    {
+        tb_sint32_t* data = (tb_sint32_t*)dx_arena_malloc0(arena, (tb_size_t)range * sizeof(tb_sint32_t));
+        tb_assert_and_check_return_val(data, tb_false);
+        for (i = 0; i < (tb_size_t)range; i++) data[i] = DX_CODE_SWITCH_MISSED;
+        for (i = 0; i < size; i++)
+            data[(tb_uint32_t)DX_CODE_FETCH_u4(keys, i << 1) - (tb_uint32_t)first_key] = (tb_sint32_t)DX_CODE_FETCH_u4(targets, i << 1);
+
+        table->first_key    = first_key;
+        table->size         = (tb_uint32_t)range;
+        table->targets      = data;
+        return tb_true;
+    }
+
+    // make the perfect hash table
+    if (size <= DX_CODE_SWITCH_HASH_MAXN && dx_code_switch_make_hash(table, payload, size, arena)) return tb_true;
+
+    // no perfect hash? search the sorted keys
+    tb_sint32_t* data = (tb_sint32_t*)dx_arena_malloc0(arena, (size << 1) * sizeof(tb_sint32_t));
+    tb_assert_and_check_return_val(data, tb_false);
+    for (i = 0; i < size; i++)
+    {
+        data[i]         = (tb_sint32_t)DX_CODE_FETCH_u4(keys, i << 1);
+        data[size + i]  = (tb_sint32_t)DX_CODE_FETCH_u4(targets, i << 1);
+    }
+    table->mode     = DX_CODE_SWITCH_MODE_SEARCH;
+    table->size     = (tb_uint32_t)size;
+    table->keys     = data;
+    table->targets  = data + size;
+    return tb_true;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation 
  */
@@ -103,6 +308,331 @@ tb_uint16_t const* dx_code_instr_data(dx_code_ref_t code)
     // get it
     return (tb_uint16_t const*)dexcode->insns;
 }
+tb_bool_t dx_code_iter_init(dx_code_iter_ref_t iter, dx_code_ref_t code, tb_size_t mode)
+{
+    // check
+    dx_code_t* dexcode = (dx_code_t*)code;
+    tb_assert_and_check_return_val(iter && dexcode, tb_false);
+
+    // init it
+    iter->insns         = dexcode->insns;
+    iter->insns_size    = dexcode->insns_size;
+    iter->pc            = 0;
+    iter->width         = 0;
+    iter->mode          = (tb_uint16_t)mode;
+    iter->payload       = 0;
+    iter->failed        = tb_false;
+    return tb_true;
+}
+dx_instruction_ref_t dx_code_iter_next(dx_code_iter_ref_t iter)
+{
+    // check
+    tb_assert_and_check_return_val(iter && iter->insns, tb_null);
+
+    // done
+    while (!iter->failed)
+    {
+        // the end?
+        tb_size_t pc = iter->pc + iter->width;
+        tb_check_break(pc < iter->insns_size);
+
+        // get the width, the whole instruction must be in the code
+        tb_uint16_t const*  instr = iter->insns + pc;
+        tb_size_t           width = dx_code_instr_width(instr, iter->insns_size - pc);
+        if (!width)
+        {
+            iter->failed = tb_true;
+            break;
+        }
+        iter->pc    = pc;
+        iter->width = width;
+
+        // is payload? skip it if needed
+        tb_uint16_t instr_unit = instr[0];
+        iter->payload = (instr_unit == DX_INSTR_IDENT_PACKED_SWITCH_PAYLOAD || instr_unit == DX_INSTR_IDENT_SPARSE_SWITCH_PAYLOAD || instr_unit == DX_INSTR_IDENT_FILL_ARRAY_DATA)? instr_unit : 0;
+        if (iter->payload && (iter->mode & DX_CODE_ITER_MODE_SKIP_PAYLOAD)) continue;
+
+        // decode instruction, only the operands of its format will be decoded
+        if (!dx_instr_decode(instr, &iter->instruction))
+        {
+            iter->failed = tb_true;
+            break;
+        }
+        return &iter->instruction;
+    }
+    return tb_null;
+}
+tb_size_t dx_code_iter_pc(dx_code_iter_ref_t iter)
+{
+    // check
+    tb_assert_and_check_return_val(iter, 0);
+
+    // get it
+    return iter->pc;
+}
+tb_size_t dx_code_iter_width(dx_code_iter_ref_t iter)
+{
+    // check
+    tb_assert_and_check_return_val(iter, 0);
+
+    // get it
+    return iter->width;
+}
+tb_size_t dx_code_iter_payload(dx_code_iter_ref_t iter)
+{
+    // check
+    tb_assert_and_check_return_val(iter, 0);
+
+    // get it
+    return iter->payload;
+}
+tb_bool_t dx_code_iter_failed(dx_code_iter_ref_t iter)
+{
+    // check
+    tb_assert_and_check_return_val(iter, tb_true);
+
+    // failed?
+    return iter->failed;
+}
+dx_code_predecode_ref_t dx_code_predecode(dx_code_ref_t code, dx_arena_ref_t arena)
+{
+    // check
+    dx_code_t* dexcode = (dx_code_t*)code;
+    tb_assert_and_check_return_val(dexcode && arena, tb_null);
+
+    // count instructions by their widths first, so the dense array can be allocated at once
+    tb_size_t size = 0;
+    if (!dx_code_instr_count(dexcode, &size, tb_null)) return tb_null;
+
+    // make the predecoded code, the instructions follow it
+    tb_size_t               predecode_size = sizeof(dx_code_predecode_t) + size * sizeof(dx_code_instr_t);
+    dx_code_predecode_t*    predecode = (dx_code_predecode_t*)dx_arena_malloc0(arena, predecode_size);
+    tb_assert_and_check_return_val(predecode, tb_null);
+
+    // decode all instructions
+    tb_size_t               i = 0;
+    tb_uint32_t             switches_size = 0;
+    dx_code_instr_t*        instrs = (dx_code_instr_t*)(predecode + 1);
+    dx_instruction_ref_t    instruction = tb_null;
+    dx_code_iter_t          iter;
+    dx_code_iter_init(&iter, code, DX_CODE_ITER_MODE_NONE);
+    while (i < size && (instruction = dx_code_iter_next(&iter)))
+    {
+        // save it, the payloads are only data and have no control flow
+        dx_code_instr_t* instr = &instrs[i++];
+        instr->pc           = (tb_uint32_t)dx_code_iter_pc(&iter);
+        instr->width        = (tb_uint32_t)dx_code_iter_width(&iter);
+        instr->opcode       = (tb_uint8_t)instruction->opcode;
+        instr->format       = instruction->format;
+        instr->index_type   = instruction->index_type;
+        instr->flags        = dx_code_iter_payload(&iter)? 0 : instruction->flags;
+        switch (instruction->format)
+        {
+        case DX_INSTR_FMT_10x:
+        case DX_INSTR_FMT_11x:
+        case DX_INSTR_FMT_10t:
+        case DX_INSTR_FMT_20t:
+        case DX_INSTR_FMT_30t:
+            instr->vA    = instruction->vA;
+            break;
+        case DX_INSTR_FMT_12x:
+        case DX_INSTR_FMT_11n:
+        case DX_INSTR_FMT_22x:
+        case DX_INSTR_FMT_21s:
+        case DX_INSTR_FMT_21t:
+        case DX_INSTR_FMT_21h:
+        case DX_INSTR_FMT_32x:
+        case DX_INSTR_FMT_31i:
+            instr->vA    = instruction->vA;
+            instr->vB    = instruction->vB;
+            break;
+        case DX_INSTR_FMT_31t:
+            {
+                // the switch has the index of its jump table, they are in the same order
+                instr->vA    = instruction->vA;
+                instr->vB    = instruction->vB;
+                if (instruction->opcode == DX_OPCODE_PACKED_SWITCH || instruction->opcode == DX_OPCODE_SPARSE_SWITCH)
+                    instr->index = switches_size++;
+            }
+            break;
+        case DX_INSTR_FMT_20bc:
+        case DX_INSTR_FMT_21c:
+        case DX_INSTR_FMT_31c:
+            instr->vA    = instruction->vA;
+            instr->vB    = instruction->vB;
+            instr->index = instruction->vB;
+            break;
+        case DX_INSTR_FMT_23x:
+        case DX_INSTR_FMT_22b:
+        case DX_INSTR_FMT_22s:
+        case DX_INSTR_FMT_22t:
+            instr->vA    = instruction->vA;
+            instr->vB    = instruction->vB;
+            instr->vC    = instruction->vC;
+            break;
+        case DX_INSTR_FMT_22c:
+        case DX_INSTR_FMT_22cs:
+            instr->vA    = instruction->vA;
+            instr->vB    = instruction->vB;
+            instr->vC    = instruction->vC;
+            instr->index = instruction->vC;
+            break;
+        case DX_INSTR_FMT_3rc:
+        case DX_INSTR_FMT_3rms:
+        case DX_INSTR_FMT_3rmi:
+            instr->vA    = instruction->vA;
+            instr->vB    = instruction->vB;
+            instr->vC    = instruction->vC;
+            instr->index = instruction->vB;
+            break;
+        case DX_INSTR_FMT_35c:
+        case DX_INSTR_FMT_35ms:
+        case DX_INSTR_FMT_35mi:
+            {
+                // only the first vA arguments are decoded
+                tb_size_t j = 0;
+                for (j = 0; j < instruction->vA; j++) instr->args |= instruction->arg[j] << (j << 2);
+                instr->vA    = instruction->vA;
+                instr->vB    = instruction->vB;
+                instr->vC    = instruction->vA? instruction->vC : 0;
+                instr->index = instruction->vB;
+            }
+            break;
+        case DX_INSTR_FMT_51l:
+            instr->vA    = instruction->vA;
+            instr->vB    = (tb_uint32_t)instruction->vB_wide;
+            instr->vC    = (tb_uint32_t)(instruction->vB_wide >> 32);
+            break;
+        default:
+            break;
+        }
+    }
+
+    // failed?
+    if (i < size || dx_code_iter_failed(&iter))
+    {
+        dx_arena_free(arena, predecode, predecode_size);
+        return tb_null;
+    }
+
+    // ok
+    predecode->size     = size;
+    predecode->instrs   = instrs;
+    return predecode;
+}
+dx_code_switches_ref_t dx_code_switches(dx_code_ref_t code, dx_arena_ref_t arena)
+{
+    // check
+    dx_code_t* dexcode = (dx_code_t*)code;
+    tb_assert_and_check_return_val(dexcode && arena, tb_null);
+
+    // count the switch instructions by the widths of all instructions
+    tb_size_t size = 0;
+    if (!dx_code_instr_count(dexcode, tb_null, &size)) return tb_null;
+
+    // make the jump tables, they follow the switches
+    tb_size_t           switches_size = sizeof(dx_code_switches_t) + size * sizeof(dx_code_switch_t);
+    dx_code_switches_t* switches = (dx_code_switches_t*)dx_arena_malloc0(arena, switches_size);
+    tb_assert_and_check_return_val(switches, tb_null);
+
+    // compile all switch payloads
+    tb_size_t               i = 0;
+    dx_code_switch_t*       tables = (dx_code_switch_t*)(switches + 1);
+    dx_code_iter_t          iter;
+    dx_instruction_ref_t    instruction = tb_null;
+    dx_code_iter_init(&iter, code, DX_CODE_ITER_MODE_SKIP_PAYLOAD);
+    while (i < size && (instruction = dx_code_iter_next(&iter)))
+    {
+        // is switch?
+        tb_bool_t packed = instruction->opcode == DX_OPCODE_PACKED_SWITCH;
+        if (!packed && instruction->opcode != DX_OPCODE_SPARSE_SWITCH) continue;
+
+        // get the payload, it must be in the code
+        tb_size_t   pc = dx_code_iter_pc(&iter);
+        tb_hong_t   payload_pc = (tb_hong_t)pc + (tb_sint32_t)instruction->vB;
+        tb_check_break(payload_pc >= 0 && payload_pc < (tb_hong_t)dexcode->insns_size);
+
+        tb_uint16_t const* payload = dexcode->insns + (tb_size_t)payload_pc;
+        tb_check_break(payload[0] == (packed? DX_INSTR_IDENT_PACKED_SWITCH_PAYLOAD : DX_INSTR_IDENT_SPARSE_SWITCH_PAYLOAD));
+        tb_check_break(dx_code_instr_width(payload, dexcode->insns_size - (tb_size_t)payload_pc));
+
+        // make the jump table
+        dx_code_switch_t* table = &tables[i];
+        table->pc = (tb_uint32_t)pc;
+        if (!dx_code_switch_make(table, payload, packed, arena)) break;
+        i++;
+    }
+
+    // failed? the allocated slots will be freed with the arena
+    if (i < size)
+    {
+        dx_arena_free(arena, switches, switches_size);
+        return tb_null;
+    }
+
+    // ok
+    switches->size      = size;
+    switches->switches  = tables;
+    return switches;
+}
+dx_code_switch_ref_t dx_code_switch_find(dx_code_switches_ref_t switches, tb_size_t pc)
+{
+    // check
+    tb_assert_and_check_return_val(switches, tb_null);
+
+    // find it by the binary search
+    tb_size_t l = 0;
+    tb_size_t r = switches->size;
+    while (l < r)
+    {
+        tb_size_t m = (l + r) >> 1;
+        if (switches->switches[m].pc < pc) l = m + 1;
+        else r = m;
+    }
+    return (l < switches->size && switches->switches[l].pc == pc)? (dx_code_switch_ref_t)&switches->switches[l] : tb_null;
+}
+tb_long_t dx_code_switch_jump(dx_code_switch_ref_t table, tb_sint32_t value)
+{
+    // check
+    tb_assert_and_check_return_val(table, DX_CODE_SWITCH_MISSED);
+
+    // done
+    tb_long_t offset = DX_CODE_SWITCH_MISSED;
+    switch (table->mode)
+    {
+    case DX_CODE_SWITCH_MODE_DIRECT:
+        {
+            // the missed slots have been filled with the instruction size
+            tb_uint32_t index = (tb_uint32_t)value - (tb_uint32_t)table->first_key;
+            if (index < table->size) offset = table->targets[index];
+        }
+        break;
+    case DX_CODE_SWITCH_MODE_HASH:
+        {
+            tb_size_t slot = dx_code_switch_hash(value, table->mul, table->shift);
+            if (table->keys[slot] == value) offset = table->targets[slot];
+        }
+        break;
+    case DX_CODE_SWITCH_MODE_SEARCH:
+        {
+            // the branch-free binary search
+            tb_size_t index = 0;
+            tb_size_t n = table->size;
+            while (n > 1)
+            {
+                tb_size_t half = n >> 1;
+                index = table->keys[index + half] <= value? index + half : index;
+                n -= half;
+            }
+            if (table->keys[index] == value) offset = table->targets[index];
+        }
+        break;
+    default:
+        tb_assert(0);
+        break;
+    }
+    return offset;
+}
 #ifdef DX_DUMP_ENABLE
 tb_void_t dx_code_dump(dx_code_ref_t code, dx_file_ref_t file)
 {
@@ -147,25 +677,12 @@ tb_void_t dx_code_dump(dx_code_ref_t code, dx_file_ref_t file)
     tb_printf("        .prologue\n");
 
     // dump code
-    tb_size_t           instr_idx = 0;
-    tb_size_t           instr_size = dx_code_instr_size(code);
-    tb_uint16_t const*  instr_data = dx_code_instr_data(code);
-    while (instr_idx < instr_size)
+    dx_code_iter_t          iter;
+    dx_instruction_ref_t    instruction = tb_null;
+    if (dx_code_iter_init(&iter, code, DX_CODE_ITER_MODE_NONE))
     {
-        // get instruction width
-        tb_size_t instr_width = dx_instr_width(instr_data);
-        tb_assert(instr_width);
-
-        // decode instruction
-        dx_instruction_t instruction = {0};
-        if (!dx_instr_decode(instr_data, &instruction)) break ;
-
-        // dump instruction
-        dx_instr_dump(&instruction, instr_idx, file);
-
-        // the next instruction
-        instr_idx   += instr_width;
-        instr_data  += instr_width;
+        while ((instruction = dx_code_iter_next(&iter)))
+            dx_instr_dump(instruction, dx_code_iter_pc(&iter), file);
     }
 
     // dump end
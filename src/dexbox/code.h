@@ -25,12 +25,167 @@
  * includes
  */
 #include "file.h"
+#include "instr.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
 __tb_extern_c_enter__
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the code iterator mode
+typedef enum __dx_code_iter_mode_e
+{
+    DX_CODE_ITER_MODE_NONE          = 0         //!< report all instructions and payloads
+,   DX_CODE_ITER_MODE_SKIP_PAYLOAD  = 1         //!< skip the payloads of switch and fill-array-data
+
+}dx_code_iter_mode_e;
+
+/*! the code iterator type
+ *
+ * @code
+ *  dx_code_iter_t          iter;
+ *  dx_instruction_ref_t    instruction = tb_null;
+ *  dx_code_iter_init(&iter, code, DX_CODE_ITER_MODE_SKIP_PAYLOAD);
+ *  while ((instruction = dx_code_iter_next(&iter)))
+ *  {
+ *      tb_size_t pc = dx_code_iter_pc(&iter);
+ *      // ...
+ *  }
+ *  if (dx_code_iter_failed(&iter))
+ *  {
+ *      // the code is truncated or has the invalid instruction
+ *  }
+ * @endcode
+ */
+typedef struct __dx_code_iter_t
+{
+    // the instructions
+    tb_uint16_t const*      insns;
+
+    // the instruction size in the 16-bit code units
+    tb_size_t               insns_size;
+
+    // the pc of the current instruction
+    tb_size_t               pc;
+
+    // the width of the current instruction
+    tb_size_t               width;
+
+    // the mode
+    tb_uint16_t             mode;
+
+    // the payload ident of the current instruction, e.g. DX_INSTR_IDENT_PACKED_SWITCH_PAYLOAD, zero if it is not payload
+    tb_uint16_t             payload;
+
+    // has it been stopped by the truncated or invalid instruction?
+    tb_bool_t               failed;
+
+    // the current instruction, only the operands of its format are decoded
+    dx_instruction_t        instruction;
+
+}dx_code_iter_t, *dx_code_iter_ref_t;
+
+/// the switch jump table mode
+typedef enum __dx_code_switch_mode_e
+{
+    DX_CODE_SWITCH_MODE_DIRECT      = 0         //!< the direct table indexed by (value - first_key)
+,   DX_CODE_SWITCH_MODE_HASH        = 1         //!< the perfect hash table of the sparse keys
+,   DX_CODE_SWITCH_MODE_SEARCH      = 2         //!< the binary search over the sorted keys, if no perfect hash is found
+
+}dx_code_switch_mode_e;
+
+/// the precompiled switch jump table
+typedef struct __dx_code_switch_t
+{
+    /// the pc of the packed-switch or sparse-switch instruction
+    tb_uint32_t             pc;
+
+    /// the mode, e.g. DX_CODE_SWITCH_MODE_DIRECT
+    tb_uint16_t             mode;
+
+    /// the shift of the perfect hash: slot = (value * mul) >> shift
+    tb_uint16_t             shift;
+
+    /// the multiplier of the perfect hash
+    tb_uint32_t             mul;
+
+    /// the first key of the direct table
+    tb_sint32_t             first_key;
+
+    /// the slot count
+    tb_uint32_t             size;
+
+    /// the keys of the slots, they are not used by the direct table
+    tb_sint32_t const*      keys;
+
+    /// the branch targets relative to the switch instruction, the empty slots are the size of the switch instruction (3)
+    tb_sint32_t const*      targets;
+
+}dx_code_switch_t, *dx_code_switch_ref_t;
+
+/// the precompiled switch jump tables of the code
+typedef struct __dx_code_switches_t
+{
+    /// the switch count
+    tb_size_t               size;
+
+    /// the switches, they are sorted by pc
+    dx_code_switch_t const* switches;
+
+}dx_code_switches_t, *dx_code_switches_ref_t;
+
+/// the predecoded instruction, it is 32 bytes
+typedef struct __dx_code_instr_t
+{
+    /// the pc offset in the 16-bit code units
+    tb_uint32_t             pc;
+
+    /// the width in the 16-bit code units
+    tb_uint32_t             width;
+
+    /// vA/B/C, the 64-bit literal of 51l is split into vB (low) and vC (high)
+    tb_uint32_t             vA;
+    tb_uint32_t             vB;
+    tb_uint32_t             vC;
+
+    /// the argument registers of 35c/35ms/35mi, 4 bits per register: arg[i] = (args >> (i << 2)) & 0x0f
+    tb_uint32_t             args;
+
+    /*! the reference index of string@, type@, field@ and method@, it is zero if there is no index
+     *
+     * it is the jump table index for packed-switch and sparse-switch, e.g. dx_code_switches_t.switches[index]
+     */
+    tb_uint32_t             index;
+
+    /// the opcode
+    tb_uint8_t              opcode;
+
+    /// the format
+    tb_uint8_t              format;
+
+    /// the index type
+    tb_uint8_t              index_type;
+
+    /// the control flow flags, they are zero for the payload pseudo-instructions
+    tb_uint8_t              flags;
+
+}dx_code_instr_t, *dx_code_instr_ref_t;
+
+/// the predecoded code
+typedef struct __dx_code_predecode_t
+{
+    /// the instruction count
+    tb_size_t               size;
+
+    /// the instructions, they are sorted by pc
+    dx_code_instr_t const*  instrs;
+
+}dx_code_predecode_t, *dx_code_predecode_ref_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -91,6 +246,107 @@ tb_size_t               dx_code_instr_size(dx_code_ref_t code);
  */
 tb_uint16_t const*      dx_code_instr_data(dx_code_ref_t code);
 
+/*! init the code iterator
+ *
+ * @param iter          the code iterator
+ * @param code          the dex code 
+ * @param mode          the iterator mode, e.g. DX_CODE_ITER_MODE_SKIP_PAYLOAD
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               dx_code_iter_init(dx_code_iter_ref_t iter, dx_code_ref_t code, tb_size_t mode);
+
+/*! get the next instruction
+ *
+ * the width of the instruction is checked before decoding it, 
+ * so it will never read the code units beyond insns_size even if the code is truncated.
+ *
+ * @param iter          the code iterator
+ *
+ * @return              the instruction, tb_null if it is the end or the code is malformed
+ */
+dx_instruction_ref_t    dx_code_iter_next(dx_code_iter_ref_t iter);
+
+/*! get the pc of the current instruction
+ *
+ * @param iter          the code iterator
+ *
+ * @return              the pc in the 16-bit code units
+ */
+tb_size_t               dx_code_iter_pc(dx_code_iter_ref_t iter);
+
+/*! get the width of the current instruction, it is the whole width for the payload
+ *
+ * @param iter          the code iterator
+ *
+ * @return              the width in the 16-bit code units
+ */
+tb_size_t               dx_code_iter_width(dx_code_iter_ref_t iter);
+
+/*! get the payload ident of the current instruction
+ *
+ * @param iter          the code iterator
+ *
+ * @return              the payload ident, e.g. DX_INSTR_IDENT_SPARSE_SWITCH_PAYLOAD, zero if it is not payload
+ */
+tb_size_t               dx_code_iter_payload(dx_code_iter_ref_t iter);
+
+/*! has the iterator been stopped by the truncated or invalid instruction?
+ *
+ * @param iter          the code iterator
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               dx_code_iter_failed(dx_code_iter_ref_t iter);
+
+/*! predecode all instructions of the code into one dense array
+ *
+ * the code is decoded only once, so the analysis passes can iterate the flat array
+ * instead of parsing the 16-bit code units again.
+ * the payloads of switch and fill-array-data are kept as the nop records with their whole width.
+ *
+ * @param code          the dex code 
+ * @param arena         the arena, the predecoded code will be freed with it
+ *
+ * @return              the predecoded code, tb_null if the code is truncated or has the invalid instructions
+ */
+dx_code_predecode_ref_t dx_code_predecode(dx_code_ref_t code, dx_arena_ref_t arena);
+
+/*! precompile all switch payloads of the code into the jump tables
+ *
+ * the packed-switch and the dense sparse-switch are compiled to the direct tables,
+ * and the other small sparse-switch are compiled to the perfect hash tables, so the dispatch is O(1).
+ * the large sparse-switch without the perfect hash falls back to the branch-free binary search.
+ * the jump tables are in the same order as the switch instructions,
+ * so the predecoded switch instruction can index them directly.
+ *
+ * @param code          the dex code 
+ * @param arena         the arena, the jump tables will be freed with it
+ *
+ * @return              the jump tables, tb_null if the code or switch payload is malformed
+ */
+dx_code_switches_ref_t  dx_code_switches(dx_code_ref_t code, dx_arena_ref_t arena);
+
+/*! find the jump table of the switch instruction
+ *
+ * it is the binary search by pc, the predecoded switch instruction has the table index already.
+ *
+ * @param switches      the jump tables
+ * @param pc            the pc of the packed-switch or sparse-switch instruction
+ *
+ * @return              the jump table, tb_null if not found
+ */
+dx_code_switch_ref_t    dx_code_switch_find(dx_code_switches_ref_t switches, tb_size_t pc);
+
+/*! dispatch the switch value by the jump table
+ *
+ * @param table         the jump table
+ * @param value         the test value
+ *
+ * @return              the frame pc offset, failed: the instruction size(3)
+ */
+tb_long_t               dx_code_switch_jump(dx_code_switch_ref_t table, tb_sint32_t value);
+
 #ifdef DX_DUMP_ENABLE
 /*! dump code
  *
@@ -27,6 +27,7 @@
 #include "file.h"
 #include "code.h"
 #include "catch.h"
+#include "cfg.h"
 #include "instr.h"
 #include "class.h"
 #include "field.h"
@@ -36,6 +37,9 @@
 #include "method.h"
 #include "leb128.h"
 #include "descriptor.h"
+#include "adler32.h"
+#include "arena.h"
+#include "dexset.h"
 
 #endif
 
@@ -0,0 +1,585 @@
+/*!A lightweight dex file parsing library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2015-2020, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        dexset.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "dexset"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "dexbox.h"
+#include "impl/impl.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum depth of the super classes for resolving methods and fields
+#define DX_DEXSET_SUPER_MAXN            (256)
+
+// the maximum worker count for building the class index
+#define DX_DEXSET_WORKER_MAXN           (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the class index entry type
+typedef struct __dx_dexset_entry_t
+{
+    // the class descriptor hash code
+    tb_uint32_t                 hash;
+
+    // the file index + 1, zero if it is empty
+    tb_uint32_t                 file;
+
+    // the class_def index
+    tb_uint32_t                 class_idx;
+
+}dx_dexset_entry_t;
+
+// the merged class index type, it is a hash table with the linear probing
+typedef struct __dx_dexset_index_t
+{
+    // the entry mask, the entry count is always power of 2
+    tb_size_t                   mask;
+
+    // the entries
+    dx_dexset_entry_t           entries[1];
+
+}dx_dexset_index_t;
+
+// the dex set item type
+typedef struct __dx_dexset_item_t
+{
+    // the dex file
+    dx_file_t*                  dexfile;
+
+    // the resolved methods of all method references
+    dx_ptable_t                 methods;
+
+    // the resolved fields of all field references
+    dx_ptable_t                 fields;
+
+}dx_dexset_item_t;
+
+// the dex set type
+typedef struct __dx_dexset_t
+{
+    // the items
+    dx_dexset_item_t            items[DX_DEXSET_FILE_MAXN];
+
+    // the item count
+    tb_size_t                   size;
+
+    // the merged class index, it is built at once
+    dx_dexset_index_t*          index;
+
+}dx_dexset_t;
+
+// the worker type for building the class index
+typedef struct __dx_dexset_worker_t
+{
+    // the dex set
+    dx_dexset_t*                dexset;
+
+    // the next file index shared by all workers
+    tb_atomic_t*                next;
+
+    // the failed flag shared by all workers
+    tb_atomic_t*                failed;
+
+    // the class descriptor hash codes of all dex files, they are owned by the current build
+    tb_uint32_t**               hashes;
+
+}dx_dexset_worker_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_int_t dx_dexset_hash_worker(tb_cpointer_t priv)
+{
+    // check
+    dx_dexset_worker_t* worker = (dx_dexset_worker_t*)priv;
+    tb_assert_and_check_return_val(worker && worker->dexset && worker->next && worker->failed && worker->hashes, -1);
+
+    // hash the class descriptors file by file
+    dx_dexset_t* dexset = worker->dexset;
+    while (!tb_atomic_get(worker->failed))
+    {
+        // get the next file
+        tb_size_t file_idx = (tb_size_t)tb_atomic_fetch_and_add(worker->next, 1);
+        tb_check_break(file_idx < dexset->size);
+
+        // make hash codes
+        dx_file_t*      dexfile = dexset->items[file_idx].dexfile;
+        tb_size_t       class_idx = 0;
+        tb_size_t       class_size = dexfile->header->class_defs_size;
+        tb_uint32_t*    hashes = tb_nalloc_type(class_size? class_size : 1, tb_uint32_t);
+        worker->hashes[file_idx] = hashes;
+        for (class_idx = 0; hashes && class_idx < class_size; class_idx++)
+        {
+            dx_class_def_ref_t  class_def = dx_file_get_class_def(dexfile, class_idx);
+            tb_char_t const*    descriptor = class_def? dx_file_get_string_by_type_idx(dexfile, class_def->class_idx) : tb_null;
+            tb_check_break(descriptor);
+            hashes[class_idx] = dx_file_class_descriptor_hash(descriptor);
+        }
+
+        // failed? all workers will be stopped
+        if (!hashes || class_idx < class_size) 
+        {
+            tb_atomic_set(worker->failed, 1);
+            break;
+        }
+    }
+
+    // ok
+    return 0;
+}
+static tb_char_t const* dx_dexset_entry_descriptor(dx_dexset_t* dexset, dx_dexset_entry_t const* entry)
+{
+    dx_file_t* dexfile = dexset->items[entry->file - 1].dexfile;
+    return dx_file_get_string_by_type_idx(dexfile, dx_file_get_class_def(dexfile, entry->class_idx)->class_idx);
+}
+static dx_dexset_index_t* dx_dexset_index_make(dx_dexset_t* dexset, tb_uint32_t** hashes)
+{
+    // the entry count, it must be power of 2 and we need keep the load factor <= 0.5
+    tb_size_t file_idx = 0;
+    tb_size_t class_total = 0;
+    for (file_idx = 0; file_idx < dexset->size; file_idx++)
+        class_total += dexset->items[file_idx].dexfile->header->class_defs_size;
+    tb_size_t num_entries = 1;
+    while (num_entries < (class_total << 1)) num_entries <<= 1;
+
+    // make the index
+    dx_dexset_index_t* index = (dx_dexset_index_t*)tb_malloc0(sizeof(dx_dexset_index_t) + (num_entries - 1) * sizeof(dx_dexset_entry_t));
+    tb_assert_and_check_return_val(index, tb_null);
+    index->mask = num_entries - 1;
+
+    // insert all classes in the file order, the former class will be kept if there are the same classes
+    tb_size_t class_idx = 0;
+    tb_size_t class_size = 0;
+    tb_size_t mask = index->mask;
+    for (file_idx = 0; file_idx < dexset->size; file_idx++)
+    {
+        dx_dexset_item_t* item = &dexset->items[file_idx];
+        class_size = item->dexfile->header->class_defs_size;
+        for (class_idx = 0; class_idx < class_size; class_idx++)
+        {
+            // find a free entry
+            tb_uint32_t         hash = hashes[file_idx][class_idx];
+            tb_size_t           idx = hash & mask;
+            tb_char_t const*    descriptor = tb_null;
+            while (index->entries[idx].file)
+            {
+                // the same class has been inserted?
+                if (index->entries[idx].hash == hash)
+                {
+                    if (!descriptor) descriptor = dx_file_get_string_by_type_idx(item->dexfile, dx_file_get_class_def(item->dexfile, class_idx)->class_idx);
+                    tb_char_t const* entry_descriptor = dx_dexset_entry_descriptor(dexset, &index->entries[idx]);
+                    if (descriptor && entry_descriptor && !tb_strcmp(entry_descriptor, descriptor)) break;
+                }
+                idx = (idx + 1) & mask;
+            }
+
+            // save it
+            if (!index->entries[idx].file)
+            {
+                index->entries[idx].hash        = hash;
+                index->entries[idx].file        = (tb_uint32_t)(file_idx + 1);
+                index->entries[idx].class_idx   = (tb_uint32_t)class_idx;
+            }
+        }
+    }
+
+    // trace
+    tb_trace_d("make class index: %lu files, %lu classes, %lu entries", dexset->size, class_total, num_entries);
+
+    // ok
+    return index;
+}
+static dx_dexset_index_t* dx_dexset_index(dx_dexset_t* dexset)
+{
+    // get the class index, build it on the current thread if it has been not built
+    dx_dexset_index_t* index = (dx_dexset_index_t*)dx_pointer_get((tb_pointer_t const*)&dexset->index);
+    if (!index && dx_dexset_build((dx_dexset_ref_t)dexset, 1))
+        index = (dx_dexset_index_t*)dx_pointer_get((tb_pointer_t const*)&dexset->index);
+    return index;
+}
+static dx_dexset_entry_t const* dx_dexset_index_find(dx_dexset_t* dexset, tb_char_t const* descriptor)
+{
+    // get the class index
+    dx_dexset_index_t* index = dx_dexset_index(dexset);
+    tb_assert_and_check_return_val(index, tb_null);
+
+    // find it with the linear probing
+    tb_uint32_t hash = dx_file_class_descriptor_hash(descriptor);
+    tb_size_t   idx = hash & index->mask;
+    while (index->entries[idx].file)
+    {
+        dx_dexset_entry_t const* entry = &index->entries[idx];
+        if (entry->hash == hash && !tb_strcmp(dx_dexset_entry_descriptor(dexset, entry), descriptor)) return entry;
+        idx = (idx + 1) & index->mask;
+    }
+
+    // not found
+    return tb_null;
+}
+static tb_bool_t dx_dexset_index_owned(dx_dexset_t* dexset, tb_char_t const* descriptor, dx_file_ref_t file)
+{
+    // the class of this descriptor is defined in the given dex file and it wins in the merged class index?
+    dx_dexset_entry_t const* entry = dx_dexset_index_find(dexset, descriptor);
+    return entry && dexset->items[entry->file - 1].dexfile == (dx_file_t*)file;
+}
+static dx_dexset_item_t* dx_dexset_item(dx_dexset_t* dexset, dx_file_ref_t file)
+{
+    // find the item of this dex file, there are only a few dex files
+    tb_size_t i = 0;
+    for (i = 0; i < dexset->size; i++)
+    {
+        if (dexset->items[i].dexfile == (dx_file_t*)file) return &dexset->items[i];
+    }
+    return tb_null;
+}
+static tb_pointer_t dx_dexset_member_resolve(dx_dexset_t* dexset, tb_char_t const* class_descriptor, tb_char_t const* name, tb_char_t const* descriptor, tb_bool_t is_method)
+{
+    // find the member in the class and its super classes
+    tb_size_t depth = 0;
+    for (depth = 0; depth < DX_DEXSET_SUPER_MAXN && class_descriptor; depth++)
+    {
+        // find the defining dex file of this class
+        dx_dexset_entry_t const* entry = dx_dexset_index_find(dexset, class_descriptor);
+        tb_check_break(entry);
+
+        // find this member in the defining dex file, it may be only a reference to the member of the super class
+        dx_file_t*      dexfile = dexset->items[entry->file - 1].dexfile;
+        tb_pointer_t    member = tb_null;
+        if (is_method)
+        {
+            tb_long_t method_idx = dx_file_method_find((dx_file_ref_t)dexfile, class_descriptor, name, descriptor);
+            if (method_idx >= 0) member = (tb_pointer_t)dx_file_method((dx_file_ref_t)dexfile, (tb_size_t)method_idx);
+        }
+        else 
+        {
+            tb_long_t field_idx = dx_file_field_find((dx_file_ref_t)dexfile, class_descriptor, name, descriptor);
+            if (field_idx >= 0) member = (tb_pointer_t)dx_file_field((dx_file_ref_t)dexfile, (tb_size_t)field_idx);
+        }
+        if (member) return member;
+
+        // find it in the super class
+        dx_class_def_ref_t class_def = dx_file_get_class_def(dexfile, entry->class_idx);
+        class_descriptor = class_def->superclass_idx != 0xffffffff? dx_file_get_string_by_type_idx(dexfile, class_def->superclass_idx) : tb_null;
+    }
+
+    // not found
+    return tb_null;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+dx_dexset_ref_t dx_dexset_init()
+{
+    // make dex set
+    dx_dexset_t* dexset = tb_malloc0_type(dx_dexset_t);
+    tb_assert_and_check_return_val(dexset, tb_null);
+
+    // ok
+    return (dx_dexset_ref_t)dexset;
+}
+dx_dexset_ref_t dx_dexset_load_from_zip(tb_char_t const* url, tb_size_t checksum)
+{
+    // check
+    tb_assert_and_check_return_val(url, tb_null);
+
+    // init zip archive
+    dx_zip_t zip;
+    if (!dx_zip_init(&zip, url)) return tb_null;
+
+    // done
+    tb_bool_t       ok = tb_false;
+    dx_dexset_ref_t dexset = tb_null;
+    do
+    {
+        // init dex set
+        dexset = dx_dexset_init();
+        tb_assert_and_check_break(dexset);
+
+        // load classes.dex, classes2.dex, ... until the entry does not exist
+        tb_size_t       i = 0;
+        tb_bool_t       failed = tb_false;
+        tb_char_t       name[64];
+        dx_zip_entry_t  entry;
+        for (i = 1; i <= DX_DEXSET_FILE_MAXN && !failed; i++)
+        {
+            // the entry name
+            if (i == 1) tb_strlcpy(name, "classes.dex", sizeof(name));
+            else tb_snprintf(name, sizeof(name), "classes%lu.dex", i);
+            tb_check_break(dx_zip_find(&zip, name, &entry));
+
+            // load it from the found entry
+            dx_file_ref_t dexfile = dx_zip_load_entry(&zip, &entry, checksum);
+            if (!dexfile || dx_dexset_add(dexset, dexfile) < 0)
+            {
+                if (dexfile) dx_file_exit(dexfile);
+                failed = tb_true;
+            }
+        }
+
+        // all dex files have been loaded?
+        tb_check_break(!failed && dx_dexset_size(dexset));
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // exit zip archive, the entry data has been mapped or copied
+    dx_zip_exit(&zip);
+
+    // failed?
+    if (!ok)
+    {
+        if (dexset) dx_dexset_exit(dexset);
+        dexset = tb_null;
+    }
+
+    // ok?
+    return dexset;
+}
+tb_void_t dx_dexset_exit(dx_dexset_ref_t set)
+{
+    // check
+    dx_dexset_t* dexset = (dx_dexset_t*)set;
+    tb_assert_and_check_return(dexset);
+
+    // exit all dex files
+    tb_size_t i = 0;
+    for (i = 0; i < dexset->size; i++)
+    {
+        dx_dexset_item_t* item = &dexset->items[i];
+        dx_ptable_exit(&item->methods);
+        dx_ptable_exit(&item->fields);
+        if (item->dexfile) dx_file_exit((dx_file_ref_t)item->dexfile);
+        item->dexfile = tb_null;
+    }
+    dexset->size = 0;
+
+    // exit the class index
+    if (dexset->index) tb_free(dexset->index);
+    dexset->index = tb_null;
+
+    // exit it
+    tb_free(dexset);
+}
+tb_long_t dx_dexset_add(dx_dexset_ref_t set, dx_file_ref_t file)
+{
+    // check
+    dx_dexset_t*    dexset = (dx_dexset_t*)set;
+    dx_file_t*      dexfile = (dx_file_t*)file;
+    tb_assert_and_check_return_val(dexset && dexfile && dexfile->header, -1);
+
+    // the class index has been built? we cannot add it
+    tb_assert_and_check_return_val(!dx_pointer_get((tb_pointer_t const*)&dexset->index), -1);
+
+    // full?
+    tb_check_return_val(dexset->size < DX_DEXSET_FILE_MAXN, -1);
+
+    // this dex file has been added?
+    tb_assert_and_check_return_val(!dx_dexset_item(dexset, file), -1);
+
+    // init the resolved methods and fields
+    dx_dexset_item_t* item = &dexset->items[dexset->size];
+    if (!dx_ptable_init(&item->methods, dexfile->header->method_ids_size)) return -1;
+    if (!dx_ptable_init(&item->fields, dexfile->header->field_ids_size)) 
+    {
+        dx_ptable_exit(&item->methods);
+        return -1;
+    }
+
+    // add it
+    item->dexfile = dexfile;
+    return (tb_long_t)dexset->size++;
+}
+tb_size_t dx_dexset_size(dx_dexset_ref_t set)
+{
+    // check
+    dx_dexset_t* dexset = (dx_dexset_t*)set;
+    tb_assert_and_check_return_val(dexset, 0);
+
+    // get it
+    return dexset->size;
+}
+dx_file_ref_t dx_dexset_file(dx_dexset_ref_t set, tb_size_t file_idx)
+{
+    // check
+    dx_dexset_t* dexset = (dx_dexset_t*)set;
+    tb_assert_and_check_return_val(dexset && file_idx < dexset->size, tb_null);
+
+    // get it
+    return (dx_file_ref_t)dexset->items[file_idx].dexfile;
+}
+tb_bool_t dx_dexset_build(dx_dexset_ref_t set, tb_size_t nthreads)
+{
+    // check
+    dx_dexset_t* dexset = (dx_dexset_t*)set;
+    tb_assert_and_check_return_val(dexset, tb_false);
+
+    // has been built?
+    tb_check_return_val(!dx_pointer_get((tb_pointer_t const*)&dexset->index), tb_true);
+
+    // get the worker count, one file for each worker at least
+    if (!nthreads) nthreads = tb_processor_count();
+    nthreads = tb_min(nthreads, dexset->size);
+    nthreads = tb_min(nthreads, DX_DEXSET_WORKER_MAXN);
+    if (!nthreads) nthreads = 1;
+
+    /* hash the class descriptors of all dex files, the first worker runs in the current thread
+     *
+     * the hash codes are owned by this build, so multiple threads can build it at the same time 
+     * and only the first published index will be kept.
+     */
+    tb_size_t           i = 0;
+    tb_atomic_t         next = 0;
+    tb_atomic_t         failed = 0;
+    tb_uint32_t*        hashes[DX_DEXSET_FILE_MAXN] = {0};
+    dx_dexset_worker_t  worker = {dexset, &next, &failed, hashes};
+    tb_thread_ref_t     threads[DX_DEXSET_WORKER_MAXN] = {0};
+    for (i = 1; i < nthreads; i++)
+        threads[i] = tb_thread_init(tb_null, dx_dexset_hash_worker, &worker, 0);
+    dx_dexset_hash_worker(&worker);
+    for (i = 1; i < nthreads; i++)
+    {
+        if (threads[i])
+        {
+            tb_thread_wait(threads[i], -1, tb_null);
+            tb_thread_exit(threads[i]);
+        }
+    }
+
+    // merge them to the class index, we cannot publish the partial index if some dex files have been not hashed
+    dx_dexset_index_t* index = tb_atomic_get(&failed)? tb_null : dx_dexset_index_make(dexset, hashes);
+
+    // exit the hash codes
+    for (i = 0; i < dexset->size; i++)
+    {
+        if (hashes[i]) tb_free(hashes[i]);
+    }
+    tb_check_return_val(index, tb_false);
+
+    // publish it, another thread may have published its index
+    if (dx_pointer_publish((tb_pointer_t*)&dexset->index, index) != index) tb_free(index);
+
+    // ok
+    return tb_true;
+}
+dx_class_ref_t dx_dexset_class_find(dx_dexset_ref_t set, tb_char_t const* descriptor)
+{
+    // check
+    dx_dexset_t* dexset = (dx_dexset_t*)set;
+    tb_assert_and_check_return_val(dexset && descriptor, tb_null);
+
+    // find the defining dex file of this class
+    dx_dexset_entry_t const* entry = dx_dexset_index_find(dexset, descriptor);
+    tb_check_return_val(entry, tb_null);
+
+    // get class
+    return dx_file_class((dx_file_ref_t)dexset->items[entry->file - 1].dexfile, entry->class_idx);
+}
+dx_class_ref_t dx_dexset_class_from_type(dx_dexset_ref_t set, dx_file_ref_t file, tb_size_t type_idx)
+{
+    // check
+    dx_dexset_t* dexset = (dx_dexset_t*)set;
+    tb_assert_and_check_return_val(dexset && file, tb_null);
+
+    /* find it in all dex files by the merged class index, 
+     * the first defining dex file wins even if this class is also defined in the same dex file
+     */
+    tb_char_t const* descriptor = dx_file_type(file, type_idx);
+    return descriptor? dx_dexset_class_find(set, descriptor) : tb_null;
+}
+dx_method_ref_t dx_dexset_method(dx_dexset_ref_t set, dx_file_ref_t file, tb_size_t method_idx)
+{
+    // check
+    dx_dexset_t*        dexset = (dx_dexset_t*)set;
+    dx_dexset_item_t*   item = dexset? dx_dexset_item(dexset, file) : tb_null;
+    tb_assert_and_check_return_val(item && method_idx < item->methods.size, tb_null);
+
+    // this method has been resolved? 
+    dx_method_ref_t method = (dx_method_ref_t)dx_ptable_get(&item->methods, method_idx);
+    tb_check_return_val(!method, method);
+
+    // the class is defined in the same dex file and it wins in the merged class index? 
+    tb_char_t const* class_descriptor = dx_file_method_class_descriptor(file, method_idx);
+    tb_check_return_val(class_descriptor, tb_null);
+    if (dx_dexset_index_owned(dexset, class_descriptor, file)) method = dx_file_method(file, method_idx);
+    if (!method)
+    {
+        // find it in all dex files
+        tb_string_t descriptor;
+        tb_string_init(&descriptor);
+        if (dx_file_method_descriptor(file, method_idx, &descriptor))
+        {
+            tb_char_t const* name = dx_file_method_name(file, method_idx);
+            method = (dx_method_ref_t)dx_dexset_member_resolve(dexset, class_descriptor, name, tb_string_cstr(&descriptor), tb_true);
+        }
+        tb_string_exit(&descriptor);
+    }
+    tb_check_return_val(method, tb_null);
+
+    // the class of this method may be evicted? it is pinned for the caller and we cannot cache it
+    if (((dx_method_t*)method)->dexfile->cache_stat.maxn) return method;
+
+    // cache it
+    return (dx_method_ref_t)dx_ptable_publish(&item->methods, method_idx, (tb_pointer_t)method);
+}
+dx_field_ref_t dx_dexset_field(dx_dexset_ref_t set, dx_file_ref_t file, tb_size_t field_idx)
+{
+    // check
+    dx_dexset_t*        dexset = (dx_dexset_t*)set;
+    dx_dexset_item_t*   item = dexset? dx_dexset_item(dexset, file) : tb_null;
+    tb_assert_and_check_return_val(item && field_idx < item->fields.size, tb_null);
+
+    // this field has been resolved? 
+    dx_field_ref_t field = (dx_field_ref_t)dx_ptable_get(&item->fields, field_idx);
+    tb_check_return_val(!field, field);
+
+    // the class is defined in the same dex file and it wins in the merged class index? 
+    tb_char_t const* class_descriptor = dx_file_field_class_descriptor(file, field_idx);
+    tb_check_return_val(class_descriptor, tb_null);
+    if (dx_dexset_index_owned(dexset, class_descriptor, file)) field = dx_file_field(file, field_idx);
+    if (!field)
+    {
+        // find it in all dex files
+        tb_char_t const* name = dx_file_field_name(file, field_idx);
+        field = (dx_field_ref_t)dx_dexset_member_resolve(dexset, class_descriptor, name, dx_file_field_descriptor(file, field_idx), tb_false);
+    }
+    tb_check_return_val(field, tb_null);
+
+    // the class of this field may be evicted? it is pinned for the caller and we cannot cache it
+    if (((dx_field_t*)field)->dexfile->cache_stat.maxn) return field;
+
+    // cache it
+    return (dx_field_ref_t)dx_ptable_publish(&item->fields, field_idx, (tb_pointer_t)field);
+}
@@ -0,0 +1,179 @@
+/*!A lightweight dex file parsing library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2015-2020, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        dexset.h
+ *
+ */
+#ifndef DX_DEXSET_H
+#define DX_DEXSET_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the maximum dex file count of the dex set
+#define DX_DEXSET_FILE_MAXN             (256)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the dex set
+ *
+ * the dex set holds multiple dex files of one application, e.g. classes.dex, classes2.dex, ..., 
+ * and resolves the class, method and field references across these dex files.
+ *
+ * @return              the dex set
+ */
+dx_dexset_ref_t         dx_dexset_init(tb_noarg_t);
+
+/*! load all dex files from the zip archive, e.g. apk
+ *
+ * it loads classes.dex, classes2.dex, ..., classesN.dex in order, see dx_file_load_from_zip().
+ *
+ * @param url           the archive url
+ * @param checksum      the checksum mode, e.g. DX_FILE_CHECKSUM_SYNC
+ *
+ * @return              the dex set, tb_null if there is no dex file or some dex files are broken
+ */
+dx_dexset_ref_t         dx_dexset_load_from_zip(tb_char_t const* url, tb_size_t checksum);
+
+/*! exit the dex set and all dex files
+ *
+ * @param dexset        the dex set
+ */
+tb_void_t               dx_dexset_exit(dx_dexset_ref_t dexset);
+
+/*! add the dex file to the dex set
+ *
+ * the dex file will be exited with the dex set if it is added successfully. 
+ * if there are classes with the same descriptor, the class in the former dex file will be used.
+ *
+ * @note all dex files must be added before building the class index, 
+ * and they should not set the memory budget of the class cache because the resolved members are cached.
+ *
+ * @param dexset        the dex set
+ * @param file          the dex file
+ *
+ * @return              the file index, -1 if failed
+ */
+tb_long_t               dx_dexset_add(dx_dexset_ref_t dexset, dx_file_ref_t file);
+
+/*! get the dex file count
+ *
+ * @param dexset        the dex set
+ *
+ * @return              the dex file count
+ */
+tb_size_t               dx_dexset_size(dx_dexset_ref_t dexset);
+
+/*! get the dex file with the given index
+ *
+ * @param dexset        the dex set
+ * @param file_idx      the file index
+ *
+ * @return              the dex file
+ */
+dx_file_ref_t           dx_dexset_file(dx_dexset_ref_t dexset, tb_size_t file_idx);
+
+/*! build the merged class index of all dex files
+ *
+ * the class descriptors of all dex files are hashed by the worker pool, and merged into one hash table.
+ * it will be built on the current thread when resolving at the first time if it has been not built.
+ * it is safe to build it on multiple threads at the same time, only the first built index will be kept.
+ *
+ * @param dexset        the dex set
+ * @param nthreads      the worker count, uses the processor count if be zero
+ *
+ * @return              tb_true or tb_false, nothing will be published if the class descriptors of some dex files cannot be hashed
+ */
+tb_bool_t               dx_dexset_build(dx_dexset_ref_t dexset, tb_size_t nthreads);
+
+/*! find class with the given descriptor in all dex files
+ *
+ * @param dexset        the dex set
+ * @param descriptor    the class descriptor, e.g. "Ljava/lang/Object;"
+ *
+ * @return              the dex class, we can get its dex file by dx_class_dexfile(), 
+ *                      it must be released by dx_file_class_release() if this dex file has the memory budget
+ */
+dx_class_ref_t          dx_dexset_class_find(dx_dexset_ref_t dexset, tb_char_t const* descriptor);
+
+/*! resolve the type reference of the given dex file to the defining class
+ *
+ * it is resolved by the merged class index like dx_dexset_class_find(), 
+ * so the first defining dex file wins even if the class is also defined in the given dex file.
+ *
+ * @param dexset        the dex set
+ * @param file          the dex file of the type reference
+ * @param type_idx      the type index in this dex file
+ *
+ * @return              the dex class, it may be defined in another dex file, 
+ *                      it must be released by dx_file_class_release() if the defining dex file has the memory budget
+ */
+dx_class_ref_t          dx_dexset_class_from_type(dx_dexset_ref_t dexset, dx_file_ref_t file, tb_size_t type_idx);
+
+/*! resolve the method reference of the given dex file to the defining method
+ *
+ * the method will be searched in the class and its super classes, 
+ * and the resolved method is cached for the next resolving.
+ * but it is not cached if the defining dex file has the memory budget, 
+ * because its class may be evicted, and it must be released by dx_file_method_release() with dx_method_dexfile().
+ * the classes are found by the merged class index, so the first defining dex file wins.
+ *
+ * @param dexset        the dex set
+ * @param file          the dex file of the method reference
+ * @param method_idx    the method index in this dex file
+ *
+ * @return              the dex method, it may be defined in another dex file
+ */
+dx_method_ref_t         dx_dexset_method(dx_dexset_ref_t dexset, dx_file_ref_t file, tb_size_t method_idx);
+
+/*! resolve the field reference of the given dex file to the defining field
+ *
+ * the field will be searched in the class and its super classes, 
+ * and the resolved field is cached for the next resolving.
+ * but it is not cached if the defining dex file has the memory budget, 
+ * because its class may be evicted, and it must be released by dx_file_field_release() with dx_field_dexfile().
+ * the classes are found by the merged class index, so the first defining dex file wins.
+ *
+ * @param dexset        the dex set
+ * @param file          the dex file of the field reference
+ * @param field_idx     the field index in this dex file
+ *
+ * @return              the dex field, it may be defined in another dex file
+ */
+dx_field_ref_t          dx_dexset_field(dx_dexset_ref_t dexset, dx_file_ref_t file, tb_size_t field_idx);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
+
@@ -69,6 +69,15 @@ tb_size_t dx_field_access(dx_field_ref_t field)
     // get the field name
     return dexfield->access_flags;
 }
+dx_file_ref_t dx_field_dexfile(dx_field_ref_t field)
+{
+    // check
+    dx_field_t* dexfield = (dx_field_t*)field;
+    tb_assert_and_check_return_val(dexfield, tb_null);
+
+    // get it
+    return (dx_file_ref_t)dexfield->dexfile;
+}
 dx_value_ref_t dx_field_value(dx_field_ref_t field)
 {
     // check
@@ -60,6 +60,14 @@ tb_char_t const*        dx_field_descriptor(dx_field_ref_t field);
  */
 tb_size_t               dx_field_access(dx_field_ref_t field);
 
+/*! get the dex file
+ *
+ * @param field         the dex field 
+ *
+ * @return              the dex file
+ */
+dx_file_ref_t           dx_field_dexfile(dx_field_ref_t field);
+
 /*! get the field value
  *
  * @param field         the dex field 
@@ -31,6 +31,131 @@
 #include "dexbox.h"
 #include "impl/impl.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the minimum dex size for verifying checksum on the background thread, the small file will be verified directly
+#define DX_FILE_VERIFY_ASYNC_MINN       (256 * 1024)
+
+// the class batch size of each worker for loading all classes
+#define DX_FILE_LOAD_BATCH              (64)
+
+// the maximum item count of the map_list for probing, there are only about twenty item types
+#define DX_FILE_PROBE_MAP_MAXN          (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the worker type for loading all classes
+typedef struct __dx_file_load_worker_t
+{
+    // the dex file
+    dx_file_ref_t           file;
+
+    // the next class index shared by all workers
+    tb_atomic_t*            next;
+
+    // the statistics
+    dx_file_load_stat_t     stat;
+
+}dx_file_load_worker_t;
+
+// the loaded result of the batch
+typedef struct __dx_file_batch_item_t
+{
+    // the url index
+    tb_size_t               index;
+
+    // the loaded dex file
+    dx_file_ref_t           file;
+
+}dx_file_batch_item_t;
+
+// the read data of the batch
+typedef struct __dx_file_batch_read_t
+{
+    // the url index, -1 if no more data
+    tb_size_t               index;
+
+    // the file data, tb_null if failed
+    tb_byte_t*              data;
+
+    // the file size
+    tb_size_t               size;
+
+}dx_file_batch_read_t;
+
+// the batch loader shared by all workers
+typedef struct __dx_file_batch_t
+{
+    // the urls
+    tb_char_t const**       urls;
+
+    // the url count
+    tb_size_t               size;
+
+    // the checksum mode
+    tb_size_t               checksum;
+
+    // the next url index
+    tb_atomic_t             next;
+
+    // stop it?
+    tb_atomic_t             stop;
+
+    // the free slots of the ready queue for the backpressure
+    tb_semaphore_ref_t      slots;
+
+    // the ready count of the ready queue
+    tb_semaphore_ref_t      ready;
+
+    // the lock of the ready queue
+    tb_spinlock_t           lock;
+
+    /* the ready queue, the results in it will never be more than the slots because each of them holds one slot,
+     * and it has one more entry to distinguish the full queue from the empty queue
+     */
+    dx_file_batch_item_t*   items;
+    tb_size_t               head;
+    tb_size_t               tail;
+    tb_size_t               maxn;
+
+    // the io_uring reader, the workers will only parse the data read by it if it is not null
+    dx_uring_ref_t          uring;
+
+    // the local file paths for the io_uring reader
+    tb_char_t const**       paths;
+
+    // the worker count
+    tb_size_t               nthreads;
+
+    // the read count of the read queue
+    tb_semaphore_ref_t      reads;
+
+    // the read queue, it has nthreads more entries for the end markers and one more entry for distinguishing the full queue
+    dx_file_batch_read_t*   rqueue;
+    tb_size_t               rhead;
+    tb_size_t               rtail;
+    tb_size_t               rmaxn;
+
+}dx_file_batch_t;
+
+// the reader type for probing the dex file
+typedef tb_bool_t       (*dx_file_probe_read_t)(tb_cpointer_t priv, tb_hize_t offset, tb_byte_t* data, tb_size_t size);
+
+// the data type for probing the dex file from the data
+typedef struct __dx_file_probe_data_t
+{
+    // the data
+    tb_byte_t const*        data;
+
+    // the size
+    tb_size_t               size;
+
+}dx_file_probe_data_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation 
  */
@@ -65,8 +190,8 @@ static tb_bool_t dx_file_check_adler(dx_header_ref_t header)
     // the skip bytes
     tb_size_t skip = sizeof(header->magic) + sizeof(header->checksum);
 
-    // calculate the checksum
-    tb_uint32_t checksum = tb_adler32_make((tb_byte_t const*)header + skip, header->file_size - skip, tb_adler32_make(tb_null, 0, 0));
+    // calculate the checksum, it will be split to chunks and computed on multiple threads for the large file
+    tb_uint32_t checksum = dx_adler32_make_parallel((tb_byte_t const*)header + skip, header->file_size - skip, 1, 0);
     if (checksum != header->checksum)
     {
         // trace
@@ -81,11 +206,30 @@ static tb_bool_t dx_file_opt_check_ptr(tb_cpointer_t p, tb_cpointer_t b, tb_cpoi
 {
     return (p >= b) && (p < e) && (!(((tb_size_t)p) & 7));
 }
-static tb_bool_t dx_file_opt_check_adler(dx_header_opt_ref_t header)
+static tb_bool_t dx_file_opt_check_range(dx_header_opt_ref_t header, tb_size_t size)
 {
     // check
     tb_assert_and_check_return_val(header, tb_false);
 
+    // the dex data, the dependencies and the optimized data must be in this file
+    tb_hize_t opt_end = (tb_hize_t)header->opt_offset + header->opt_length;
+    return  header->dex_offset <= size
+        &&  header->deps_offset <= opt_end
+        &&  opt_end <= size;
+}
+static tb_bool_t dx_file_opt_check_adler(dx_header_opt_ref_t header, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(header, tb_false);
+
+    // check the range before computing the data
+    if (!dx_file_opt_check_range(header, size))
+    {
+        // trace
+        tb_trace_e("invalid range of the optimized data!");
+        return tb_false;
+    }
+
     // the start data
     tb_byte_t const* start = (tb_byte_t const*)header + header->deps_offset;
 
@@ -93,7 +237,7 @@ static tb_bool_t dx_file_opt_check_adler(dx_header_opt_ref_t header)
     tb_byte_t const* end = (tb_byte_t const*)header + header->opt_offset + header->opt_length;
 
     // calculate the checksum
-    tb_uint32_t checksum = tb_adler32_make(tb_adler32_make(0, tb_null, 0), start, end - start);
+    tb_uint32_t checksum = dx_adler32_make_parallel(start, end - start, 1, 0);
     if (checksum != header->checksum)
     {
         // trace
@@ -104,6 +248,306 @@ static tb_bool_t dx_file_opt_check_adler(dx_header_opt_ref_t header)
     // ok?
     return tb_true;
 }
+static tb_int_t dx_file_verify_worker(tb_cpointer_t priv)
+{
+    // check
+    dx_file_t* dexfile = (dx_file_t*)priv;
+    tb_assert_and_check_return_val(dexfile && dexfile->header, -1);
+
+    // verify the optimized dex data and the dex data
+    tb_bool_t ok = tb_true;
+    dx_header_opt_ref_t header_opt = dexfile->header_opt;
+    if (header_opt && !dx_file_opt_check_adler(header_opt, (tb_size_t)header_opt->opt_offset + header_opt->opt_length)) ok = tb_false;
+    if (ok && !dx_file_check_adler(dexfile->header)) ok = tb_false;
+
+    // save the verify state, the dex file will be poisoned if failed
+    tb_atomic_set(&dexfile->verify_state, ok? DX_FILE_VERIFY_OK : DX_FILE_VERIFY_FAILED);
+
+    // notify the waiters
+    if (dexfile->verify_done) tb_semaphore_post(dexfile->verify_done, 1);
+
+    // trace
+    tb_trace_d("verify: %s", ok? "ok" : "failed");
+    return ok? 0 : -1;
+}
+static tb_bool_t dx_file_verify_start(dx_file_t* dexfile)
+{
+    // check
+    tb_assert_and_check_return_val(dexfile, tb_false);
+
+    // init semaphore
+    dexfile->verify_done = tb_semaphore_init(0);
+    tb_check_return_val(dexfile->verify_done, tb_false);
+
+    // start the background thread
+    tb_atomic_set(&dexfile->verify_state, DX_FILE_VERIFY_PENDING);
+    dexfile->verify_thread = tb_thread_init(tb_null, dx_file_verify_worker, dexfile, 0);
+    if (!dexfile->verify_thread)
+    {
+        tb_semaphore_exit(dexfile->verify_done);
+        dexfile->verify_done = tb_null;
+        tb_atomic_set(&dexfile->verify_state, DX_FILE_VERIFY_NONE);
+        return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_int_t dx_file_load_worker(tb_cpointer_t priv)
+{
+    // check
+    dx_file_load_worker_t* worker = (dx_file_load_worker_t*)priv;
+    tb_assert_and_check_return_val(worker && worker->file && worker->next, -1);
+
+    // load classes batch by batch
+    tb_hong_t   time = tb_uclock();
+    tb_size_t   class_size = dx_file_class_size(worker->file);
+    while (1)
+    {
+        // get the next batch
+        tb_size_t class_idx = (tb_size_t)tb_atomic_fetch_and_add(worker->next, DX_FILE_LOAD_BATCH);
+        tb_check_break(class_idx < class_size);
+
+        // load them
+        tb_size_t class_end = tb_min(class_idx + DX_FILE_LOAD_BATCH, class_size);
+        for (; class_idx < class_end; class_idx++)
+        {
+            dx_class_t* dexclass = (dx_class_t*)dx_file_class(worker->file, class_idx);
+            if (dexclass)
+            {
+                worker->stat.classes++;
+                worker->stat.fields  += dexclass->header.static_fields_size + dexclass->header.instance_fields_size;
+                worker->stat.methods += dexclass->header.direct_methods_size + dexclass->header.virtual_methods_size;
+                dx_file_class_release(worker->file, (dx_class_ref_t)dexclass);
+            }
+        }
+    }
+    worker->stat.time = tb_uclock() - time;
+
+    // ok
+    return 0;
+}
+static tb_void_t dx_file_batch_ready(dx_file_batch_t* batch, tb_size_t index, dx_file_ref_t file)
+{
+    // push it to the ready queue
+    tb_spinlock_enter(&batch->lock);
+    batch->items[batch->tail].index = index;
+    batch->items[batch->tail].file  = file;
+    batch->tail = (batch->tail + 1) % batch->maxn;
+    tb_spinlock_leave(&batch->lock);
+    tb_semaphore_post(batch->ready, 1);
+}
+static tb_int_t dx_file_batch_worker(tb_cpointer_t priv)
+{
+    // check
+    dx_file_batch_t* batch = (dx_file_batch_t*)priv;
+    tb_assert_and_check_return_val(batch, -1);
+
+    while (1)
+    {
+        // wait a free slot, it will block us if the callback is slower than loading
+        if (tb_semaphore_wait(batch->slots, -1) <= 0) break;
+        tb_check_break(!tb_atomic_get(&batch->stop));
+
+        // get the next url, give back the slot for waking up other workers if no more urls
+        tb_size_t index = (tb_size_t)tb_atomic_fetch_and_add(&batch->next, 1);
+        if (index >= batch->size)
+        {
+            tb_semaphore_post(batch->slots, 1);
+            break;
+        }
+
+        // load it, the failed result will be also passed to the callback
+        dx_file_ref_t file = batch->urls[index]? dx_file_load_from_url(batch->urls[index], batch->checksum) : tb_null;
+
+        // push it to the ready queue
+        dx_file_batch_ready(batch, index, file);
+    }
+
+    // ok
+    return 0;
+}
+static tb_void_t dx_file_batch_rpush(dx_file_batch_t* batch, tb_size_t index, tb_byte_t* data, tb_size_t size)
+{
+    // push it to the read queue
+    tb_spinlock_enter(&batch->lock);
+    batch->rqueue[batch->rtail].index   = index;
+    batch->rqueue[batch->rtail].data    = data;
+    batch->rqueue[batch->rtail].size    = size;
+    batch->rtail = (batch->rtail + 1) % batch->rmaxn;
+    tb_spinlock_leave(&batch->lock);
+    tb_semaphore_post(batch->reads, 1);
+}
+static tb_bool_t dx_file_batch_read_func(tb_size_t index, tb_byte_t* data, tb_size_t size, tb_cpointer_t udata)
+{
+    // check
+    dx_file_batch_t* batch = (dx_file_batch_t*)udata;
+    tb_assert_and_check_return_val(batch, tb_false);
+
+    // wait a free slot, the read data will be parsed by the workers
+    if (tb_semaphore_wait(batch->slots, -1) <= 0 || tb_atomic_get(&batch->stop))
+    {
+        if (data) tb_align_free(data);
+        return tb_false;
+    }
+    dx_file_batch_rpush(batch, index, data, size);
+    return tb_true;
+}
+static tb_int_t dx_file_batch_reader(tb_cpointer_t priv)
+{
+    // check
+    dx_file_batch_t* batch = (dx_file_batch_t*)priv;
+    tb_assert_and_check_return_val(batch && batch->uring, -1);
+
+    // read all files
+    dx_uring_read(batch->uring, batch->paths, batch->size, dx_file_batch_read_func, batch);
+
+    // notify all workers to exit
+    tb_size_t i = 0;
+    for (i = 0; i < batch->nthreads; i++) dx_file_batch_rpush(batch, (tb_size_t)-1, tb_null, 0);
+
+    // ok
+    return 0;
+}
+static tb_int_t dx_file_batch_parser(tb_cpointer_t priv)
+{
+    // check
+    dx_file_batch_t* batch = (dx_file_batch_t*)priv;
+    tb_assert_and_check_return_val(batch, -1);
+
+    while (1)
+    {
+        // wait the read data
+        if (tb_semaphore_wait(batch->reads, -1) <= 0) break;
+
+        // pop it
+        tb_spinlock_enter(&batch->lock);
+        dx_file_batch_read_t read = batch->rqueue[batch->rhead];
+        batch->rhead = (batch->rhead + 1) % batch->rmaxn;
+        tb_spinlock_leave(&batch->lock);
+
+        // no more data?
+        tb_check_break(read.index != (tb_size_t)-1);
+
+        // stopped? discard it
+        if (tb_atomic_get(&batch->stop))
+        {
+            if (read.data) tb_align_free(read.data);
+            continue;
+        }
+
+        // parse it
+        dx_file_ref_t file = tb_null;
+        if (read.data)
+        {
+            file = dx_file_load_from_data(read.data, read.size, batch->checksum);
+            if (file)
+            {
+                // mark as owner of the data
+                ((dx_file_t*)file)->owner       = DX_FILE_OWNER_ALLOC;
+                ((dx_file_t*)file)->base_size   = read.size;
+            }
+            else tb_align_free(read.data);
+        }
+        // it may be not local file, we load it by the stream
+        else if (batch->urls[read.index]) file = dx_file_load_from_url(batch->urls[read.index], batch->checksum);
+
+        // push it to the ready queue
+        dx_file_batch_ready(batch, read.index, file);
+    }
+
+    // ok
+    return 0;
+}
+static tb_bool_t dx_file_probe_read_data(tb_cpointer_t priv, tb_hize_t offset, tb_byte_t* data, tb_size_t size)
+{
+    // check
+    dx_file_probe_data_t const* probe_data = (dx_file_probe_data_t const*)priv;
+    tb_assert_and_check_return_val(probe_data && data, tb_false);
+
+    // copy it, the data may be not aligned
+    tb_check_return_val(offset <= probe_data->size && size <= probe_data->size - offset, tb_false);
+    tb_memcpy(data, probe_data->data + offset, size);
+    return tb_true;
+}
+static tb_bool_t dx_file_probe_read_stream(tb_cpointer_t priv, tb_hize_t offset, tb_byte_t* data, tb_size_t size)
+{
+    // check
+    tb_stream_ref_t stream = (tb_stream_ref_t)priv;
+    tb_assert_and_check_return_val(stream && data, tb_false);
+
+    // read it
+    return tb_stream_seek(stream, offset) && tb_stream_bread(stream, data, size);
+}
+static tb_bool_t dx_file_probe_done(dx_file_probe_read_t read, tb_cpointer_t priv, dx_file_probe_ref_t probe)
+{
+    // read the dex header
+    dx_header_t header;
+    tb_hize_t   offset = 0;
+    tb_memset(probe, 0, sizeof(dx_file_probe_t));
+    if (!read(priv, 0, (tb_byte_t*)&header, sizeof(dx_header_t))) return tb_false;
+
+    // is the optimized dex file? read the dex header after the optimized header
+    if (!tb_memcmp(header.magic, DX_OPT_MAGIC, 4))
+    {
+        offset = ((dx_header_opt_ref_t)&header)->dex_offset;
+        probe->optimized = tb_true;
+        if (!read(priv, offset, (tb_byte_t*)&header, sizeof(dx_header_t))) return tb_false;
+    }
+
+    // check the magic and version, we also probe the unsupported version, e.g. "dex\n039\0"
+    tb_byte_t const* magic = header.magic;
+    if (    tb_memcmp(magic, DX_MAGIC, 4) 
+        ||  magic[4] < '0' || magic[4] > '9'
+        ||  magic[5] < '0' || magic[5] > '9'
+        ||  magic[6] < '0' || magic[6] > '9'
+        ||  magic[7])
+        return tb_false;
+
+    // save the header information
+    probe->version      = (magic[4] - '0') * 100 + (magic[5] - '0') * 10 + (magic[6] - '0');
+    probe->checksum     = header.checksum;
+    probe->file_size    = header.file_size;
+    probe->data_size    = header.data_size;
+    probe->strings      = header.string_ids_size;
+    probe->types        = header.type_ids_size;
+    probe->protos       = header.proto_ids_size;
+    probe->fields       = header.field_ids_size;
+    probe->methods      = header.method_ids_size;
+    probe->classes      = header.class_defs_size;
+    tb_memcpy(probe->signature, header.signature, DX_FILE_SIGNATURE_SIZE);
+
+    // read the map_list, it will be skipped if it cannot be read
+    tb_uint32_t map_size = 0;
+    if (    header.map_off 
+        &&  read(priv, offset + header.map_off, (tb_byte_t*)&map_size, sizeof(tb_uint32_t))
+        &&  map_size && map_size <= DX_FILE_PROBE_MAP_MAXN)
+    {
+        dx_map_item_t items[DX_FILE_PROBE_MAP_MAXN];
+        if (read(priv, offset + header.map_off + sizeof(tb_uint32_t), (tb_byte_t*)items, map_size * sizeof(dx_map_item_t)))
+        {
+            tb_uint32_t i = 0;
+            for (i = 0; i < map_size; i++)
+            {
+                switch (items[i].type)
+                {
+                case DX_MAP_TYPE_CLASS_DATA_ITEM:
+                    probe->class_data_items = items[i].size;
+                    break;
+                case DX_MAP_TYPE_CODE_ITEM:
+                    probe->code_items = items[i].size;
+                    break;
+                default:
+                    break;
+                }
+            }
+            probe->map_size = map_size;
+        }
+    }
+
+    // ok
+    return tb_true;
+}
 static tb_bool_t dx_file_opt_load(dx_file_t* dexfile, tb_byte_t const* data, tb_size_t size)
 {
     // check
@@ -122,6 +566,14 @@ static tb_bool_t dx_file_opt_load(dx_file_t* dexfile, tb_byte_t const* data, tb_
         return tb_false;
     }
 
+    // check the range of the dex data, the dependencies and the optimized data, they are from the untrusted file
+    if (!dx_file_opt_check_range(header_opt, size))
+    {
+        // trace
+        tb_trace_e("invalid range of the optimized data!");
+        return tb_false;
+    }
+
     // attach the optimized header
     dexfile->header_opt = header_opt;
     
@@ -233,6 +685,309 @@ static tb_bool_t dx_file_opt_load(dx_file_t* dexfile, tb_byte_t const* data, tb_
     // ok
     return tb_true;
 }
+static __tb_inline__ tb_uint16_t dx_file_mutf8_next(tb_byte_t const** pp)
+{
+    // the first byte
+    tb_byte_t const*    p = *pp;
+    tb_uint16_t         c = *p;
+    tb_check_return_val(c, 0);
+
+    // decode one utf-16 unit, the end character will never be consumed for the broken string
+    if ((c & 0xe0) == 0xc0 && p[1])
+    {
+        c = ((c & 0x1f) << 6) | (p[1] & 0x3f);
+        p += 2;
+    }
+    else if ((c & 0xf0) == 0xe0 && p[1] && p[2])
+    {
+        c = ((c & 0x0f) << 12) | ((p[1] & 0x3f) << 6) | (p[2] & 0x3f);
+        p += 3;
+    }
+    else p++;
+
+    // ok
+    *pp = p;
+    return c;
+}
+static tb_long_t dx_file_mutf8_compare(tb_char_t const* s1, tb_char_t const* s2, tb_size_t n2)
+{
+    /* compare the mutf-8 strings as utf-16 units, string_ids are sorted by it.
+     *
+     * the byte order of mutf-8 is the same as utf-16 except for the '\0' (0xc0 0x80),
+     * but we still decode the non-ascii characters for it.
+     */
+    tb_byte_t const* p = (tb_byte_t const*)s1;
+    tb_byte_t const* q = (tb_byte_t const*)s2;
+    tb_byte_t const* e = q + n2;
+    while (1)
+    {
+        // compare the ascii characters directly
+        tb_byte_t b = q < e? *q : 0;
+        if (*p == b && b < 0x80)
+        {
+            if (!b) return 0;
+            p++;
+            q++;
+            continue;
+        }
+
+        // compare the utf-16 units
+        tb_uint16_t c1 = dx_file_mutf8_next(&p);
+        tb_uint16_t c2 = q < e? dx_file_mutf8_next(&q) : 0;
+        if (c1 != c2) return c1 < c2? -1 : 1;
+        if (!c1) return 0;
+    }
+}
+static tb_long_t dx_file_string_find_n(dx_file_t* dexfile, tb_char_t const* string, tb_size_t size)
+{
+    // find it with the binary search, string_ids are sorted by the string content
+    tb_size_t l = 0;
+    tb_size_t r = dexfile->header->string_ids_size;
+    while (l < r)
+    {
+        tb_size_t           m = l + ((r - l) >> 1);
+        tb_char_t const*    s = dx_file_get_string(dexfile, m);
+        tb_check_return_val(s, -1);
+
+        // compare it
+        tb_long_t           c = dx_file_mutf8_compare(s, string, size);
+        if (c < 0) l = m + 1;
+        else if (c > 0) r = m;
+        else return (tb_long_t)m;
+    }
+
+    // not found
+    return -1;
+}
+static tb_long_t dx_file_type_find_n(dx_file_t* dexfile, tb_char_t const* descriptor, tb_size_t size)
+{
+    // find the descriptor string first
+    tb_long_t string_idx = dx_file_string_find_n(dexfile, descriptor, size);
+    tb_check_return_val(string_idx >= 0, -1);
+
+    // find it with the binary search, type_ids are sorted by descriptor_idx
+    tb_size_t l = 0;
+    tb_size_t r = dexfile->header->type_ids_size;
+    while (l < r)
+    {
+        tb_size_t   m = l + ((r - l) >> 1);
+        tb_size_t   v = dexfile->type_ids[m].descriptor_idx;
+        if (v < (tb_size_t)string_idx) l = m + 1;
+        else if (v > (tb_size_t)string_idx) r = m;
+        else return (tb_long_t)m;
+    }
+
+    // not found
+    return -1;
+}
+static tb_size_t dx_file_descriptor_next(tb_char_t const* p, tb_char_t const* e)
+{
+    // skip array dimensions
+    tb_char_t const* b = p;
+    while (p < e && *p == '[') p++;
+    tb_check_return_val(p < e, 0);
+
+    // the class type? find the end of it
+    if (*p == 'L')
+    {
+        while (p < e && *p != ';') p++;
+        tb_check_return_val(p < e, 0);
+    }
+
+    // the size of this type descriptor
+    return p + 1 - b;
+}
+static tb_long_t dx_file_proto_find(dx_file_t* dexfile, tb_char_t const* descriptor)
+{
+    // check
+    tb_assert_and_check_return_val(dexfile && descriptor && *descriptor == '(', -1);
+
+    // find all parameter types, a method can have 255 parameters at most
+    tb_uint32_t         params[256];
+    tb_size_t           params_size = 0;
+    tb_char_t const*    p = descriptor + 1;
+    tb_char_t const*    e = p + tb_strlen(p);
+    while (p < e && *p != ')')
+    {
+        tb_size_t n = dx_file_descriptor_next(p, e);
+        tb_check_return_val(n && params_size < tb_arrayn(params), -1);
+
+        tb_long_t type_idx = dx_file_type_find_n(dexfile, p, n);
+        tb_check_return_val(type_idx >= 0, -1);
+        params[params_size++] = (tb_uint32_t)type_idx;
+        p += n;
+    }
+    tb_check_return_val(p < e, -1);
+    p++;
+
+    // find the return type
+    tb_size_t n = dx_file_descriptor_next(p, e);
+    tb_check_return_val(n && p + n == e, -1);
+    tb_long_t return_type_idx = dx_file_type_find_n(dexfile, p, n);
+    tb_check_return_val(return_type_idx >= 0, -1);
+
+    // find it with the binary search, proto_ids are sorted by the return type and the parameter types
+    tb_size_t l = 0;
+    tb_size_t r = dexfile->header->proto_ids_size;
+    while (l < r)
+    {
+        // compare the return type first
+        tb_size_t           m = l + ((r - l) >> 1);
+        dx_proto_id_ref_t   proto_id = dx_file_get_proto_id(dexfile, m);
+        tb_long_t           c = (tb_long_t)proto_id->return_type_idx - return_type_idx;
+
+        // compare the parameter types
+        if (!c)
+        {
+            dx_type_list_ref_t  list = dx_file_get_proto_parameters(dexfile, proto_id);
+            tb_size_t           size = list? list->size : 0;
+            tb_size_t           i = 0;
+            for (i = 0; !c && i < size && i < params_size; i++)
+                c = (tb_long_t)dx_file_get_type_idx(list, i) - (tb_long_t)params[i];
+            if (!c) c = (tb_long_t)size - (tb_long_t)params_size;
+        }
+
+        if (c < 0) l = m + 1;
+        else if (c > 0) r = m;
+        else return (tb_long_t)m;
+    }
+
+    // not found
+    return -1;
+}
+static tb_long_t dx_file_type_class_idx(dx_file_t* dexfile, tb_size_t type_idx)
+{
+    // check
+    tb_assert_and_check_return_val(dexfile && dexfile->header, -1);
+    tb_check_return_val(type_idx < dexfile->header->type_ids_size, -1);
+
+    // make the class_def indexes of all types at the first time
+    tb_uint32_t* type_classes = (tb_uint32_t*)dx_pointer_get((tb_pointer_t const*)&dexfile->type_classes);
+    if (!type_classes)
+    {
+        // init it
+        tb_size_t type_size = dexfile->header->type_ids_size;
+        tb_uint32_t* type_classes_new = tb_nalloc_type(type_size, tb_uint32_t);
+        tb_assert_and_check_return_val(type_classes_new, -1);
+        tb_memset(type_classes_new, 0xff, type_size * sizeof(tb_uint32_t));
+
+        // fill it with one pass over class_defs
+        tb_size_t i = 0;
+        tb_size_t class_size = dexfile->header->class_defs_size;
+        for (i = 0; i < class_size; i++)
+        {
+            tb_size_t class_idx = dexfile->class_defs[i].class_idx;
+            if (class_idx < type_size) type_classes_new[class_idx] = (tb_uint32_t)i;
+        }
+
+        // publish it, another thread may have published it
+        type_classes = (tb_uint32_t*)dx_pointer_publish((tb_pointer_t*)&dexfile->type_classes, type_classes_new);
+        if (type_classes != type_classes_new) tb_free(type_classes_new);
+    }
+
+    // get it
+    tb_uint32_t class_def_idx = type_classes[type_idx];
+    return class_def_idx != (tb_uint32_t)-1? (tb_long_t)class_def_idx : -1;
+}
+static dx_class_lookup_ref_t dx_file_class_lookup_make(dx_file_t* dexfile)
+{
+    // check
+    tb_assert_and_check_return_val(dexfile && dexfile->header, tb_null);
+
+    // the entry count, it must be power of 2 and we need keep the load factor <= 0.5
+    tb_size_t class_size = dexfile->header->class_defs_size;
+    tb_size_t num_entries = 1;
+    while (num_entries < (class_size << 1)) num_entries <<= 1;
+
+    // make the lookup table
+    tb_size_t               size = sizeof(dx_class_lookup_t) + (num_entries - 1) * sizeof(((dx_class_lookup_ref_t)0)->table[0]);
+    dx_class_lookup_ref_t   lookup = (dx_class_lookup_ref_t)tb_malloc0(size);
+    tb_assert_and_check_return_val(lookup, tb_null);
+
+    // init it
+    lookup->size        = (tb_int_t)size;
+    lookup->num_entries = (tb_int_t)num_entries;
+
+    // insert all classes with the linear probing
+    tb_size_t i = 0;
+    tb_size_t mask = num_entries - 1;
+    for (i = 0; i < class_size; i++)
+    {
+        // get the class descriptor
+        dx_class_def_ref_t  class_def = dx_file_get_class_def(dexfile, i);
+        tb_char_t const*    descriptor = dx_file_get_string_by_type_idx(dexfile, class_def->class_idx);
+        tb_check_continue(descriptor);
+
+        // find a free entry
+        tb_uint32_t hash = dx_file_class_descriptor_hash(descriptor);
+        tb_size_t   idx = hash & mask;
+        while (lookup->table[idx].class_descriptor_offset) idx = (idx + 1) & mask;
+
+        // save it, the offsets are relative to the dex data
+        lookup->table[idx].class_descriptor_hash    = hash;
+        lookup->table[idx].class_descriptor_offset  = (tb_int_t)((tb_byte_t const*)descriptor - dexfile->data);
+        lookup->table[idx].class_def_offset         = (tb_int_t)((tb_byte_t const*)class_def - dexfile->data);
+    }
+
+    // trace
+    tb_trace_d("make class lookup: %lu classes, %lu entries", class_size, num_entries);
+
+    // ok
+    return lookup;
+}
+static tb_long_t dx_file_class_lookup_find(dx_file_t* dexfile, tb_char_t const* descriptor)
+{
+    // check
+    tb_assert_and_check_return_val(dexfile && dexfile->header && descriptor, -1);
+
+    // no class lookup table? make it
+    dx_class_lookup_ref_t lookup = (dx_class_lookup_ref_t)dx_pointer_get((tb_pointer_t const*)&dexfile->class_lookup);
+    if (!lookup)
+    {
+        // make a new lookup table
+        dx_class_lookup_ref_t lookup_new = dx_file_class_lookup_make(dexfile);
+        tb_assert_and_check_return_val(lookup_new, -1);
+
+        // publish it, another thread may have published it
+        lookup = (dx_class_lookup_ref_t)dx_pointer_publish((tb_pointer_t*)&dexfile->class_lookup, lookup_new);
+        if (lookup == lookup_new) dexfile->class_lookup_data = lookup_new;
+        else tb_free(lookup_new);
+    }
+    tb_assert_and_check_return_val(lookup && lookup->num_entries > 0, -1);
+
+    // the class defs range
+    tb_size_t class_defs_off    = dexfile->header->class_defs_off;
+    tb_size_t class_defs_end    = class_defs_off + dexfile->header->class_defs_size * sizeof(dx_class_def_t);
+
+    // find it with the linear probing
+    tb_uint32_t hash    = dx_file_class_descriptor_hash(descriptor);
+    tb_size_t   mask    = (tb_size_t)lookup->num_entries - 1;
+    tb_size_t   idx     = hash & mask;
+    tb_size_t   probe   = 0;
+    for (probe = 0; probe <= mask; probe++, idx = (idx + 1) & mask)
+    {
+        // the empty entry? not found
+        tb_int_t offset = lookup->table[idx].class_descriptor_offset;
+        tb_check_break(offset);
+
+        // the same hash and descriptor?
+        if (lookup->table[idx].class_descriptor_hash == hash
+            && offset > 0 && (tb_size_t)offset < dexfile->size
+            && !tb_strcmp((tb_char_t const*)dexfile->data + offset, descriptor))
+        {
+            // the table may be corrupted, check the class_def offset
+            tb_size_t class_def_off = (tb_size_t)lookup->table[idx].class_def_offset;
+            tb_assert_and_check_return_val(class_def_off >= class_defs_off && class_def_off < class_defs_end, -1);
+            tb_assert_and_check_return_val(!((class_def_off - class_defs_off) % sizeof(dx_class_def_t)), -1);
+
+            // ok
+            return (tb_long_t)((class_def_off - class_defs_off) / sizeof(dx_class_def_t));
+        }
+    }
+
+    // not found
+    return -1;
+}
 static tb_bool_t dx_file_class_read_header(tb_static_stream_ref_t stream, dx_class_header_ref_t header)
 {
     // check
@@ -267,13 +1022,8 @@ static tb_bool_t dx_file_class_read_field(tb_static_stream_ref_t stream, tb_stat
     if (values_stream) dx_annotation_array_next(values_stream, &field->value);
     else field->value.type = DX_VALUE_NONE;
 
-    // check
-    tb_assert(field->field_idx < dexfile->header->field_ids_size);
-    tb_assert(!dexfile->fields[field->field_idx]);
-
-    // save this field
-    if (field->field_idx < dexfile->header->field_ids_size)
-        dexfile->fields[field->field_idx] = (tb_pointer_t)field;
+    // the indexes in the validated dex file need not be checked
+    tb_check_return_val(dexfile->validated || field->field_idx < dexfile->header->field_ids_size, tb_false);
 
     // ok
     return tb_true;
@@ -295,26 +1045,208 @@ static tb_bool_t dx_file_class_read_method(tb_static_stream_ref_t stream, dx_met
     // save dex file
     method->dexfile = dexfile;
 
-    // check
-    tb_assert(method->method_idx < dexfile->header->method_ids_size);
-    tb_assert(!dexfile->methods[method->method_idx]);
-
-    // save this method
-    if (method->method_idx < dexfile->header->method_ids_size)
-        dexfile->methods[method->method_idx] = (tb_pointer_t)method;
+    // the indexes in the validated dex file need not be checked
+    tb_check_return_val(dexfile->validated || method->method_idx < dexfile->header->method_ids_size, tb_false);
 
     // ok
     return tb_true;
 }
+static tb_void_t dx_file_class_publish(dx_file_t* dexfile, dx_class_t* dexclass)
+{
+    // check
+    tb_assert(dexfile && dexclass);
+
+    // all members have been published?
+    tb_check_return(!tb_atomic_get(&dexclass->published));
+
+    // publish all fields, they are kept if they have been published
+    tb_size_t i = 0;
+    tb_size_t field_ids_size = dexfile->header->field_ids_size;
+    for (i = 0; i < dexclass->header.static_fields_size; i++)
+    {
+        dx_field_t* field = &dexclass->static_fields[i];
+        if (field->field_idx < field_ids_size) dx_ptable_publish(&dexfile->fields, field->field_idx, field);
+    }
+    for (i = 0; i < dexclass->header.instance_fields_size; i++)
+    {
+        dx_field_t* field = &dexclass->instance_fields[i];
+        if (field->field_idx < field_ids_size) dx_ptable_publish(&dexfile->fields, field->field_idx, field);
+    }
 
+    // publish all methods
+    tb_size_t method_ids_size = dexfile->header->method_ids_size;
+    for (i = 0; i < dexclass->header.direct_methods_size; i++)
+    {
+        dx_method_t* method = &dexclass->direct_methods[i];
+        if (method->method_idx < method_ids_size) dx_ptable_publish(&dexfile->methods, method->method_idx, method);
+    }
+    for (i = 0; i < dexclass->header.virtual_methods_size; i++)
+    {
+        dx_method_t* method = &dexclass->virtual_methods[i];
+        if (method->method_idx < method_ids_size) dx_ptable_publish(&dexfile->methods, method->method_idx, method);
+    }
+
+    // mark it, so the later misses will not walk all members again
+    tb_atomic_set(&dexclass->published, 1);
+}
+static tb_size_t dx_file_class_memsize(dx_class_header_ref_t header)
+{
+    return  sizeof(dx_class_t) 
+        +   header->static_fields_size * sizeof(dx_field_t)
+        +   header->instance_fields_size * sizeof(dx_field_t)
+        +   header->direct_methods_size * sizeof(dx_method_t)
+        +   header->virtual_methods_size * sizeof(dx_method_t);
+}
+static tb_void_t dx_file_cache_unlink(dx_file_t* dexfile, dx_class_t* dexclass)
+{
+    // remove it from the lru list
+    if (dexclass->lru_prev) dexclass->lru_prev->lru_next = dexclass->lru_next;
+    else dexfile->cache_head = dexclass->lru_next;
+    if (dexclass->lru_next) dexclass->lru_next->lru_prev = dexclass->lru_prev;
+    else dexfile->cache_tail = dexclass->lru_prev;
+    dexclass->lru_prev = tb_null;
+    dexclass->lru_next = tb_null;
+}
+static tb_void_t dx_file_cache_link(dx_file_t* dexfile, dx_class_t* dexclass)
+{
+    // insert it to the head of the lru list
+    dexclass->lru_prev = tb_null;
+    dexclass->lru_next = dexfile->cache_head;
+    if (dexfile->cache_head) dexfile->cache_head->lru_prev = dexclass;
+    else dexfile->cache_tail = dexclass;
+    dexfile->cache_head = dexclass;
+}
+static tb_void_t dx_file_cache_touch(dx_file_t* dexfile, dx_class_t* dexclass)
+{
+    // move it to the head of the lru list
+    if (dexfile->cache_head != dexclass)
+    {
+        dx_file_cache_unlink(dexfile, dexclass);
+        dx_file_cache_link(dexfile, dexclass);
+    }
+}
+static tb_void_t dx_file_cache_evict(dx_file_t* dexfile, dx_class_t* dexclass)
+{
+    // remove it from the lru list
+    dx_file_cache_unlink(dexfile, dexclass);
+
+    // remove it from the class cache
+    tb_size_t class_idx = dexclass->class_def - dexfile->class_defs;
+    tb_atomic_set((tb_atomic_t*)&dexfile->classes[class_idx], 0);
+
+    // remove all fields
+    tb_size_t i = 0;
+    for (i = 0; i < dexclass->header.static_fields_size; i++)
+        dx_ptable_remove(&dexfile->fields, dexclass->static_fields[i].field_idx, &dexclass->static_fields[i]);
+    for (i = 0; i < dexclass->header.instance_fields_size; i++)
+        dx_ptable_remove(&dexfile->fields, dexclass->instance_fields[i].field_idx, &dexclass->instance_fields[i]);
+
+    // remove all methods
+    for (i = 0; i < dexclass->header.direct_methods_size; i++)
+        dx_ptable_remove(&dexfile->methods, dexclass->direct_methods[i].method_idx, &dexclass->direct_methods[i]);
+    for (i = 0; i < dexclass->header.virtual_methods_size; i++)
+        dx_ptable_remove(&dexfile->methods, dexclass->virtual_methods[i].method_idx, &dexclass->virtual_methods[i]);
+
+    // update statistics
+    dexfile->cache_stat.size -= dx_file_class_memsize(&dexclass->header);
+    dexfile->cache_stat.count--;
+    dexfile->cache_stat.evictions++;
+
+    // exit it
+    tb_free(dexclass);
+}
+static tb_void_t dx_file_cache_shrink(dx_file_t* dexfile)
+{
+    // evict the least recently used classes until it is in budget, the pinned classes are skipped
+    dx_class_t* dexclass = dexfile->cache_tail;
+    while (dexclass && dexfile->cache_stat.size > dexfile->cache_stat.maxn)
+    {
+        dx_class_t* prev = dexclass->lru_prev;
+        if (!dexclass->refn) dx_file_cache_evict(dexfile, dexclass);
+        dexclass = prev;
+    }
+}
+static dx_class_t* dx_file_cache_insert(dx_file_t* dexfile, tb_size_t class_idx, dx_class_t* dexclass)
+{
+    // enter
+    tb_spinlock_enter(&dexfile->cache_lock);
+
+    // this class has been cached by another thread? use it
+    dx_class_t* cached = (dx_class_t*)dexfile->classes[class_idx];
+    if (cached) 
+    {
+        dx_file_cache_touch(dexfile, cached);
+        cached->refn++;
+    }
+    else
+    {
+        // cache it and publish its fields and methods
+        dexfile->classes[class_idx] = (tb_pointer_t)dexclass;
+        dx_file_class_publish(dexfile, dexclass);
+        dx_file_cache_link(dexfile, dexclass);
+        dexfile->cache_stat.size += dx_file_class_memsize(&dexclass->header);
+        dexfile->cache_stat.count++;
+
+        // pin it for the caller, and evict the other classes until it is in budget
+        dexclass->refn = 1;
+        dx_file_cache_shrink(dexfile);
+    }
+
+    // leave
+    tb_spinlock_leave(&dexfile->cache_lock);
+
+    // free our copy if it has been cached
+    if (cached) tb_free(dexclass);
+    return cached? cached : dexclass;
+}
+static tb_void_t dx_file_cache_release(dx_file_t* dexfile, tb_long_t class_idx)
+{
+    // check
+    tb_check_return(dexfile->cache_stat.maxn && class_idx >= 0 && (tb_size_t)class_idx < dexfile->header->class_defs_size);
+
+    // enter
+    tb_spinlock_enter(&dexfile->cache_lock);
+
+    // unpin it, and evict the classes which were kept over budget by the pinned classes
+    dx_class_t* dexclass = (dx_class_t*)dexfile->classes[class_idx];
+    tb_assert(dexclass && dexclass->refn);
+    if (dexclass && dexclass->refn && !--dexclass->refn) 
+        dx_file_cache_shrink(dexfile);
+
+    // leave
+    tb_spinlock_leave(&dexfile->cache_lock);
+}
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation 
  */
-dx_file_ref_t dx_file_load_from_url(tb_char_t const* url, tb_bool_t checksum)
+dx_file_ref_t dx_file_load_from_url(tb_char_t const* url, tb_size_t checksum)
 {
     // check
     tb_assert_and_check_return_val(url, tb_null);
 
+    // is local file? map it directly and we need not copy the whole file data
+    tb_char_t const* path = dx_mmap_path(url);
+    if (path)
+    {
+        tb_size_t           size = 0;
+        tb_byte_t const*    data = dx_mmap_init(path, &size);
+        if (data)
+        {
+            // load dex from the mapped data 
+            dx_file_ref_t dexfile = dx_file_load_from_data(data, size, checksum);
+            if (dexfile)
+            {
+                // mark as owner of the mapped data
+                ((dx_file_t*)dexfile)->owner        = DX_FILE_OWNER_MMAP;
+                ((dx_file_t*)dexfile)->base_size    = size;
+            }
+            else dx_mmap_exit(data, size);
+
+            // ok?
+            return dexfile;
+        }
+    }
+
     // done
     tb_size_t           size = 0;
     tb_byte_t*          data = tb_null;
@@ -345,7 +1277,8 @@ dx_file_ref_t dx_file_load_from_url(tb_char_t const* url, tb_bool_t checksum)
         tb_check_break(dexfile);
 
         // mark as owner of the data
-        ((dx_file_t*)dexfile)->owner = tb_true;
+        ((dx_file_t*)dexfile)->owner        = DX_FILE_OWNER_ALLOC;
+        ((dx_file_t*)dexfile)->base_size    = size;
 
     } while (0);
 
@@ -357,14 +1290,14 @@ dx_file_ref_t dx_file_load_from_url(tb_char_t const* url, tb_bool_t checksum)
     if (!dexfile)
     {
         // exit it
-        if (data) tb_free(data);
+        if (data) tb_align_free(data);
         data = tb_null;
     }
 
     // ok?
     return dexfile;
 }
-dx_file_ref_t dx_file_load_from_data(tb_byte_t const* data, tb_size_t size, tb_bool_t checksum)
+dx_file_ref_t dx_file_load_from_data(tb_byte_t const* data, tb_size_t size, tb_size_t checksum)
 {
     // check
     tb_assert_and_check_return_val(data && size, tb_null);
@@ -373,6 +1306,8 @@ dx_file_ref_t dx_file_load_from_data(tb_byte_t const* data, tb_size_t size, tb_b
     tb_bool_t           ok = tb_false;
     dx_file_t*      dexfile = tb_null;
     dx_header_ref_t header = tb_null;
+    tb_bool_t       validate = (checksum & DX_FILE_VALIDATE)? tb_true : tb_false;
+    checksum &= DX_FILE_CHECKSUM_MASK;
     do
     {
         // check the data size
@@ -384,7 +1319,8 @@ dx_file_ref_t dx_file_load_from_data(tb_byte_t const* data, tb_size_t size, tb_b
 
         // save base 
         dexfile->base       = data;
-        dexfile->owner      = tb_false;
+        dexfile->base_size  = size;
+        dexfile->owner      = DX_FILE_OWNER_NONE;
 
         // is the optimized header?
         if (!tb_memcmp(data, DX_OPT_MAGIC, 4))
@@ -396,9 +1332,9 @@ dx_file_ref_t dx_file_load_from_data(tb_byte_t const* data, tb_size_t size, tb_b
             if (!dx_file_opt_load(dexfile, data, size)) break;
 
             // check adler for the optimized dex data
-            if (checksum) if (!dx_file_opt_check_adler(header_opt)) break;
+            if (checksum == DX_FILE_CHECKSUM_SYNC) if (!dx_file_opt_check_adler(header_opt, size)) break;
 
-            // skip the optimized header
+            // skip the optimized header, its offset has been checked in dx_file_opt_load()
             data += header_opt->dex_offset;
             size -= header_opt->dex_offset;
             if (size < header_opt->dex_length)
@@ -420,9 +1356,6 @@ dx_file_ref_t dx_file_load_from_data(tb_byte_t const* data, tb_size_t size, tb_b
         // check the dex magic
         if (!dx_file_check_magic(header)) break;
 
-        // check adler for the dex data
-        if (checksum) if (!dx_file_check_adler(header)) break;
-
         // check file size
         if (header->file_size != size) 
         {
@@ -431,6 +1364,13 @@ dx_file_ref_t dx_file_load_from_data(tb_byte_t const* data, tb_size_t size, tb_b
             break;
         }
 
+        // check adler for the dex data
+        if (checksum == DX_FILE_CHECKSUM_SYNC) 
+        {
+            if (!dx_file_check_adler(header)) break;
+            tb_atomic_set(&dexfile->verify_state, DX_FILE_VERIFY_OK);
+        }
+
         // check classes
         if (!header->class_defs_size) 
         {
@@ -449,36 +1389,290 @@ dx_file_ref_t dx_file_load_from_data(tb_byte_t const* data, tb_size_t size, tb_b
         dexfile->class_defs = (dx_class_def_ref_t)  (data + header->class_defs_off);
         dexfile->link_data  = (dx_link_ref_t)       (data + header->link_off);
 
+        // check the header and the bounds of the id tables, it only reads the header
+        if (!dx_validate_header(dexfile))
+        {
+            // trace
+            tb_trace_e("malformed dex header!");
+            break;
+        }
+
+        // validate the structure in one pass if be required, the accessors will not check it again
+        if (validate)
+        {
+            dexfile->validated = dx_validate_file(dexfile);
+            if (!dexfile->validated)
+            {
+                // trace
+                tb_trace_e("malformed dex structure!");
+                break;
+            }
+        }
+
         // init classes
         dexfile->classes = (tb_pointer_t*)tb_nalloc0_type(header->class_defs_size, dx_class_t*);
         tb_assert_and_check_break(dexfile->classes);
 
-        // init fields
-        dexfile->fields = (tb_pointer_t*)tb_nalloc0_type(header->field_ids_size, dx_field_t*);
-        tb_assert_and_check_break(dexfile->fields);
+        // init fields, only the page directory will be allocated now
+        if (!dx_ptable_init(&dexfile->fields, header->field_ids_size)) break;
+
+        // init methods, only the page directory will be allocated now
+        if (!dx_ptable_init(&dexfile->methods, header->method_ids_size)) break;
+
+        // init the predecoded codes of methods
+        if (!dx_ptable_init(&dexfile->predecodes, header->method_ids_size)) break;
+
+        // init the switch jump tables of methods
+        if (!dx_ptable_init(&dexfile->switches, header->method_ids_size)) break;
+
+        // init the control flow graphs of methods
+        if (!dx_ptable_init(&dexfile->cfgs, header->method_ids_size)) break;
+
+        /* verify checksum on the background thread, 
+         * we will verify it directly if the file is too small or the thread cannot be started
+         */
+        if (checksum == DX_FILE_CHECKSUM_ASYNC && (dexfile->base_size < DX_FILE_VERIFY_ASYNC_MINN || !dx_file_verify_start(dexfile)))
+        {
+            if (dx_file_verify_worker(dexfile)) break;
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (dexfile) dx_file_exit((dx_file_ref_t)dexfile);
+        dexfile = tb_null;
+    }
+
+    // trace
+    tb_trace_d("load dex: %s", ok? "ok" : "no");
+
+    // ok?
+    return (dx_file_ref_t)dexfile;
+}
+dx_file_ref_t dx_file_load_from_zip(tb_char_t const* url, tb_char_t const* entry, tb_size_t checksum)
+{
+    // check
+    tb_assert_and_check_return_val(url && entry, tb_null);
+
+    // init zip archive
+    dx_zip_t zip;
+    if (!dx_zip_init(&zip, url)) return tb_null;
+
+    // load dex from this entry
+    dx_file_ref_t dexfile = dx_zip_load(&zip, entry, checksum);
+
+    // exit zip archive, the entry data has been mapped or copied
+    dx_zip_exit(&zip);
+
+    // ok?
+    return dexfile;
+}
+tb_size_t dx_file_load_batch(tb_char_t const** urls, tb_size_t size, dx_file_batch_opt_ref_t opt, dx_file_batch_func_t func, tb_cpointer_t udata)
+{
+    // check
+    tb_assert_and_check_return_val(urls && func, 0);
+    tb_check_return_val(size, 0);
+
+    // get the worker count and the queue size
+    tb_size_t nthreads  = opt? opt->nthreads : 0;
+    tb_size_t maxn      = opt? opt->maxn : 0;
+    if (!nthreads) nthreads = tb_processor_count();
+    nthreads = tb_min(nthreads, size);
+    nthreads = tb_min(nthreads, DX_FILE_LOAD_WORKER_MAXN);
+    if (!nthreads) nthreads = 1;
+    if (!maxn) maxn = nthreads << 1;
+
+    // init batch
+    tb_size_t           i = 0;
+    tb_size_t           loaded = 0;
+    tb_thread_ref_t     threads[DX_FILE_LOAD_WORKER_MAXN] = {0};
+    tb_thread_ref_t     reader = tb_null;
+    dx_file_batch_t     batch;
+    tb_memset(&batch, 0, sizeof(dx_file_batch_t));
+    batch.urls      = urls;
+    batch.size      = size;
+    batch.checksum  = opt? opt->checksum : DX_FILE_CHECKSUM_SYNC;
+    batch.maxn      = maxn + 1;
+    do
+    {
+        // init the ready queue
+        batch.items = tb_nalloc0_type(batch.maxn, dx_file_batch_item_t);
+        tb_assert_and_check_break(batch.items);
+
+        batch.slots = tb_semaphore_init(maxn);
+        batch.ready = tb_semaphore_init(0);
+        tb_assert_and_check_break(batch.slots && batch.ready);
+
+        if (!tb_spinlock_init(&batch.lock)) break;
+
+        // start the io_uring reader if be enabled, we use the default io if it is not supported
+        if (opt && opt->io == DX_FILE_BATCH_IO_URING)
+        {
+            batch.nthreads  = nthreads;
+            batch.rmaxn     = maxn + nthreads + 1;
+            batch.rqueue    = tb_nalloc0_type(batch.rmaxn, dx_file_batch_read_t);
+            batch.paths     = tb_nalloc0_type(size, tb_char_t const*);
+            batch.reads     = tb_semaphore_init(0);
+            if (batch.rqueue && batch.paths && batch.reads) batch.uring = dx_uring_init(maxn);
+            if (batch.uring)
+            {
+                for (i = 0; i < size; i++) batch.paths[i] = urls[i]? dx_mmap_path(urls[i]) : tb_null;
+                reader = tb_thread_init(tb_null, dx_file_batch_reader, &batch, 0);
+                if (!reader)
+                {
+                    dx_uring_exit(batch.uring);
+                    batch.uring = tb_null;
+                }
+            }
+        }
+
+        // start workers, they will only parse the read data if the io_uring reader has been started
+        tb_size_t started = 0;
+        for (i = 0; i < nthreads; i++)
+        {
+            threads[i] = tb_thread_init(tb_null, batch.uring? dx_file_batch_parser : dx_file_batch_worker, &batch, 0);
+            if (threads[i]) started++;
+        }
+
+        // pass the results to the callback in the completion order
+        tb_size_t count = 0;
+        tb_bool_t stop  = tb_false;
+        while (started && count < size && !stop)
+        {
+            // wait the next result
+            if (tb_semaphore_wait(batch.ready, -1) <= 0) break;
+
+            // pop it
+            tb_spinlock_enter(&batch.lock);
+            dx_file_batch_item_t item = batch.items[batch.head];
+            batch.head = (batch.head + 1) % batch.maxn;
+            tb_spinlock_leave(&batch.lock);
+
+            // give back the slot before calling the callback, so the next file can be loaded at the same time
+            tb_semaphore_post(batch.slots, 1);
+
+            // done it
+            if (item.file) loaded++;
+            stop = !func(urls[item.index], item.index, item.file, udata);
+            count++;
+        }
+
+        // load them in the current thread if no workers, the io_uring reader has no parsers and need be stopped first
+        if (!started && reader)
+        {
+            tb_atomic_set(&batch.stop, 1);
+            tb_semaphore_post(batch.slots, nthreads + 1);
+        }
+        for (; !started && count < size && !stop; count++)
+        {
+            dx_file_ref_t file = urls[count]? dx_file_load_from_url(urls[count], batch.checksum) : tb_null;
+            if (file) loaded++;
+            stop = !func(urls[count], count, file, udata);
+        }
+
+        // stop and wake up all workers
+        if (count < size)
+        {
+            tb_atomic_set(&batch.stop, 1);
+            tb_semaphore_post(batch.slots, reader? nthreads + 1 : nthreads);
+        }
+
+        // wait the io_uring reader
+        if (reader)
+        {
+            tb_thread_wait(reader, -1, tb_null);
+            tb_thread_exit(reader);
+        }
+
+        // wait workers
+        for (i = 0; i < nthreads; i++)
+        {
+            if (threads[i])
+            {
+                tb_thread_wait(threads[i], -1, tb_null);
+                tb_thread_exit(threads[i]);
+            }
+        }
+
+        // exit the left results which have been not passed to the callback
+        while (batch.head != batch.tail)
+        {
+            if (batch.items[batch.head].file) dx_file_exit(batch.items[batch.head].file);
+            batch.head = (batch.head + 1) % batch.maxn;
+        }
+
+        // exit the left data which have been not parsed
+        while (batch.rhead != batch.rtail)
+        {
+            if (batch.rqueue[batch.rhead].data) tb_align_free(batch.rqueue[batch.rhead].data);
+            batch.rhead = (batch.rhead + 1) % batch.rmaxn;
+        }
+
+        // exit lock
+        tb_spinlock_exit(&batch.lock);
+
+    } while (0);
+
+    // exit the io_uring reader
+    if (batch.uring) dx_uring_exit(batch.uring);
+    if (batch.reads) tb_semaphore_exit(batch.reads);
+    if (batch.rqueue) tb_free(batch.rqueue);
+    if (batch.paths) tb_free(batch.paths);
+
+    // exit the ready queue
+    if (batch.ready) tb_semaphore_exit(batch.ready);
+    if (batch.slots) tb_semaphore_exit(batch.slots);
+    if (batch.items) tb_free(batch.items);
+
+    // trace
+    tb_trace_d("load batch: %lu/%lu files with %lu workers%s", loaded, size, nthreads, reader? " and io_uring" : "");
 
-        // init methods
-        dexfile->methods = (tb_pointer_t*)tb_nalloc0_type(header->method_ids_size, dx_method_t*);
-        tb_assert_and_check_break(dexfile->methods);
+    // ok
+    return loaded;
+}
+tb_bool_t dx_file_probe_from_data(tb_byte_t const* data, tb_size_t size, dx_file_probe_ref_t probe)
+{
+    // check
+    tb_assert_and_check_return_val(data && size && probe, tb_false);
+
+    // probe it
+    dx_file_probe_data_t probe_data = {data, size};
+    return dx_file_probe_done(dx_file_probe_read_data, &probe_data, probe);
+}
+tb_bool_t dx_file_probe_from_url(tb_char_t const* url, dx_file_probe_ref_t probe)
+{
+    // check
+    tb_assert_and_check_return_val(url && probe, tb_false);
+
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_stream_ref_t stream = tb_null;
+    do
+    {
+        // init stream
+        stream = tb_stream_init_from_url(url);
+        tb_assert_and_check_break(stream);
+
+        // open stream
+        if (!tb_stream_open(stream)) break;
 
-        // ok
-        ok = tb_true;
+        // probe it, we only read the header and map_list
+        ok = dx_file_probe_done(dx_file_probe_read_stream, stream, probe);
 
     } while (0);
 
-    // failed?
-    if (!ok)
-    {
-        // exit it
-        if (dexfile) dx_file_exit((dx_file_ref_t)dexfile);
-        dexfile = tb_null;
-    }
-
-    // trace
-    tb_trace_d("load dex: %s", ok? "ok" : "no");
+    // exit stream
+    if (stream) tb_stream_exit(stream);
+    stream = tb_null;
 
     // ok?
-    return (dx_file_ref_t)dexfile;
+    return ok;
 }
 tb_void_t dx_file_exit(dx_file_ref_t file)
 {
@@ -486,39 +1680,214 @@ tb_void_t dx_file_exit(dx_file_ref_t file)
     dx_file_t* dexfile = (dx_file_t*)file;
     tb_assert_and_check_return(dexfile);
 
+    // wait the background verification, it is still reading the file data
+    if (dexfile->verify_thread)
+    {
+        tb_thread_wait(dexfile->verify_thread, -1, tb_null);
+        tb_thread_exit(dexfile->verify_thread);
+        dexfile->verify_thread = tb_null;
+    }
+
+    // exit the verify semaphore
+    if (dexfile->verify_done) tb_semaphore_exit(dexfile->verify_done);
+    dexfile->verify_done = tb_null;
+
     // exit fields
-    if (dexfile->fields) tb_free(dexfile->fields);
-    dexfile->fields = tb_null;
+    dx_ptable_exit(&dexfile->fields);
 
     // exit methods
-    if (dexfile->methods) tb_free(dexfile->methods);
-    dexfile->methods = tb_null;
+    dx_ptable_exit(&dexfile->methods);
+
+    // exit the predecoded codes, they will be freed with the codes arena
+    dx_ptable_exit(&dexfile->predecodes);
+
+    // exit the switch jump tables, they will be freed with the codes arena
+    dx_ptable_exit(&dexfile->switches);
+
+    // exit the control flow graphs, they will be freed with the codes arena
+    dx_ptable_exit(&dexfile->cfgs);
+
+    // exit the codes arena
+    if (dexfile->codes_arena) dx_arena_exit(dexfile->codes_arena);
+    dexfile->codes_arena = tb_null;
 
-    // exit classes
-    if (dexfile->classes)
+    // exit the shared protos
+    if (dexfile->protos) tb_free(dexfile->protos);
+    dexfile->protos = tb_null;
+
+    // exit the class_def indexes of types
+    if (dexfile->type_classes) tb_free(dexfile->type_classes);
+    dexfile->type_classes = tb_null;
+
+    // exit the class lookup table built by ourselves
+    if (dexfile->class_lookup_data) tb_free(dexfile->class_lookup_data);
+    dexfile->class_lookup_data = tb_null;
+    dexfile->class_lookup = tb_null;
+
+    // exit the evictable classes, they are allocated from the heap
+    if (dexfile->cache_stat.maxn)
     {
-        // exit all classes
-        tb_size_t i = 0;
-        for (i = 0; i < dexfile->header->class_defs_size; i++)
+        while (dexfile->cache_head)
         {
-            if (dexfile->classes[i]) tb_free(dexfile->classes[i]);
-            dexfile->classes[i] = tb_null;
+            dx_class_t* dexclass = dexfile->cache_head;
+            dexfile->cache_head = dexclass->lru_next;
+            tb_free(dexclass);
         }
-
-        // exit class cache
-        tb_free(dexfile->classes);
-        dexfile->classes = tb_null;
+        dexfile->cache_tail = tb_null;
+        tb_spinlock_exit(&dexfile->cache_lock);
     }
 
+    // exit class cache
+    if (dexfile->classes) tb_free(dexfile->classes);
+    dexfile->classes = tb_null;
+
+    // exit all classes at once, the arena provided by the caller will be cleared by the caller
+    if (dexfile->arena && dexfile->arena_owned) dx_arena_exit(dexfile->arena);
+    dexfile->arena = tb_null;
+
     // exit the file data
-    if (dexfile->owner && dexfile->base) tb_align_free(dexfile->base);
+    if (dexfile->base)
+    {
+        if (dexfile->owner == DX_FILE_OWNER_MMAP) dx_mmap_exit(dexfile->base, dexfile->base_size);
+        else if (dexfile->owner == DX_FILE_OWNER_ALLOC) tb_align_free(dexfile->base);
+    }
     dexfile->base = tb_null;
+    dexfile->base_size = 0;
     dexfile->data = tb_null;
     dexfile->size = 0;
 
     // exit it
     tb_free(dexfile);
 }
+tb_bool_t dx_file_arena_set(dx_file_ref_t file, dx_arena_ref_t arena)
+{
+    // check
+    dx_file_t* dexfile = (dx_file_t*)file;
+    tb_assert_and_check_return_val(dexfile && arena, tb_false);
+
+    // some classes have been loaded? we cannot change it
+    return dx_pointer_publish((tb_pointer_t*)&dexfile->arena, (tb_pointer_t)arena) == (tb_pointer_t)arena;
+}
+tb_bool_t dx_file_cache_set(dx_file_ref_t file, tb_size_t maxn)
+{
+    // check
+    dx_file_t* dexfile = (dx_file_t*)file;
+    tb_assert_and_check_return_val(dexfile && dexfile->classes && maxn, tb_false);
+
+    // the budget has been set? 
+    tb_check_return_val(!dexfile->cache_stat.maxn, tb_false);
+
+    // some classes have been loaded? we cannot change it
+    tb_size_t class_idx = 0;
+    tb_size_t class_size = dexfile->header->class_defs_size;
+    for (class_idx = 0; class_idx < class_size; class_idx++)
+    {
+        tb_check_return_val(!dx_pointer_get(&dexfile->classes[class_idx]), tb_false);
+    }
+
+    // init lock
+    if (!tb_spinlock_init(&dexfile->cache_lock)) return tb_false;
+
+    // set the budget
+    dexfile->cache_stat.maxn = maxn;
+    return tb_true;
+}
+tb_bool_t dx_file_cache_stat(dx_file_ref_t file, dx_file_cache_stat_ref_t stat)
+{
+    // check
+    dx_file_t* dexfile = (dx_file_t*)file;
+    tb_assert_and_check_return_val(dexfile && stat, tb_false);
+
+    // the used memory of the method codes
+    dx_arena_ref_t  codes_arena = (dx_arena_ref_t)dx_pointer_get((tb_pointer_t const*)&dexfile->codes_arena);
+    tb_size_t       codes = codes_arena? dx_arena_size(codes_arena) : 0;
+
+    // no budget? all classes are cached and never evicted
+    if (!dexfile->cache_stat.maxn)
+    {
+        tb_memset(stat, 0, sizeof(dx_file_cache_stat_t));
+        stat->codes = codes;
+        tb_size_t class_idx = 0;
+        tb_size_t class_size = dexfile->header->class_defs_size;
+        for (class_idx = 0; class_idx < class_size; class_idx++)
+        {
+            dx_class_t* dexclass = (dx_class_t*)dx_pointer_get(&dexfile->classes[class_idx]);
+            if (dexclass) 
+            {
+                stat->size += dx_file_class_memsize(&dexclass->header);
+                stat->count++;
+            }
+        }
+        return tb_true;
+    }
+
+    // get it
+    tb_spinlock_enter(&dexfile->cache_lock);
+    *stat = dexfile->cache_stat;
+    tb_spinlock_leave(&dexfile->cache_lock);
+    stat->codes = codes;
+    return tb_true;
+}
+tb_void_t dx_file_codes_clear(dx_file_ref_t file)
+{
+    // check
+    dx_file_t* dexfile = (dx_file_t*)file;
+    tb_assert_and_check_return(dexfile);
+
+    // no method codes?
+    tb_check_return(dexfile->codes_arena);
+
+    // clear the cached pointers first, and then free all method codes at once
+    dx_ptable_clear(&dexfile->predecodes);
+    dx_ptable_clear(&dexfile->switches);
+    dx_ptable_clear(&dexfile->cfgs);
+    dx_arena_clear(dexfile->codes_arena);
+}
+tb_size_t dx_file_verified(dx_file_ref_t file)
+{
+    // check
+    dx_file_t* dexfile = (dx_file_t*)file;
+    tb_assert_and_check_return_val(dexfile, DX_FILE_VERIFY_NONE);
+
+    // get it
+    return (tb_size_t)tb_atomic_get(&dexfile->verify_state);
+}
+tb_size_t dx_file_verify_wait(dx_file_ref_t file, tb_long_t timeout)
+{
+    // check
+    dx_file_t* dexfile = (dx_file_t*)file;
+    tb_assert_and_check_return_val(dexfile, DX_FILE_VERIFY_NONE);
+
+    // finished?
+    tb_size_t state = (tb_size_t)tb_atomic_get(&dexfile->verify_state);
+    tb_check_return_val(state == DX_FILE_VERIFY_PENDING && dexfile->verify_done, state);
+
+    // wait it, and post it again to wake up the other waiters
+    if (tb_semaphore_wait(dexfile->verify_done, timeout) > 0)
+        tb_semaphore_post(dexfile->verify_done, 1);
+
+    // get the verify state
+    return (tb_size_t)tb_atomic_get(&dexfile->verify_state);
+}
+tb_bool_t dx_file_validated(dx_file_ref_t file)
+{
+    // check
+    dx_file_t* dexfile = (dx_file_t*)file;
+    tb_assert_and_check_return_val(dexfile, tb_false);
+
+    // get it
+    return dexfile->validated;
+}
+tb_bool_t dx_file_validate(dx_file_ref_t file)
+{
+    // check
+    dx_file_t* dexfile = (dx_file_t*)file;
+    tb_assert_and_check_return_val(dexfile && dexfile->header, tb_false);
+
+    // validate it, the accessors will skip the checks after it has been validated
+    if (!dexfile->validated) dexfile->validated = dx_validate_file(dexfile);
+    return dexfile->validated;
+}
 tb_byte_t const* dx_file_data(dx_file_ref_t file)
 {
     // check
@@ -543,6 +1912,9 @@ tb_char_t const* dx_file_type(dx_file_ref_t file, tb_size_t type_idx)
     dx_file_t* dexfile = (dx_file_t*)file;
     tb_assert_and_check_return_val(dexfile, tb_null);
 
+    // check range
+    tb_check_return_val(type_idx < dexfile->header->type_ids_size, tb_null);
+
     // get it
     return dx_file_get_string_by_type_idx(dexfile, type_idx);
 }
@@ -552,25 +1924,67 @@ tb_char_t const* dx_file_string(dx_file_ref_t file, tb_size_t string_idx)
     dx_file_t* dexfile = (dx_file_t*)file;
     tb_assert_and_check_return_val(dexfile, tb_null);
 
+    // check range
+    tb_check_return_val(string_idx < dexfile->header->string_ids_size, tb_null);
+
     // get it
     return dx_file_get_string(dexfile, string_idx);
 }
+tb_long_t dx_file_string_find(dx_file_ref_t file, tb_char_t const* string)
+{
+    // check
+    dx_file_t* dexfile = (dx_file_t*)file;
+    tb_assert_and_check_return_val(dexfile && dexfile->header && string, -1);
+
+    // find it
+    return dx_file_string_find_n(dexfile, string, tb_strlen(string));
+}
+tb_long_t dx_file_type_find(dx_file_ref_t file, tb_char_t const* descriptor)
+{
+    // check
+    dx_file_t* dexfile = (dx_file_t*)file;
+    tb_assert_and_check_return_val(dexfile && dexfile->header && descriptor, -1);
+
+    // find it
+    return dx_file_type_find_n(dexfile, descriptor, tb_strlen(descriptor));
+}
 dx_class_ref_t dx_file_class(dx_file_ref_t file, tb_size_t class_idx)
 {
     // check
     dx_file_t* dexfile = (dx_file_t*)file;
     tb_assert_and_check_return_val(dexfile, tb_null);
 
+    // this dex file has been poisoned by the bad checksum?
+    tb_check_return_val(tb_atomic_get(&dexfile->verify_state) != DX_FILE_VERIFY_FAILED, tb_null);
+
     // done
     tb_bool_t       ok = tb_false;
-    dx_class_t* dexclass = tb_null;
+    dx_class_t*     dexclass = tb_null;
+    dx_arena_ref_t  arena = tb_null;
+    tb_size_t       dexclass_size = 0;
     do
     {
         // check range
         tb_check_break(class_idx < dexfile->header->class_defs_size);
 
         // this class have been cached? return it directly
-        if (dexfile->classes[class_idx]) return (dx_class_ref_t)dexfile->classes[class_idx];
+        dx_class_t* cached = tb_null;
+        if (dexfile->cache_stat.maxn)
+        {
+            // the cached class may be evicted, so we need update the lru list with the lock
+            tb_spinlock_enter(&dexfile->cache_lock);
+            cached = (dx_class_t*)dexfile->classes[class_idx];
+            if (cached) 
+            {
+                dx_file_cache_touch(dexfile, cached);
+                cached->refn++;
+                dexfile->cache_stat.hits++;
+            }
+            else dexfile->cache_stat.misses++;
+            tb_spinlock_leave(&dexfile->cache_lock);
+        }
+        else cached = (dx_class_t*)dx_pointer_get(&dexfile->classes[class_idx]);
+        if (cached) return (dx_class_ref_t)cached;
 
         // the class count
         tb_size_t class_size = dx_file_class_size(file);
@@ -593,14 +2007,16 @@ dx_class_ref_t dx_file_class(dx_file_ref_t file, tb_size_t class_idx)
         if (!dx_file_class_read_header(&stream, &header)) break;
 
         // the dex class data size
-        tb_size_t dexclass_size =   sizeof(dx_class_t) 
-                                +   header.static_fields_size * sizeof(dx_field_t)
-                                +   header.instance_fields_size * sizeof(dx_field_t)
-                                +   header.direct_methods_size * sizeof(dx_method_t)
-                                +   header.virtual_methods_size * sizeof(dx_method_t);
-
-        // make dex class
-        dexclass = (dx_class_t*)tb_malloc0(dexclass_size);
+        dexclass_size = dx_file_class_memsize(&header);
+
+        // make dex class from the heap if it may be evicted, otherwise it will be freed with the arena
+        if (dexfile->cache_stat.maxn) dexclass = (dx_class_t*)tb_malloc0(dexclass_size);
+        else
+        {
+            arena = dx_file_arena(dexfile);
+            tb_assert_and_check_break(arena);
+            dexclass = (dx_class_t*)dx_arena_malloc0(arena, dexclass_size);
+        }
         tb_assert_and_check_break(dexclass);
 
         // init dex class header
@@ -669,25 +2085,220 @@ dx_class_ref_t dx_file_class(dx_file_ref_t file, tb_size_t class_idx)
             if (!dx_file_class_read_method(&stream, &dexclass->virtual_methods[i], dexfile, &index)) break;
         tb_assert_and_check_break(i == header.virtual_methods_size);
 
-        // save this class
-        dexfile->classes[class_idx] = (tb_pointer_t)dexclass;
+        /* publish this class, another thread may have published the same class
+         *
+         * only the published class can publish its fields and methods, 
+         * so they always point to the published class.
+         */
+        if (dexfile->cache_stat.maxn) dexclass = dx_file_cache_insert(dexfile, class_idx, dexclass);
+        else
+        {
+            dx_class_t* published = (dx_class_t*)dx_pointer_publish(&dexfile->classes[class_idx], (tb_pointer_t)dexclass);
+            if (published == dexclass) dx_file_class_publish(dexfile, dexclass);
+            else 
+            {
+                // free our copy and use the published class
+                dx_arena_free(arena, dexclass, dexclass_size);
+                dexclass = published;
+            }
+        }
 
         // ok
         ok = tb_true;
 
     } while (0);
 
-    // failed?
+    // failed? free the class data
     if (!ok)
     {
-        // exit it
-        if (dexclass) tb_free(dexclass);
+        if (dexclass)
+        {
+            if (arena) dx_arena_free(arena, dexclass, dexclass_size);
+            else tb_free(dexclass);
+        }
         dexclass = tb_null;
     }
 
     // ok?
     return (dx_class_ref_t)dexclass;
 }
+tb_bool_t dx_file_visit(dx_file_ref_t file, dx_file_visitor_ref_t visitor, tb_cpointer_t udata)
+{
+    // check
+    dx_file_t* dexfile = (dx_file_t*)file;
+    tb_assert_and_check_return_val(dexfile && dexfile->header && visitor, tb_false);
+
+    // this dex file has been poisoned by the bad checksum?
+    tb_check_return_val(tb_atomic_get(&dexfile->verify_state) != DX_FILE_VERIFY_FAILED, tb_false);
+
+    // need decode members?
+    tb_bool_t members = visitor->on_field || visitor->on_method;
+
+    // visit all classes
+    tb_size_t class_idx = 0;
+    tb_size_t class_size = dexfile->header->class_defs_size;
+    for (class_idx = 0; class_idx < class_size; class_idx++)
+    {
+        // get class_def
+        dx_class_def_ref_t class_def = dx_file_get_class_def(dexfile, class_idx);
+
+        // init the class record
+        dx_file_visit_class_t clazz = {0};
+        clazz.class_idx     = class_idx;
+        clazz.type_idx      = class_def->class_idx;
+        clazz.access_flags  = class_def->access_flags;
+
+        // read class header, the class without data has no members
+        tb_static_stream_t  stream;
+        dx_class_header_t   header = {0};
+        tb_byte_t const*    class_data = dx_file_get_class_data(dexfile, class_def);
+        if (class_data)
+        {
+            if (!tb_static_stream_init(&stream, (tb_byte_t*)class_data, dexfile->data + dexfile->size - class_data)) return tb_false;
+            if (!dx_file_class_read_header(&stream, &header)) return tb_false;
+            clazz.static_fields_size    = header.static_fields_size;
+            clazz.instance_fields_size  = header.instance_fields_size;
+            clazz.direct_methods_size   = header.direct_methods_size;
+            clazz.virtual_methods_size  = header.virtual_methods_size;
+        }
+
+        // visit class
+        if (visitor->on_class && !visitor->on_class(file, &clazz, udata)) return tb_false;
+        if (!class_data || !members) continue;
+
+        // visit fields
+        tb_size_t               i = 0;
+        tb_uint32_t             index = 0;
+        dx_field_t              field;
+        dx_file_visit_field_t   field_record;
+        tb_size_t               fields_size = header.static_fields_size + header.instance_fields_size;
+        for (i = 0; i < fields_size; i++)
+        {
+            // the instance fields start from zero index
+            if (i == header.static_fields_size) index = 0;
+
+            // read field
+            if (!dx_file_class_read_field(&stream, tb_null, &field, dexfile, &index)) return tb_false;
+
+            // visit it
+            field_record.field_idx      = field.field_idx;
+            field_record.access_flags   = field.access_flags;
+            field_record.is_static      = i < header.static_fields_size;
+            if (visitor->on_field && !visitor->on_field(file, &clazz, &field_record, udata)) return tb_false;
+        }
+
+        // visit methods
+        dx_method_t             method;
+        dx_file_visit_method_t  method_record;
+        tb_size_t               methods_size = header.direct_methods_size + header.virtual_methods_size;
+        for (i = 0; i < methods_size; i++)
+        {
+            // the virtual methods start from zero index
+            if (!i || i == header.direct_methods_size) index = 0;
+
+            // read method
+            if (!dx_file_class_read_method(&stream, &method, dexfile, &index)) return tb_false;
+
+            // visit it
+            method_record.method_idx    = method.method_idx;
+            method_record.access_flags  = method.access_flags;
+            method_record.code_off      = method.code_off;
+            method_record.is_direct     = i < header.direct_methods_size;
+            if (visitor->on_method && !visitor->on_method(file, &clazz, &method_record, udata)) return tb_false;
+        }
+    }
+
+    // ok
+    return tb_true;
+}
+tb_size_t dx_file_load_all(dx_file_ref_t file, tb_size_t nthreads, dx_file_load_stat_ref_t stats)
+{
+    // check
+    dx_file_t* dexfile = (dx_file_t*)file;
+    tb_assert_and_check_return_val(dexfile && dexfile->header, 0);
+
+    // get the worker count, we need not more workers than batches
+    tb_size_t class_size = dexfile->header->class_defs_size;
+    if (!nthreads) nthreads = tb_processor_count();
+    nthreads = tb_min(nthreads, (class_size + DX_FILE_LOAD_BATCH - 1) / DX_FILE_LOAD_BATCH);
+    nthreads = tb_min(nthreads, DX_FILE_LOAD_WORKER_MAXN);
+    if (!nthreads) nthreads = 1;
+
+    // init workers
+    tb_size_t               i = 0;
+    tb_atomic_t             next = 0;
+    dx_file_load_worker_t   workers[DX_FILE_LOAD_WORKER_MAXN];
+    tb_thread_ref_t         threads[DX_FILE_LOAD_WORKER_MAXN] = {0};
+    tb_memset(workers, 0, nthreads * sizeof(dx_file_load_worker_t));
+    for (i = 0; i < nthreads; i++)
+    {
+        workers[i].file = file;
+        workers[i].next = &next;
+    }
+
+    // start workers, the first worker runs in the current thread
+    for (i = 1; i < nthreads; i++)
+        threads[i] = tb_thread_init(tb_null, dx_file_load_worker, &workers[i], 0);
+    dx_file_load_worker(&workers[0]);
+
+    // wait workers, the left classes have been loaded by the other workers if some threads were not started
+    for (i = 1; i < nthreads; i++)
+    {
+        if (threads[i])
+        {
+            tb_thread_wait(threads[i], -1, tb_null);
+            tb_thread_exit(threads[i]);
+        }
+    }
+
+    // save statistics
+    if (stats) 
+    {
+        for (i = 0; i < nthreads; i++) stats[i] = workers[i].stat;
+    }
+
+    // trace
+    tb_trace_d("load all: %lu classes with %lu workers", class_size, nthreads);
+
+    // ok
+    return nthreads;
+}
+dx_class_ref_t dx_file_class_from_type(dx_file_ref_t file, tb_size_t type_idx)
+{
+    // check
+    dx_file_t* dexfile = (dx_file_t*)file;
+    tb_assert_and_check_return_val(dexfile, tb_null);
+
+    // get the class_def index
+    tb_long_t class_idx = dx_file_type_class_idx(dexfile, type_idx);
+    tb_check_return_val(class_idx >= 0, tb_null);
+
+    // get class
+    return dx_file_class(file, (tb_size_t)class_idx);
+}
+dx_class_ref_t dx_file_class_find(dx_file_ref_t file, tb_char_t const* descriptor)
+{
+    // check
+    dx_file_t* dexfile = (dx_file_t*)file;
+    tb_assert_and_check_return_val(dexfile && descriptor, tb_null);
+
+    // find the class index
+    tb_long_t class_idx = dx_file_class_lookup_find(dexfile, descriptor);
+    tb_check_return_val(class_idx >= 0, tb_null);
+
+    // get class
+    return dx_file_class(file, (tb_size_t)class_idx);
+}
+tb_void_t dx_file_class_release(dx_file_ref_t file, dx_class_ref_t clazz)
+{
+    // check
+    dx_file_t*  dexfile = (dx_file_t*)file;
+    dx_class_t* dexclass = (dx_class_t*)clazz;
+    tb_assert_and_check_return(dexfile && dexclass && dexclass->dexfile == dexfile);
+
+    // unpin it
+    dx_file_cache_release(dexfile, dexclass->class_def - dexfile->class_defs);
+}
 tb_size_t dx_file_class_size(dx_file_ref_t file)
 {
     // check
@@ -706,18 +2317,57 @@ dx_method_ref_t dx_file_method(dx_file_ref_t file, tb_size_t method_idx)
     // check range
     tb_assert_and_check_return_val(method_idx < dexfile->header->method_ids_size, tb_null);
 
-    // this method have been cached? return it directly
-    if (dexfile->methods[method_idx]) return (dx_method_ref_t)dexfile->methods[method_idx];
+    /* this method have been cached? return it directly
+     *
+     * we need load its class to update the lru list if the classes may be evicted.
+     */
+    dx_method_ref_t method = tb_null;
+    if (!dexfile->cache_stat.maxn)
+    {
+        method = (dx_method_ref_t)dx_ptable_get(&dexfile->methods, method_idx);
+        if (method) return method;
+    }
     
     // get the method id
     dx_method_id_ref_t method_id = dx_file_get_method_id(dexfile, method_idx);
     tb_assert_and_check_return_val(method_id, tb_null);
 
+    // get the class_def index of method, class_idx is a type index
+    tb_long_t class_def_idx = dx_file_type_class_idx(dexfile, method_id->class_idx);
+    tb_check_return_val(class_def_idx >= 0, tb_null);
+
     // load class of method
-    if (!dx_file_class(file, method_id->class_idx)) return tb_null;
+    dx_class_t* dexclass = (dx_class_t*)dx_file_class(file, (tb_size_t)class_def_idx);
+    tb_check_return_val(dexclass, tb_null);
+
+    // this method have been cached? return it directly, its class has been pinned if the classes may be evicted
+    method = (dx_method_ref_t)dx_ptable_get(&dexfile->methods, method_idx);
+    if (method) return method;
+
+    // the class may be publishing its members on another thread, publish them now, the evictable classes have been published with the lock
+    if (!dexfile->cache_stat.maxn) dx_file_class_publish(dexfile, dexclass);
+    method = (dx_method_ref_t)dx_ptable_get(&dexfile->methods, method_idx);
+
+    // not found? unpin its class
+    if (!method) dx_file_cache_release(dexfile, class_def_idx);
+    return method;
+}
+tb_void_t dx_file_method_release(dx_file_ref_t file, dx_method_ref_t method)
+{
+    // check
+    dx_file_t*      dexfile = (dx_file_t*)file;
+    dx_method_t*    dexmethod = (dx_method_t*)method;
+    tb_assert_and_check_return(dexfile && dexmethod && dexmethod->dexfile == dexfile);
+
+    // the classes will be never evicted?
+    tb_check_return(dexfile->cache_stat.maxn);
 
-    // this method have been cached? return it directly
-    return (dx_method_ref_t)dexfile->methods[method_idx];    
+    // get the method id
+    dx_method_id_ref_t method_id = dx_file_get_method_id(dexfile, dexmethod->method_idx);
+    tb_assert_and_check_return(method_id);
+
+    // unpin the class of method
+    dx_file_cache_release(dexfile, dx_file_type_class_idx(dexfile, method_id->class_idx));
 }
 tb_char_t const* dx_file_method_name(dx_file_ref_t file, tb_size_t method_idx)
 {
@@ -725,6 +2375,9 @@ tb_char_t const* dx_file_method_name(dx_file_ref_t file, tb_size_t method_idx)
     dx_file_t* dexfile = (dx_file_t*)file;
     tb_assert_and_check_return_val(dexfile, tb_null);
 
+    // check range
+    tb_check_return_val(method_idx < dexfile->header->method_ids_size, tb_null);
+
     // get the method id
     dx_method_id_ref_t method_id = dx_file_get_method_id(dexfile, method_idx);
     tb_assert_and_check_return_val(method_id, tb_null);
@@ -738,6 +2391,9 @@ tb_char_t const* dx_file_method_descriptor(dx_file_ref_t file, tb_size_t method_
     dx_file_t* dexfile = (dx_file_t*)file;
     tb_assert_and_check_return_val(dexfile && descriptor, tb_null);
 
+    // check range
+    tb_check_return_val(method_idx < dexfile->header->method_ids_size, tb_null);
+
     // get the method id
     dx_method_id_ref_t method_id = dx_file_get_method_id(dexfile, method_idx);
     tb_assert_and_check_return_val(method_id, tb_null);
@@ -757,12 +2413,18 @@ tb_char_t const* dx_file_method_descriptor(dx_file_ref_t file, tb_size_t method_
         tb_size_t param_idx = 0;
         tb_size_t param_size = parameters->size;
         for (param_idx = 0; param_idx < param_size; param_idx++)
-            tb_string_cstrcat(descriptor, dx_file_get_string_by_type_idx(dexfile, dx_file_get_type_idx(parameters, param_idx)));
+        {
+            tb_char_t const* param = dx_file_get_string_by_type_idx(dexfile, dx_file_get_type_idx(parameters, param_idx));
+            tb_check_return_val(param, tb_null);
+            tb_string_cstrcat(descriptor, param);
+        }
     }
 
     // make the descriptor of the return value
+    tb_char_t const* return_type = dx_file_get_string_by_type_idx(dexfile, proto_id->return_type_idx);
+    tb_check_return_val(return_type, tb_null);
     tb_string_cstrcat(descriptor, ")");
-    tb_string_cstrcat(descriptor, dx_file_get_string_by_type_idx(dexfile, proto_id->return_type_idx));
+    tb_string_cstrcat(descriptor, return_type);
 
     // ok?
     return tb_string_size(descriptor)? tb_string_cstr(descriptor) : tb_null;
@@ -773,6 +2435,9 @@ tb_char_t const* dx_file_method_class_descriptor(dx_file_ref_t file, tb_size_t m
     dx_file_t* dexfile = (dx_file_t*)file;
     tb_assert_and_check_return_val(dexfile, tb_null);
 
+    // check range
+    tb_check_return_val(method_idx < dexfile->header->method_ids_size, tb_null);
+
     // get the method id
     dx_method_id_ref_t method_id = dx_file_get_method_id(dexfile, method_idx);
     tb_assert_and_check_return_val(method_id, tb_null);
@@ -789,18 +2454,127 @@ dx_field_ref_t dx_file_field(dx_file_ref_t file, tb_size_t field_idx)
     // check range
     tb_assert_and_check_return_val(field_idx < dexfile->header->field_ids_size, tb_null);
 
-    // this field have been cached? return it directly
-    if (dexfile->fields[field_idx]) return (dx_field_ref_t)dexfile->fields[field_idx];
+    /* this field have been cached? return it directly
+     *
+     * we need load its class to update the lru list if the classes may be evicted.
+     */
+    dx_field_ref_t field = tb_null;
+    if (!dexfile->cache_stat.maxn)
+    {
+        field = (dx_field_ref_t)dx_ptable_get(&dexfile->fields, field_idx);
+        if (field) return field;
+    }
     
     // get the field id
     dx_field_id_ref_t field_id = dx_file_get_field_id(dexfile, field_idx);
     tb_assert_and_check_return_val(field_id, tb_null);
 
+    // get the class_def index of field, class_idx is a type index
+    tb_long_t class_def_idx = dx_file_type_class_idx(dexfile, field_id->class_idx);
+    tb_check_return_val(class_def_idx >= 0, tb_null);
+
     // load class of field
-    if (!dx_file_class(file, field_id->class_idx)) return tb_null;
+    dx_class_t* dexclass = (dx_class_t*)dx_file_class(file, (tb_size_t)class_def_idx);
+    tb_check_return_val(dexclass, tb_null);
+
+    // this field have been cached? return it directly, its class has been pinned if the classes may be evicted
+    field = (dx_field_ref_t)dx_ptable_get(&dexfile->fields, field_idx);
+    if (field) return field;
+
+    // the class may be publishing its members on another thread, publish them now, the evictable classes have been published with the lock
+    if (!dexfile->cache_stat.maxn) dx_file_class_publish(dexfile, dexclass);
+    field = (dx_field_ref_t)dx_ptable_get(&dexfile->fields, field_idx);
+
+    // not found? unpin its class
+    if (!field) dx_file_cache_release(dexfile, class_def_idx);
+    return field;
+}
+tb_void_t dx_file_field_release(dx_file_ref_t file, dx_field_ref_t field)
+{
+    // check
+    dx_file_t*  dexfile = (dx_file_t*)file;
+    dx_field_t* dexfield = (dx_field_t*)field;
+    tb_assert_and_check_return(dexfile && dexfield && dexfield->dexfile == dexfile);
+
+    // the classes will be never evicted?
+    tb_check_return(dexfile->cache_stat.maxn);
+
+    // get the field id
+    dx_field_id_ref_t field_id = dx_file_get_field_id(dexfile, dexfield->field_idx);
+    tb_assert_and_check_return(field_id);
+
+    // unpin the class of field
+    dx_file_cache_release(dexfile, dx_file_type_class_idx(dexfile, field_id->class_idx));
+}
+tb_long_t dx_file_method_find(dx_file_ref_t file, tb_char_t const* class_descriptor, tb_char_t const* name, tb_char_t const* descriptor)
+{
+    // check
+    dx_file_t* dexfile = (dx_file_t*)file;
+    tb_assert_and_check_return_val(dexfile && dexfile->header && class_descriptor && name && descriptor, -1);
+
+    // find the class type, name and proto
+    tb_long_t class_idx = dx_file_type_find(file, class_descriptor);
+    tb_check_return_val(class_idx >= 0, -1);
+
+    tb_long_t name_idx = dx_file_string_find(file, name);
+    tb_check_return_val(name_idx >= 0, -1);
+
+    tb_long_t proto_idx = dx_file_proto_find(dexfile, descriptor);
+    tb_check_return_val(proto_idx >= 0, -1);
+
+    // find it with the binary search, method_ids are sorted by (class_idx, name_idx, proto_idx)
+    tb_size_t l = 0;
+    tb_size_t r = dexfile->header->method_ids_size;
+    while (l < r)
+    {
+        tb_size_t           m = l + ((r - l) >> 1);
+        dx_method_id_ref_t  method_id = dx_file_get_method_id(dexfile, m);
+        tb_long_t           c = (tb_long_t)method_id->class_idx - class_idx;
+        if (!c) c = (tb_long_t)method_id->name_idx - name_idx;
+        if (!c) c = (tb_long_t)method_id->proto_idx - proto_idx;
+
+        if (c < 0) l = m + 1;
+        else if (c > 0) r = m;
+        else return (tb_long_t)m;
+    }
+
+    // not found
+    return -1;
+}
+tb_long_t dx_file_field_find(dx_file_ref_t file, tb_char_t const* class_descriptor, tb_char_t const* name, tb_char_t const* descriptor)
+{
+    // check
+    dx_file_t* dexfile = (dx_file_t*)file;
+    tb_assert_and_check_return_val(dexfile && dexfile->header && class_descriptor && name && descriptor, -1);
+
+    // find the class type, name and field type
+    tb_long_t class_idx = dx_file_type_find(file, class_descriptor);
+    tb_check_return_val(class_idx >= 0, -1);
+
+    tb_long_t name_idx = dx_file_string_find(file, name);
+    tb_check_return_val(name_idx >= 0, -1);
+
+    tb_long_t type_idx = dx_file_type_find(file, descriptor);
+    tb_check_return_val(type_idx >= 0, -1);
+
+    // find it with the binary search, field_ids are sorted by (class_idx, name_idx, type_idx)
+    tb_size_t l = 0;
+    tb_size_t r = dexfile->header->field_ids_size;
+    while (l < r)
+    {
+        tb_size_t           m = l + ((r - l) >> 1);
+        dx_field_id_ref_t   field_id = dx_file_get_field_id(dexfile, m);
+        tb_long_t           c = (tb_long_t)field_id->class_idx - class_idx;
+        if (!c) c = (tb_long_t)field_id->name_idx - name_idx;
+        if (!c) c = (tb_long_t)field_id->type_idx - type_idx;
+
+        if (c < 0) l = m + 1;
+        else if (c > 0) r = m;
+        else return (tb_long_t)m;
+    }
 
-    // this field have been cached? return it directly
-    return (dx_field_ref_t)dexfile->fields[field_idx];  
+    // not found
+    return -1;
 }
 tb_char_t const* dx_file_field_name(dx_file_ref_t file, tb_size_t field_idx)
 {
@@ -808,6 +2582,9 @@ tb_char_t const* dx_file_field_name(dx_file_ref_t file, tb_size_t field_idx)
     dx_file_t* dexfile = (dx_file_t*)file;
     tb_assert_and_check_return_val(dexfile, tb_null);
 
+    // check range
+    tb_check_return_val(field_idx < dexfile->header->field_ids_size, tb_null);
+
     // get the field id
     dx_field_id_ref_t field_id = dx_file_get_field_id(dexfile, field_idx);
     tb_assert_and_check_return_val(field_id, tb_null);
@@ -821,6 +2598,9 @@ tb_char_t const* dx_file_field_descriptor(dx_file_ref_t file, tb_size_t field_id
     dx_file_t* dexfile = (dx_file_t*)file;
     tb_assert_and_check_return_val(dexfile, tb_null);
 
+    // check range
+    tb_check_return_val(field_idx < dexfile->header->field_ids_size, tb_null);
+
     // get the field id
     dx_field_id_ref_t field_id = dx_file_get_field_id(dexfile, field_idx);
     tb_assert_and_check_return_val(field_id, tb_null);
@@ -834,6 +2614,9 @@ tb_char_t const* dx_file_field_class_descriptor(dx_file_ref_t file, tb_size_t fi
     dx_file_t* dexfile = (dx_file_t*)file;
     tb_assert_and_check_return_val(dexfile, tb_null);
 
+    // check range
+    tb_check_return_val(field_idx < dexfile->header->field_ids_size, tb_null);
+
     // get the field id
     dx_field_id_ref_t field_id = dx_file_get_field_id(dexfile, field_idx);
     tb_assert_and_check_return_val(field_id, tb_null);
@@ -884,6 +2667,7 @@ tb_void_t dx_file_dump(dx_file_ref_t file)
         {
             // dump class
             dx_class_dump(clazz);
+            dx_file_class_release(file, clazz);
         }
     }
 }
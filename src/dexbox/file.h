@@ -31,35 +31,456 @@
  */
 __tb_extern_c_enter__
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the maximum worker count of dx_file_load_all()
+#define DX_FILE_LOAD_WORKER_MAXN        (64)
+
+/// the size of the sha-1 signature in the dex header
+#define DX_FILE_SIGNATURE_SIZE          (20)
+
+/*! validate the structure of the dex file when loading it, it can be or-ed with the checksum mode
+ *
+ * e.g. dx_file_load_from_url(url, DX_FILE_CHECKSUM_ASYNC | DX_FILE_VALIDATE)
+ */
+#define DX_FILE_VALIDATE                (0x100)
+
+/// the mask of the checksum mode
+#define DX_FILE_CHECKSUM_MASK           (0xff)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the checksum mode enum, tb_false and tb_true are compatible with it
+typedef enum __dx_file_checksum_e
+{
+    DX_FILE_CHECKSUM_NONE       = 0     //!< not verify checksum
+,   DX_FILE_CHECKSUM_SYNC       = 1     //!< verify checksum before loading returns
+,   DX_FILE_CHECKSUM_ASYNC      = 2     //!< verify checksum on the background thread
+
+}dx_file_checksum_e;
+
+/// the verify state enum
+typedef enum __dx_file_verify_e
+{
+    DX_FILE_VERIFY_NONE         = 0     //!< the checksum was not verified
+,   DX_FILE_VERIFY_PENDING      = 1     //!< the checksum is being verified
+,   DX_FILE_VERIFY_OK           = 2     //!< the checksum is ok
+,   DX_FILE_VERIFY_FAILED       = 3     //!< bad checksum, the dex file has been poisoned
+
+}dx_file_verify_e;
+
+/// the io mode enum of loading dex files in batch
+typedef enum __dx_file_batch_io_e
+{
+    DX_FILE_BATCH_IO_DEFAULT    = 0     //!< map the local file or read it by the stream for each file
+,   DX_FILE_BATCH_IO_URING      = 1     //!< submit the reads of many local files at once with io_uring, uses the default io if it is not supported
+
+}dx_file_batch_io_e;
+
+/// the statistics of one worker for loading all classes
+typedef struct __dx_file_load_stat_t
+{
+    /// the loaded class count
+    tb_size_t               classes;
+
+    /// the loaded field count
+    tb_size_t               fields;
+
+    /// the loaded method count
+    tb_size_t               methods;
+
+    /// the elapsed time of this worker, in microseconds
+    tb_hong_t               time;
+
+}dx_file_load_stat_t, *dx_file_load_stat_ref_t;
+
+/// the statistics of the class cache
+typedef struct __dx_file_cache_stat_t
+{
+    /// the memory budget, in bytes
+    tb_size_t               maxn;
+
+    /// the used memory of the cached classes, fields and methods, in bytes
+    tb_size_t               size;
+
+    /// the cached class count
+    tb_size_t               count;
+
+    /// the hit count
+    tb_size_t               hits;
+
+    /// the miss count, the class is materialized for each miss
+    tb_size_t               misses;
+
+    /// the evicted class count
+    tb_size_t               evictions;
+
+    /// the used memory of the predecoded codes, switch jump tables and control flow graphs, in bytes, they are not in the budget
+    tb_size_t               codes;
+
+}dx_file_cache_stat_t, *dx_file_cache_stat_ref_t;
+
+/// the class record for visiting
+typedef struct __dx_file_visit_class_t
+{
+    /// the class_def index
+    tb_size_t               class_idx;
+
+    /// the type index of this class
+    tb_uint32_t             type_idx;
+
+    /// the access flags
+    tb_uint32_t             access_flags;
+
+    /// the field and method counts
+    tb_uint32_t             static_fields_size;
+    tb_uint32_t             instance_fields_size;
+    tb_uint32_t             direct_methods_size;
+    tb_uint32_t             virtual_methods_size;
+
+}dx_file_visit_class_t, *dx_file_visit_class_ref_t;
+
+/// the field record for visiting
+typedef struct __dx_file_visit_field_t
+{
+    /// the field index
+    tb_uint32_t             field_idx;
+
+    /// the access flags
+    tb_uint32_t             access_flags;
+
+    /// is static field?
+    tb_bool_t               is_static;
+
+}dx_file_visit_field_t, *dx_file_visit_field_ref_t;
+
+/// the method record for visiting
+typedef struct __dx_file_visit_method_t
+{
+    /// the method index
+    tb_uint32_t             method_idx;
+
+    /// the access flags
+    tb_uint32_t             access_flags;
+
+    /// the file offset to the code_item, zero if it is abstract or native
+    tb_uint32_t             code_off;
+
+    /// is direct method?
+    tb_bool_t               is_direct;
+
+}dx_file_visit_method_t, *dx_file_visit_method_ref_t;
+
+/*! the visitor type
+ *
+ * all callbacks are optional, and return tb_false to stop visiting.
+ * the members will not be decoded if on_field and on_method are all tb_null.
+ */
+typedef struct __dx_file_visitor_t
+{
+    /// visit class
+    tb_bool_t               (*on_class)(dx_file_ref_t file, dx_file_visit_class_ref_t clazz, tb_cpointer_t udata);
+
+    /// visit field
+    tb_bool_t               (*on_field)(dx_file_ref_t file, dx_file_visit_class_ref_t clazz, dx_file_visit_field_ref_t field, tb_cpointer_t udata);
+
+    /// visit method
+    tb_bool_t               (*on_method)(dx_file_ref_t file, dx_file_visit_class_ref_t clazz, dx_file_visit_method_ref_t method, tb_cpointer_t udata);
+
+}dx_file_visitor_t, *dx_file_visitor_ref_t;
+
+/// the options of loading dex files in batch
+typedef struct __dx_file_batch_opt_t
+{
+    /// the worker count, uses the processor count if be zero
+    tb_size_t               nthreads;
+
+    /*! the maximum count of the loaded dex files which have been not passed to the callback, uses nthreads * 2 if be zero
+     *
+     * the workers will be blocked until the callback consumes them, so the memory is bounded.
+     */
+    tb_size_t               maxn;
+
+    /// the checksum mode, e.g. DX_FILE_CHECKSUM_SYNC
+    tb_size_t               checksum;
+
+    /*! the io mode, e.g. DX_FILE_BATCH_IO_URING
+     *
+     * the io_uring reader is only available on linux if dexbox was built with the uring option,
+     * and the reads in flight are bounded by maxn too.
+     */
+    tb_size_t               io;
+
+}dx_file_batch_opt_t, *dx_file_batch_opt_ref_t;
+
+/// the probed information of the dex file, it only comes from the header and map_list
+typedef struct __dx_file_probe_t
+{
+    /// the dex version, e.g. 35, 36, 37, ...
+    tb_uint32_t             version;
+
+    /// is it the optimized dex file?
+    tb_bool_t               optimized;
+
+    /// the adler32 checksum stored in the header
+    tb_uint32_t             checksum;
+
+    /// the sha-1 signature stored in the header
+    tb_byte_t               signature[DX_FILE_SIGNATURE_SIZE];
+
+    /// the dex file size stored in the header
+    tb_uint32_t             file_size;
+
+    /// the data section size
+    tb_uint32_t             data_size;
+
+    /// the string count
+    tb_uint32_t             strings;
+
+    /// the type count
+    tb_uint32_t             types;
+
+    /// the proto count
+    tb_uint32_t             protos;
+
+    /// the field count
+    tb_uint32_t             fields;
+
+    /// the method count
+    tb_uint32_t             methods;
+
+    /// the class count
+    tb_uint32_t             classes;
+
+    /// the item count of the map_list, zero if the map_list was not probed
+    tb_uint32_t             map_size;
+
+    /// the class_data_item count in the map_list
+    tb_uint32_t             class_data_items;
+
+    /// the code_item count in the map_list
+    tb_uint32_t             code_items;
+
+}dx_file_probe_t, *dx_file_probe_ref_t;
+
+/*! the callback of loading dex files in batch
+ *
+ * @param url           the url
+ * @param index         the url index
+ * @param file          the loaded dex file, it is owned by the callback and must be exited by dx_file_exit(), tb_null if failed
+ * @param udata         the user data
+ *
+ * @return              tb_false to stop loading
+ */
+typedef tb_bool_t       (*dx_file_batch_func_t)(tb_char_t const* url, tb_size_t index, dx_file_ref_t file, tb_cpointer_t udata);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
 
 /*! load dex file from the url
+ *
+ * the local file will be mapped into memory directly if possible,
+ * so the pages are only read when they are accessed.
  *
  * @param url           the url
- * @param checksum      need verify checksum?
+ * @param checksum      the checksum mode, e.g. DX_FILE_CHECKSUM_SYNC
  *
  * @return              the dex file 
  */
-dx_file_ref_t           dx_file_load_from_url(tb_char_t const* url, tb_bool_t checksum);
+dx_file_ref_t           dx_file_load_from_url(tb_char_t const* url, tb_size_t checksum);
 
 /*! load dex file from the data
+ *
+ * if checksum is DX_FILE_CHECKSUM_ASYNC, it returns before the checksum is verified
+ * and we can get the result from dx_file_verified() or dx_file_verify_wait() later.
+ * the small file will still be verified directly, because starting thread costs more.
+ *
+ * if DX_FILE_VALIDATE is set, the structure of the dex file is validated in one pass before it returns,
+ * the malformed dex file will be rejected and the validated dex file skips the per-access checks.
+ * otherwise, it only reads the header and the accessors check the offsets and indexes when using them,
+ * so the pages of the mapped file are only touched when they are accessed.
  *
  * @param data          the data
  * @param size          the size
- * @param checksum      need verify checksum?
+ * @param checksum      the checksum mode, e.g. DX_FILE_CHECKSUM_SYNC, or-ed with DX_FILE_VALIDATE
+ *
+ * @return              the dex file, tb_null if it is malformed
+ */
+dx_file_ref_t           dx_file_load_from_data(tb_byte_t const* data, tb_size_t size, tb_size_t checksum);
+
+/*! load dex file from the entry of the zip archive, e.g. apk
+ *
+ * the stored and 4-byte aligned entry (e.g. aligned by zipalign) will be mapped from the archive directly,
+ * and the deflated entry will be inflated into the aligned buffer owned by the dex file, no temporary file is used.
+ *
+ * @note inflating entries requires the zip module and zlib package of tbox.
+ *
+ * @param url           the archive url
+ * @param entry         the entry name, e.g. "classes.dex"
+ * @param checksum      the checksum mode, e.g. DX_FILE_CHECKSUM_SYNC
  *
  * @return              the dex file 
  */
-dx_file_ref_t           dx_file_load_from_data(tb_byte_t const* data, tb_size_t size, tb_bool_t checksum);
+dx_file_ref_t           dx_file_load_from_zip(tb_char_t const* url, tb_char_t const* entry, tb_size_t checksum);
+
+/*! load many dex files in batch with the worker pool
+ *
+ * the workers read and verify dex files concurrently, and the callback will be called 
+ * on the current thread in the completion order as soon as each dex file is ready.
+ *
+ * @param urls          the urls
+ * @param size          the url count
+ * @param opt           the options, uses the default options if be tb_null
+ * @param func          the callback
+ * @param udata         the user data
+ *
+ * @return              the loaded dex file count
+ */
+tb_size_t               dx_file_load_batch(tb_char_t const** urls, tb_size_t size, dx_file_batch_opt_ref_t opt, dx_file_batch_func_t func, tb_cpointer_t udata);
+
+/*! probe the dex file from the given data
+ *
+ * it only reads the header and map_list into the given probe without any allocation,
+ * the map_list will be skipped if it is not in the given data, so we can pass only the first few KB of the file.
+ *
+ * @param data          the dex data, it need not be aligned
+ * @param size          the dex size
+ * @param probe         the probe
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               dx_file_probe_from_data(tb_byte_t const* data, tb_size_t size, dx_file_probe_ref_t probe);
+
+/*! probe the dex file from the given url
+ *
+ * it only reads the header and map_list instead of the whole file.
+ *
+ * @param url           the url
+ * @param probe         the probe
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               dx_file_probe_from_url(tb_char_t const* url, dx_file_probe_ref_t probe);
 
 /*! exit the dex file
+ *
+ * it will wait the background checksum verification if it is not finished.
  *
  * @param file          the dex file 
  */
 tb_void_t               dx_file_exit(dx_file_ref_t file);
 
+/*! set the arena for the classes, fields and methods of this dex file
+ *
+ * the dex file will create its own arena if it is not set. 
+ * we can share one arena with many dex files and clear it after these dex files are exited.
+ *
+ * @note it must be called before loading any class, and the arena must be alive until the dex file is exited.
+ * the classes will be not allocated from the arena if the memory budget of the class cache is set.
+ *
+ * @param file          the dex file
+ * @param arena         the arena
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               dx_file_arena_set(dx_file_ref_t file, dx_arena_ref_t arena);
+
+/*! set the memory budget of the class cache
+ *
+ * all classes are cached until the dex file is exited by default.
+ * if the budget is set, the least recently used classes with their fields and methods will be evicted
+ * when the used memory exceeds the budget, and they will be materialized again at the next access.
+ *
+ * the cached classes are allocated from the heap instead of the arena, and the cache is protected by a lock.
+ * the predecoded codes, switch jump tables and control flow graphs of methods are not counted in the budget,
+ * we can get their used memory by dx_file_cache_stat() and drop them by dx_file_codes_clear().
+ *
+ * the returned classes, fields and methods are pinned if the budget is set, and the pinned classes will be not evicted,
+ * so every class, field and method returned by dx_file_class(), dx_file_method() and dx_file_field() and the find interfaces
+ * must be released by dx_file_class_release(), dx_file_method_release() and dx_file_field_release() after using it.
+ * the used memory may exceed the budget while too many classes are pinned.
+ *
+ * @note it must be called before loading any class.
+ *
+ * @param file          the dex file
+ * @param maxn          the memory budget in bytes, it must be not zero
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               dx_file_cache_set(dx_file_ref_t file, tb_size_t maxn);
+
+/*! get the statistics of the class cache
+ *
+ * the hits, misses and evictions are only counted if the memory budget is set.
+ * the used memory of the method codes is always counted.
+ *
+ * @param file          the dex file
+ * @param stat          the statistics
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               dx_file_cache_stat(dx_file_ref_t file, dx_file_cache_stat_ref_t stat);
+
+/*! clear the predecoded codes, switch jump tables and control flow graphs of all methods
+ *
+ * they are allocated from their own arena of this dex file and never evicted with the classes,
+ * so the long-running process can drop them to free the memory, they will be built again at the next access.
+ *
+ * @note it must not be called concurrently with any other access to this dex file,
+ * and all predecoded codes, switch jump tables and control flow graphs returned before will be invalid.
+ *
+ * @param file          the dex file
+ */
+tb_void_t               dx_file_codes_clear(dx_file_ref_t file);
+
+/*! get the verify state of the checksum, it does not block
+ *
+ * the dex file is poisoned if the checksum is bad, 
+ * and all the following dx_file_class(), dx_file_method() and dx_file_field() will return tb_null.
+ *
+ * @param file          the dex file
+ *
+ * @return              the verify state, e.g. DX_FILE_VERIFY_OK
+ */
+tb_size_t               dx_file_verified(dx_file_ref_t file);
+
+/*! wait the checksum verification
+ *
+ * @param file          the dex file
+ * @param timeout       the timeout, infinity: -1
+ *
+ * @return              the verify state, DX_FILE_VERIFY_PENDING if timeout
+ */
+tb_size_t               dx_file_verify_wait(dx_file_ref_t file, tb_long_t timeout);
+
+/*! has the structure of the dex file been validated?
+ *
+ * all id tables, string data, type lists, class_data, code_items, static values and annotations 
+ * are checked in one pass by DX_FILE_VALIDATE or dx_file_validate(), then the internal accesses skip all checks.
+ * the instruction widths of code_items are also checked, and the sparse-switch keys must be sorted.
+ *
+ * @param file          the dex file
+ *
+ * @return              tb_true if it is validated
+ */
+tb_bool_t               dx_file_validated(dx_file_ref_t file);
+
+/*! validate the structure of the dex file which was loaded without DX_FILE_VALIDATE
+ *
+ * the validated dex file will skip the per-access checks,
+ * it should be called before the dex file is shared with the other threads.
+ *
+ * @param file          the dex file
+ *
+ * @return              tb_true if it is valid
+ */
+tb_bool_t               dx_file_validate(dx_file_ref_t file);
+
 /*! the dex data
  *
  * @param file          the dex file 
@@ -94,7 +515,36 @@ tb_char_t const*        dx_file_type(dx_file_ref_t file, tb_size_t type_idx);
  */
 tb_char_t const*        dx_file_string(dx_file_ref_t file, tb_size_t string_idx);
 
+/*! find string index with the given string content
+ *
+ * it uses the binary search because string_ids are sorted by the string content.
+ *
+ * @param file          the dex file
+ * @param string        the mutf-8 string
+ *
+ * @return              the string index, -1 if not found
+ */
+tb_long_t               dx_file_string_find(dx_file_ref_t file, tb_char_t const* string);
+
+/*! find type index with the given descriptor
+ *
+ * it uses the binary search because type_ids are sorted by descriptor_idx.
+ *
+ * @param file          the dex file
+ * @param descriptor    the type descriptor, e.g. "Ljava/lang/reflect/Method;"
+ *
+ * @return              the type index, -1 if not found
+ */
+tb_long_t               dx_file_type_find(dx_file_ref_t file, tb_char_t const* descriptor);
+
 /*! get class with the given index
+ *
+ * the class is materialized at the first time and published atomically, 
+ * so one dex file can be shared by multiple threads without any lock.
+ * dx_file_method() and dx_file_field() and the find interfaces are also thread-safe, 
+ * but dx_file_exit() and dx_file_arena_set() must not be called concurrently with them.
+ *
+ * @note if the memory budget is set by dx_file_cache_set(), the returned class is pinned and it must be released by dx_file_class_release().
  *
  * @param file          the dex file
  * @param class_idx     the class index
@@ -103,6 +553,64 @@ tb_char_t const*        dx_file_string(dx_file_ref_t file, tb_size_t string_idx)
  */
 dx_class_ref_t      dx_file_class(dx_file_ref_t file, tb_size_t class_idx);
 
+/*! release the class returned by dx_file_class() and the find interfaces
+ *
+ * it unpins the class if the memory budget is set by dx_file_cache_set(), so it can be evicted again, 
+ * otherwise it does nothing.
+ *
+ * @param file          the dex file
+ * @param clazz         the dex class
+ */
+tb_void_t           dx_file_class_release(dx_file_ref_t file, dx_class_ref_t clazz);
+
+/*! load all classes with multiple threads
+ *
+ * the class_defs are split into batches and decoded by the worker pool, 
+ * and all classes, fields and methods will be cached.
+ *
+ * @param file          the dex file
+ * @param nthreads      the worker count, uses the processor count if be zero, DX_FILE_LOAD_WORKER_MAXN at most
+ * @param stats         the statistics of all workers, it can be tb_null, 
+ *                      or it must have DX_FILE_LOAD_WORKER_MAXN entries at least if nthreads is zero
+ *
+ * @return              the used worker count, zero if failed
+ */
+tb_size_t               dx_file_load_all(dx_file_ref_t file, tb_size_t nthreads, dx_file_load_stat_ref_t stats);
+
+/*! visit all classes, fields and methods
+ *
+ * it decodes class_data_item on the fly into the records on the stack, 
+ * and nothing will be allocated and cached, so it is faster than dx_file_class() for one pass.
+ *
+ * @param file          the dex file
+ * @param visitor       the visitor
+ * @param udata         the user data
+ *
+ * @return              tb_true if all classes have been visited, tb_false if it is stopped or the data is broken
+ */
+tb_bool_t               dx_file_visit(dx_file_ref_t file, dx_file_visitor_ref_t visitor, tb_cpointer_t udata);
+
+/*! get class with the given type index
+ *
+ * @param file          the dex file
+ * @param type_idx      the type index, e.g. method_id->class_idx
+ *
+ * @return              the dex class, tb_null if this type is not defined in this dex file
+ */
+dx_class_ref_t          dx_file_class_from_type(dx_file_ref_t file, tb_size_t type_idx);
+
+/*! find class with the given descriptor
+ *
+ * it uses the class lookup table of the optimized dex file if exists,
+ * otherwise the same hash table will be built when it is called at the first time.
+ *
+ * @param file          the dex file
+ * @param descriptor    the class descriptor, e.g. "Ljava/lang/Object;"
+ *
+ * @return              the dex class, tb_null if not found
+ */
+dx_class_ref_t          dx_file_class_find(dx_file_ref_t file, tb_char_t const* descriptor);
+
 /*! get the class count
  *
  * @param file          the dex file
@@ -124,19 +632,59 @@ tb_size_t               dx_file_class_filename(dx_file_ref_t file, tb_size_t ind
  * @param file          the dex file
  * @param method_idx    the method index
  *
- * @return              the dex method 
+ * @return              the dex method, its class is pinned if the memory budget is set
  */
 dx_method_ref_t      dx_file_method(dx_file_ref_t file, tb_size_t method_idx);
 
+/*! release the method returned by dx_file_method(), it unpins its class if the memory budget is set
+ *
+ * @param file          the dex file
+ * @param method        the dex method
+ */
+tb_void_t           dx_file_method_release(dx_file_ref_t file, dx_method_ref_t method);
+
 /*! get field from the given index
  *
  * @param file          the dex file
  * @param field_idx     the field index
  *
- * @return              the dex field 
+ * @return              the dex field, its class is pinned if the memory budget is set
  */
 dx_field_ref_t      dx_file_field(dx_file_ref_t file, tb_size_t field_idx);
 
+/*! release the field returned by dx_file_field(), it unpins its class if the memory budget is set
+ *
+ * @param file          the dex file
+ * @param field         the dex field
+ */
+tb_void_t           dx_file_field_release(dx_file_ref_t file, dx_field_ref_t field);
+
+/*! find method index with the given class, name and descriptor
+ *
+ * it uses the binary search because method_ids are sorted by (class, name, proto).
+ *
+ * @param file              the dex file
+ * @param class_descriptor  the class descriptor, e.g. "Ljava/lang/Object;"
+ * @param name              the method name, e.g. "toString"
+ * @param descriptor        the method descriptor, e.g. "()Ljava/lang/String;"
+ *
+ * @return                  the method index, -1 if not found
+ */
+tb_long_t               dx_file_method_find(dx_file_ref_t file, tb_char_t const* class_descriptor, tb_char_t const* name, tb_char_t const* descriptor);
+
+/*! find field index with the given class, name and type descriptor
+ *
+ * it uses the binary search because field_ids are sorted by (class, name, type).
+ *
+ * @param file              the dex file
+ * @param class_descriptor  the class descriptor, e.g. "Ljava/lang/System;"
+ * @param name              the field name, e.g. "out"
+ * @param descriptor        the field type descriptor, e.g. "Ljava/io/PrintStream;"
+ *
+ * @return                  the field index, -1 if not found
+ */
+tb_long_t               dx_file_field_find(dx_file_ref_t file, tb_char_t const* class_descriptor, tb_char_t const* name, tb_char_t const* descriptor);
+
 /*! get field name from the given index
  *
  * @param file          the dex file
@@ -25,33 +25,6 @@
 #include "annotation.h"
 #include "../leb128.h"
 
-/* //////////////////////////////////////////////////////////////////////////////////////
- * types
- */
-
-// the dex encoded value type enum
-typedef enum __dx_dex_value_type_e
-{
-    DX_DEX_VALUE_BYTE       = 0x00
-,   DX_DEX_VALUE_SHORT      = 0x02
-,   DX_DEX_VALUE_CHAR       = 0x03
-,   DX_DEX_VALUE_INT        = 0x04
-,   DX_DEX_VALUE_LONG       = 0x06
-,   DX_DEX_VALUE_FLOAT      = 0x10
-,   DX_DEX_VALUE_DOUBLE     = 0x11
-,   DX_DEX_VALUE_STRING     = 0x17
-,   DX_DEX_VALUE_TYPE       = 0x18
-,   DX_DEX_VALUE_FIELD      = 0x19
-,   DX_DEX_VALUE_METHOD     = 0x1a
-,   DX_DEX_VALUE_ENUM       = 0x1b
-,   DX_DEX_VALUE_ARRAY      = 0x1c
-,   DX_DEX_VALUE_ANNOTATION = 0x1d
-,   DX_DEX_VALUE_NULL       = 0x1e
-,   DX_DEX_VALUE_BOOLEAN    = 0x1f
-,   DX_DEX_VALUE_NONE       = 0xff  //< custom, invalid value
-
-}dx_dex_value_type_e;
-
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -119,6 +92,43 @@ static tb_uint64_t dx_annotation_value_read_u64(tb_byte_t const* p, tb_size_t by
     // ok
     return val;
 }
+static tb_bool_t dx_annotation_value_skip(tb_static_stream_ref_t stream)
+{
+    // check
+    tb_check_return_val(tb_static_stream_left(stream), tb_false);
+
+    // the value type and argument
+    tb_byte_t const*    p = tb_static_stream_pos(stream);
+    tb_byte_t           value_type = *p & 0x1f;
+    tb_size_t           value_arg = *p >> 5;
+    if (!tb_static_stream_skip(stream, 1)) return tb_false;
+
+    // skip the value data, the nested depth has been limited by the validator
+    tb_uint32_t size = 0;
+    tb_uint32_t index = 0;
+    switch (value_type)
+    {
+    case DX_DEX_VALUE_ARRAY:
+        {
+            // skip the encoded_array
+            if (!dx_uleb128_read(stream, &size)) return tb_false;
+            while (size--) if (!dx_annotation_value_skip(stream)) return tb_false;
+        }
+        return tb_true;
+    case DX_DEX_VALUE_ANNOTATION:
+        {
+            // skip the encoded_annotation
+            if (!dx_uleb128_read(stream, &index) || !dx_uleb128_read(stream, &size)) return tb_false;
+            while (size--) if (!dx_uleb128_read(stream, &index) || !dx_annotation_value_skip(stream)) return tb_false;
+        }
+        return tb_true;
+    case DX_DEX_VALUE_NULL:
+    case DX_DEX_VALUE_BOOLEAN:
+        return tb_true;
+    default:
+        return tb_static_stream_skip(stream, value_arg + 1);
+    }
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -282,6 +292,11 @@ tb_bool_t dx_annotation_array_next(tb_static_stream_ref_t stream, dx_value_ref_t
     case DX_DEX_VALUE_ENUM:
         value->type = DX_VALUE_OBJECT;
         break;
+    case DX_DEX_VALUE_TYPE:
+    case DX_DEX_VALUE_METHOD_TYPE:
+    case DX_DEX_VALUE_METHOD_HANDLE:
+        value->type = DX_VALUE_OBJECT;
+        break;
 #endif
     case DX_DEX_VALUE_BOOLEAN:
         value->type = DX_VALUE_BOOLEAN;
@@ -290,8 +305,11 @@ tb_bool_t dx_annotation_array_next(tb_static_stream_ref_t stream, dx_value_ref_t
         break;
     case DX_DEX_VALUE_ARRAY:
     case DX_DEX_VALUE_ANNOTATION:
-        tb_assert(0);
-        break;
+        {
+            // skip the nested array or annotation, the stream is still at the value header
+            value->type = DX_VALUE_OBJECT;
+            return dx_annotation_value_skip(stream);
+        }
     case DX_DEX_VALUE_NULL:
         value->type = DX_VALUE_NULL;
         value_width = 0;
@@ -31,6 +31,35 @@
  */
 __tb_extern_c_enter__
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the dex encoded value type enum
+typedef enum __dx_dex_value_type_e
+{
+    DX_DEX_VALUE_BYTE          = 0x00
+,   DX_DEX_VALUE_SHORT         = 0x02
+,   DX_DEX_VALUE_CHAR          = 0x03
+,   DX_DEX_VALUE_INT           = 0x04
+,   DX_DEX_VALUE_LONG          = 0x06
+,   DX_DEX_VALUE_FLOAT         = 0x10
+,   DX_DEX_VALUE_DOUBLE        = 0x11
+,   DX_DEX_VALUE_METHOD_TYPE   = 0x15
+,   DX_DEX_VALUE_METHOD_HANDLE = 0x16
+,   DX_DEX_VALUE_STRING        = 0x17
+,   DX_DEX_VALUE_TYPE          = 0x18
+,   DX_DEX_VALUE_FIELD         = 0x19
+,   DX_DEX_VALUE_METHOD        = 0x1a
+,   DX_DEX_VALUE_ENUM          = 0x1b
+,   DX_DEX_VALUE_ARRAY         = 0x1c
+,   DX_DEX_VALUE_ANNOTATION    = 0x1d
+,   DX_DEX_VALUE_NULL          = 0x1e
+,   DX_DEX_VALUE_BOOLEAN       = 0x1f
+,   DX_DEX_VALUE_NONE          = 0xff  //< custom, invalid value
+
+}dx_dex_value_type_e;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -77,6 +77,16 @@ typedef struct __dx_class_t
     // the virtual methods
     dx_method_t*            virtual_methods;
 
+    // the previous and next class in the lru list, only for the class cache with the memory budget
+    struct __dx_class_t*    lru_prev;
+    struct __dx_class_t*    lru_next;
+
+    // the pinned count, only for the class cache with the memory budget, the pinned class will be not evicted
+    tb_size_t               refn;
+
+    // have all fields and methods been published to the dex file?
+    tb_atomic_t             published;
+
 }dx_class_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
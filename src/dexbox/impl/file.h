@@ -25,6 +25,9 @@
  * includes
  */
 #include "prefix.h"
+#include "ptable.h"
+#include "../file.h"
+#include "../arena.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -68,10 +71,31 @@ __tb_extern_c_enter__
 // the optimized dex chunk code: AEND
 #define DX_OPT_CHUNK_END            (0x41454e44)
 
+// the map item types
+#define DX_MAP_TYPE_HEADER_ITEM     (0x0000)
+#define DX_MAP_TYPE_STRING_ID_ITEM  (0x0001)
+#define DX_MAP_TYPE_TYPE_ID_ITEM    (0x0002)
+#define DX_MAP_TYPE_PROTO_ID_ITEM   (0x0003)
+#define DX_MAP_TYPE_FIELD_ID_ITEM   (0x0004)
+#define DX_MAP_TYPE_METHOD_ID_ITEM  (0x0005)
+#define DX_MAP_TYPE_CLASS_DEF_ITEM  (0x0006)
+#define DX_MAP_TYPE_MAP_LIST        (0x1000)
+#define DX_MAP_TYPE_CLASS_DATA_ITEM (0x2000)
+#define DX_MAP_TYPE_CODE_ITEM       (0x2001)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
+// the dex file data owner enum
+typedef enum __dx_file_owner_e
+{
+    DX_FILE_OWNER_NONE      = 0     //!< the data is provided by the caller
+,   DX_FILE_OWNER_ALLOC     = 1     //!< the data is allocated by tb_align_malloc
+,   DX_FILE_OWNER_MMAP      = 2     //!< the data is mapped from the local file
+
+}dx_file_owner_e;
+
 // the dex header type
 typedef struct __dx_header_t
 {
@@ -300,6 +324,34 @@ typedef struct __dx_type_list_t
 
 }dx_type_list_t, *dx_type_list_ref_t;
 
+// the dex map item type: map_item
+typedef struct __dx_map_item_t
+{
+    // the item type
+    tb_uint16_t             type;
+
+    // unused
+    tb_uint16_t             unused;
+
+    // the item count
+    tb_uint32_t             size;
+
+    // file offset to the items
+    tb_uint32_t             offset;
+
+}dx_map_item_t, *dx_map_item_ref_t;
+
+// the dex map list type: map_list
+typedef struct __dx_map_list_t
+{
+    // the list size
+    tb_uint32_t             size;
+
+    // the list
+    dx_map_item_t           list[1];
+
+}dx_map_list_t, *dx_map_list_ref_t;
+
 // the dex file type
 typedef struct __dx_file_t
 {
@@ -312,8 +364,17 @@ typedef struct __dx_file_t
     // the dex size
     tb_size_t               size;
 
-    // is owner of the file data?
-    tb_bool_t               owner;
+    // the base size, only for unmapping the base data
+    tb_size_t               base_size;
+
+    // the owner of the base data
+    tb_size_t               owner;
+
+    /* has the structure of this dex file been validated? 
+     *
+     * all offsets and indexes in it are valid, so the accessors need not check them.
+     */
+    tb_bool_t               validated;
 
     // the dex header
     dx_header_ref_t         header;
@@ -348,14 +409,62 @@ typedef struct __dx_file_t
     dx_class_lookup_ref_t   class_lookup;
     tb_cpointer_t           register_map_pool;
 
+    // the class lookup table built by ourselves if there is no CLKP chunk
+    tb_pointer_t            class_lookup_data;
+
     // the classes 
     tb_pointer_t*           classes;
 
-    // the methods 
-    tb_pointer_t*           methods;
+    // the methods, they are allocated lazily by pages
+    dx_ptable_t             methods;
+
+    // the predecoded codes of methods, method_idx => dx_code_predecode_t, they are allocated from the codes arena
+    dx_ptable_t             predecodes;
+
+    // the switch jump tables of methods, method_idx => dx_code_switches_t, they are allocated from the codes arena
+    dx_ptable_t             switches;
+
+    // the control flow graphs of methods, method_idx => dx_cfg_t, they are allocated from the codes arena
+    dx_ptable_t             cfgs;
+
+    // the fields, they are allocated lazily by pages
+    dx_ptable_t             fields;
+
+    // the protos shared by all methods, dx_proto_t[proto_ids_size]
+    tb_pointer_t            protos;
+
+    // the arena for the classes, fields and methods
+    dx_arena_ref_t          arena;
+
+    // is the arena owned by this dex file?
+    tb_bool_t               arena_owned;
+
+    // the arena for the predecoded codes, switch jump tables and control flow graphs, it is always owned by this dex file
+    dx_arena_ref_t          codes_arena;
+
+    // the statistics and memory budget of the class cache, the classes will be never evicted if cache_stat.maxn is zero
+    dx_file_cache_stat_t    cache_stat;
+
+    // the lock of the class cache
+    tb_spinlock_t           cache_lock;
+
+    // the most recently used class
+    struct __dx_class_t*    cache_head;
+
+    // the least recently used class
+    struct __dx_class_t*    cache_tail;
+
+    // the class_def indexes of all types, type_idx => class_def_idx, (tb_uint32_t)-1 if it is not defined in this dex
+    tb_uint32_t*            type_classes;
+
+    // the verify state of the checksum
+    tb_atomic_t             verify_state;
 
-    // the fields 
-    tb_pointer_t*           fields;
+    // the background thread for verifying checksum
+    tb_thread_ref_t         verify_thread;
+
+    // the semaphore for waiting the verification
+    tb_semaphore_ref_t      verify_done;
 
 }dx_file_t;
 
@@ -363,6 +472,69 @@ typedef struct __dx_file_t
  * inlines
  */
 
+/* get the arena of this dex file, it will be created at the first time if it is not set
+ *
+ * @param dexfile       the dex file
+ *
+ * @return              the arena
+ */
+static __tb_inline__ dx_arena_ref_t dx_file_arena(dx_file_t* dexfile)
+{
+    // init the arena of this dex file at the first time
+    dx_arena_ref_t arena = (dx_arena_ref_t)dx_pointer_get((tb_pointer_t const*)&dexfile->arena);
+    if (!arena)
+    {
+        // make a new arena
+        dx_arena_ref_t arena_new = dx_arena_init(0);
+        tb_assert_and_check_return_val(arena_new, tb_null);
+
+        // publish it, another thread may have published its arena
+        arena = (dx_arena_ref_t)dx_pointer_publish((tb_pointer_t*)&dexfile->arena, (tb_pointer_t)arena_new);
+        if (arena == arena_new) dexfile->arena_owned = tb_true;
+        else dx_arena_exit(arena_new);
+    }
+    return arena;
+}
+
+/* get the arena of the method codes, it will be created at the first time
+ *
+ * the predecoded codes, switch jump tables and control flow graphs are allocated from it,
+ * so they can be dropped without the classes by dx_file_codes_clear().
+ *
+ * @param dexfile       the dex file
+ *
+ * @return              the arena
+ */
+static __tb_inline__ dx_arena_ref_t dx_file_codes_arena(dx_file_t* dexfile)
+{
+    // init the codes arena at the first time
+    dx_arena_ref_t arena = (dx_arena_ref_t)dx_pointer_get((tb_pointer_t const*)&dexfile->codes_arena);
+    if (!arena)
+    {
+        // make a new arena
+        dx_arena_ref_t arena_new = dx_arena_init(0);
+        tb_assert_and_check_return_val(arena_new, tb_null);
+
+        // publish it, another thread may have published its arena
+        arena = (dx_arena_ref_t)dx_pointer_publish((tb_pointer_t*)&dexfile->codes_arena, (tb_pointer_t)arena_new);
+        if (arena != arena_new) dx_arena_exit(arena_new);
+    }
+    return arena;
+}
+
+/* compute the hash code of the class descriptor, it is the same as the CLKP chunk of the odex
+ *
+ * @param descriptor    the class descriptor, e.g. "Ljava/lang/Object;"
+ *
+ * @return              the hash code
+ */
+static __tb_inline__ tb_uint32_t dx_file_class_descriptor_hash(tb_char_t const* descriptor)
+{
+    tb_uint32_t hash = 1;
+    while (*descriptor) hash = hash * 31 + *((tb_byte_t const*)descriptor++);
+    return hash;
+}
+
 /* return the class_def with the given index 
  *
  * @param dexfile   the dex file
@@ -390,6 +562,7 @@ static __tb_inline__ tb_byte_t const* dx_file_get_class_data(dx_file_t* dexfile,
 {
     // check
     tb_check_return_val(class_def->class_data_off, tb_null);
+    tb_check_return_val(dexfile->validated || class_def->class_data_off < dexfile->size, tb_null);
 
     // get it
     return (tb_byte_t const*)(dexfile->data + class_def->class_data_off);
@@ -404,8 +577,8 @@ static __tb_inline__ tb_byte_t const* dx_file_get_class_data(dx_file_t* dexfile,
  */
 static __tb_inline__ dx_type_id_ref_t dx_file_get_type_id(dx_file_t* dexfile, tb_size_t idx) 
 {
-    // check
-    tb_assert(idx < dexfile->header->type_ids_size);
+    // the indexes in the validated dex file need not be checked
+    tb_check_return_val(dexfile->validated || idx < dexfile->header->type_ids_size, tb_null);
 
     // get it
     return &dexfile->type_ids[idx];
@@ -420,8 +593,8 @@ static __tb_inline__ dx_type_id_ref_t dx_file_get_type_id(dx_file_t* dexfile, tb
  */
 static __tb_inline__ dx_proto_id_ref_t dx_file_get_proto_id(dx_file_t* dexfile, tb_size_t idx) 
 {
-    // check
-    tb_assert(idx < dexfile->header->proto_ids_size);
+    // the indexes in the validated dex file need not be checked
+    tb_check_return_val(dexfile->validated || idx < dexfile->header->proto_ids_size, tb_null);
 
     // get it
     return &dexfile->proto_ids[idx];
@@ -436,8 +609,8 @@ static __tb_inline__ dx_proto_id_ref_t dx_file_get_proto_id(dx_file_t* dexfile,
  */
 static __tb_inline__ dx_field_id_ref_t dx_file_get_field_id(dx_file_t* dexfile, tb_size_t idx) 
 {
-    // check
-    tb_assert(idx < dexfile->header->field_ids_size);
+    // the indexes in the validated dex file need not be checked
+    tb_check_return_val(dexfile->validated || idx < dexfile->header->field_ids_size, tb_null);
 
     // get it
     return &dexfile->field_ids[idx];
@@ -452,8 +625,8 @@ static __tb_inline__ dx_field_id_ref_t dx_file_get_field_id(dx_file_t* dexfile,
  */
 static __tb_inline__ dx_method_id_ref_t dx_file_get_method_id(dx_file_t* dexfile, tb_size_t idx) 
 {
-    // check
-    tb_assert(idx < dexfile->header->method_ids_size);
+    // the indexes in the validated dex file need not be checked
+    tb_check_return_val(dexfile->validated || idx < dexfile->header->method_ids_size, tb_null);
 
     // get it
     return &dexfile->method_ids[idx];
@@ -468,8 +641,8 @@ static __tb_inline__ dx_method_id_ref_t dx_file_get_method_id(dx_file_t* dexfile
  */
 static __tb_inline__ dx_string_id_ref_t dx_file_get_string_id(dx_file_t* dexfile, tb_size_t idx) 
 {
-    // check
-    tb_assert(idx < dexfile->header->string_ids_size);
+    // the indexes in the validated dex file need not be checked
+    tb_check_return_val(dexfile->validated || idx < dexfile->header->string_ids_size, tb_null);
 
     // get it
     return &dexfile->string_ids[idx];
@@ -487,6 +660,14 @@ static __tb_inline__ tb_char_t const* dx_file_get_string_data(dx_file_t* dexfile
     // get data pointer
     tb_byte_t const* p = dexfile->data + string_id->string_data_off;
 
+    // the string data must be terminated in this dex file if it has been not validated
+    if (!dexfile->validated)
+    {
+        tb_check_return_val(string_id->string_data_off < dexfile->size, tb_null);
+        tb_size_t left = dexfile->size - string_id->string_data_off;
+        tb_check_return_val(tb_strnlen((tb_char_t const*)p, left) < left, tb_null);
+    }
+
     // skip the uleb128 length.
     while (*(p++) > 0x7f) ;
 
@@ -505,6 +686,7 @@ static __tb_inline__ tb_char_t const* dx_file_get_string(dx_file_t* dexfile, tb_
 {
     // get string id
     dx_string_id_ref_t string_id = dx_file_get_string_id(dexfile, idx);
+    tb_check_return_val(string_id, tb_null);
 
     // get string data
     return dx_file_get_string_data(dexfile, string_id);
@@ -521,6 +703,7 @@ static __tb_inline__ tb_char_t const* dx_file_get_string_by_type_idx(dx_file_t*
 {
     // get type_id
     dx_type_id_ref_t type_id = dx_file_get_type_id(dexfile, type_idx);
+    tb_check_return_val(type_id, tb_null);
 
     // get string for type_id
     return dx_file_get_string(dexfile, type_id->descriptor_idx);
@@ -537,9 +720,19 @@ static __tb_inline__ dx_type_list_ref_t dx_file_get_proto_parameters(dx_file_t*
 {
     // check
     tb_check_return_val(proto_id->parameters_off, tb_null);
-    
+
     // get it
-    return (dx_type_list_ref_t)(dexfile->data + proto_id->parameters_off);
+    dx_type_list_ref_t list = (dx_type_list_ref_t)(dexfile->data + proto_id->parameters_off);
+
+    // the type list must be in this dex file if it has been not validated
+    if (!dexfile->validated)
+    {
+        tb_check_return_val(proto_id->parameters_off <= dexfile->size - sizeof(tb_uint32_t), tb_null);
+        tb_check_return_val(list->size <= (dexfile->size - proto_id->parameters_off - sizeof(tb_uint32_t)) / sizeof(dx_type_item_t), tb_null);
+    }
+
+    // ok
+    return list;
 }
 
 /* get the static field values from a class
@@ -554,6 +747,7 @@ static __tb_inline__ dx_encoded_array_ref_t dx_file_get_static_field_values(dx_f
 {
     // check
     tb_check_return_val(class_def->static_values_off, tb_null);
+    tb_check_return_val(dexfile->validated || class_def->static_values_off < dexfile->size, tb_null);
     
     // get it
     dx_encoded_array_ref_t array = (dx_encoded_array_ref_t)(dexfile->data + class_def->static_values_off);
@@ -31,6 +31,11 @@
 #include "class.h"
 #include "method.h"
 #include "annotation.h"
+#include "mmap.h"
+#include "ptable.h"
+#include "zip.h"
+#include "uring.h"
+#include "validate.h"
 
 #endif
 
@@ -52,12 +52,6 @@ typedef struct __dx_method_t
     // file offset to a code_item
     tb_uint32_t             code_off; 
 
-    // the code
-    dx_code_t               code;
-
-    // the proto
-    dx_proto_t              proto;
-
 }dx_method_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -69,7 +63,17 @@ static __tb_inline__ dx_code_t* dx_method_get_code(dx_file_t* dexfile, dx_method
     tb_check_return_val(method->code_off, tb_null);
 
     // get it
-    return (dx_code_t*)(dexfile->data + method->code_off);
+    dx_code_t* code = (dx_code_t*)(dexfile->data + method->code_off);
+
+    // the code header and instructions must be in this dex file if it has been not validated
+    if (!dexfile->validated)
+    {
+        tb_check_return_val(method->code_off <= dexfile->size - tb_offsetof(dx_code_t, insns), tb_null);
+        tb_check_return_val(code->insns_size <= (dexfile->size - method->code_off - tb_offsetof(dx_code_t, insns)) >> 1, tb_null);
+    }
+
+    // ok
+    return code;
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,266 @@
+/*!A lightweight dex file parsing library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2015-2020, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        mmap.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "mmap"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "mmap.h"
+#if defined(TB_CONFIG_OS_WINDOWS)
+#   include <windows.h>
+#elif defined(TB_CONFIG_POSIX_HAVE_MMAP)
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_char_t const* dx_mmap_path(tb_char_t const* url)
+{
+    // check
+    tb_assert_and_check_return_val(url, tb_null);
+
+    // file://xxx?
+    if (!tb_strnicmp(url, "file://", 7)) return url + 7;
+
+    // other protocols? e.g. http://, data://, ...
+    tb_char_t const* p = tb_strstr(url, "://");
+    if (p)
+    {
+        // only the drive letter or protocol name can be here
+        tb_char_t const* q = url;
+        while (q < p && ((*q >= 'a' && *q <= 'z') || (*q >= 'A' && *q <= 'Z'))) q++;
+        if (q == p) return tb_null;
+    }
+
+    // it is local file path
+    return url;
+}
+#if defined(TB_CONFIG_OS_WINDOWS)
+tb_byte_t const* dx_mmap_init(tb_char_t const* path, tb_size_t* psize)
+{
+    // check
+    tb_assert_and_check_return_val(path && psize, tb_null);
+
+    // done
+    HANDLE      file = INVALID_HANDLE_VALUE;
+    HANDLE      mapping = tb_null;
+    tb_byte_t*  data = tb_null;
+    do
+    {
+        // open file
+        file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, tb_null, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, tb_null);
+        tb_check_break(file != INVALID_HANDLE_VALUE);
+
+        // get the file size
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || !size.QuadPart || (tb_hize_t)size.QuadPart > TB_MAXU32) break;
+
+        // map file
+        mapping = CreateFileMappingA(file, tb_null, PAGE_READONLY, 0, 0, tb_null);
+        tb_check_break(mapping);
+
+        // map view
+        data = (tb_byte_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        tb_check_break(data);
+
+        // save size
+        *psize = (tb_size_t)size.QuadPart;
+
+    } while (0);
+
+    // the view will keep the mapping alive
+    if (mapping) CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+
+    // trace
+    tb_trace_d("map %s: %p", path, data);
+
+    // ok?
+    return data;
+}
+tb_byte_t const* dx_mmap_init_range(tb_char_t const* path, tb_hize_t offset, tb_size_t size, tb_byte_t const** pbase, tb_size_t* pbase_size)
+{
+    // check
+    tb_assert_and_check_return_val(path && size && pbase && pbase_size, tb_null);
+
+    // the view offset must be aligned by the allocation granularity
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    tb_size_t delta = (tb_size_t)(offset % info.dwAllocationGranularity);
+    offset -= delta;
+
+    // done
+    HANDLE      file = INVALID_HANDLE_VALUE;
+    HANDLE      mapping = tb_null;
+    tb_byte_t*  data = tb_null;
+    do
+    {
+        // open file
+        file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, tb_null, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, tb_null);
+        tb_check_break(file != INVALID_HANDLE_VALUE);
+
+        // check the range
+        LARGE_INTEGER filesize;
+        if (!GetFileSizeEx(file, &filesize) || offset + delta + size > (tb_hize_t)filesize.QuadPart) break;
+
+        // map file
+        mapping = CreateFileMappingA(file, tb_null, PAGE_READONLY, 0, 0, tb_null);
+        tb_check_break(mapping);
+
+        // map view
+        data = (tb_byte_t*)MapViewOfFile(mapping, FILE_MAP_READ, (DWORD)(offset >> 32), (DWORD)offset, delta + size);
+        tb_check_break(data);
+
+        // save the view
+        *pbase      = data;
+        *pbase_size = delta + size;
+
+    } while (0);
+
+    // the view will keep the mapping alive
+    if (mapping) CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+
+    // trace
+    tb_trace_d("map %s: %llu, %lu bytes: %p", path, offset + delta, size, data);
+
+    // ok?
+    return data? data + delta : tb_null;
+}
+tb_void_t dx_mmap_exit(tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return(data);
+
+    // unmap it
+    UnmapViewOfFile((LPCVOID)data);
+}
+#elif defined(TB_CONFIG_POSIX_HAVE_MMAP)
+tb_byte_t const* dx_mmap_init(tb_char_t const* path, tb_size_t* psize)
+{
+    // check
+    tb_assert_and_check_return_val(path && psize, tb_null);
+
+    // open file
+    tb_int_t fd = open(path, O_RDONLY);
+    tb_check_return_val(fd >= 0, tb_null);
+
+    // done
+    tb_byte_t* data = tb_null;
+    do
+    {
+        // get the file size
+        struct stat st = {0};
+        if (fstat(fd, &st) || !S_ISREG(st.st_mode) || st.st_size <= 0 || (tb_hize_t)st.st_size > TB_MAXU32) break;
+
+        // map file, the pages will be faulted in lazily
+        tb_pointer_t p = mmap(tb_null, (tb_size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        tb_check_break(p != MAP_FAILED);
+
+        // save data and size
+        data    = (tb_byte_t*)p;
+        *psize  = (tb_size_t)st.st_size;
+
+    } while (0);
+
+    // the mapping will keep the file alive
+    close(fd);
+
+    // trace
+    tb_trace_d("map %s: %p", path, data);
+
+    // ok?
+    return data;
+}
+tb_byte_t const* dx_mmap_init_range(tb_char_t const* path, tb_hize_t offset, tb_size_t size, tb_byte_t const** pbase, tb_size_t* pbase_size)
+{
+    // check
+    tb_assert_and_check_return_val(path && size && pbase && pbase_size, tb_null);
+
+    // open file
+    tb_int_t fd = open(path, O_RDONLY);
+    tb_check_return_val(fd >= 0, tb_null);
+
+    // the mapping offset must be aligned by the page size
+    tb_size_t delta = (tb_size_t)(offset % tb_page_size());
+    offset -= delta;
+
+    // done
+    tb_byte_t* data = tb_null;
+    do
+    {
+        // check the range
+        struct stat st = {0};
+        if (fstat(fd, &st) || !S_ISREG(st.st_mode) || offset + delta + size > (tb_hize_t)st.st_size) break;
+
+        // map this range, the pages will be faulted in lazily
+        tb_pointer_t p = mmap(tb_null, delta + size, PROT_READ, MAP_PRIVATE, fd, (off_t)offset);
+        tb_check_break(p != MAP_FAILED);
+
+        // save the mapping
+        data        = (tb_byte_t*)p;
+        *pbase      = data;
+        *pbase_size = delta + size;
+
+    } while (0);
+
+    // the mapping will keep the file alive
+    close(fd);
+
+    // trace
+    tb_trace_d("map %s: %llu, %lu bytes: %p", path, offset + delta, size, data);
+
+    // ok?
+    return data? data + delta : tb_null;
+}
+tb_void_t dx_mmap_exit(tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return(data && size);
+
+    // unmap it
+    munmap((tb_pointer_t)data, size);
+}
+#else
+tb_byte_t const* dx_mmap_init(tb_char_t const* path, tb_size_t* psize)
+{
+    // not supported, uses the stream instead of it
+    return tb_null;
+}
+tb_byte_t const* dx_mmap_init_range(tb_char_t const* path, tb_hize_t offset, tb_size_t size, tb_byte_t const** pbase, tb_size_t* pbase_size)
+{
+    // not supported, uses the stream instead of it
+    return tb_null;
+}
+tb_void_t dx_mmap_exit(tb_byte_t const* data, tb_size_t size)
+{
+    tb_trace_noimpl();
+}
+#endif
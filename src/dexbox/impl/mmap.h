@@ -0,0 +1,87 @@
+/*!A lightweight dex file parsing library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2015-2020, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        mmap.h
+ *
+ */
+#ifndef DX_IMPL_MMAP_H
+#define DX_IMPL_MMAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* get the local file path from the given url
+ *
+ * "/tmp/a.dex" and "file:///tmp/a.dex" => "/tmp/a.dex", "http://xxx/a.dex" => tb_null
+ *
+ * @param url       the url
+ *
+ * @return          the local file path, tb_null if it is not a local file
+ */
+tb_char_t const*    dx_mmap_path(tb_char_t const* url);
+
+/* map the whole file into memory with read-only access
+ *
+ * the pages are faulted in only when they are touched.
+ *
+ * @param path      the local file path
+ * @param psize     the mapped size
+ *
+ * @return          the mapped data, tb_null if this file cannot be mapped
+ */
+tb_byte_t const*    dx_mmap_init(tb_char_t const* path, tb_size_t* psize);
+
+/* map the given range of the file into memory with read-only access
+ *
+ * the mapping starts at the page boundary before the offset, so the returned data may be not the mapped address.
+ *
+ * @param path          the local file path
+ * @param offset        the offset of the range
+ * @param size          the size of the range
+ * @param pbase         the mapped address for unmapping it
+ * @param pbase_size    the mapped size for unmapping it
+ *
+ * @return              the mapped data at the offset, tb_null if this range cannot be mapped
+ */
+tb_byte_t const*    dx_mmap_init_range(tb_char_t const* path, tb_hize_t offset, tb_size_t size, tb_byte_t const** pbase, tb_size_t* pbase_size);
+
+/* unmap the mapped data
+ *
+ * @param data      the mapped data
+ * @param size      the mapped size
+ */
+tb_void_t           dx_mmap_exit(tb_byte_t const* data, tb_size_t size);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
+
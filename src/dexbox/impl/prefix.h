@@ -27,6 +27,36 @@
 #include "../prefix.h"
 #include "../value.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+
+/* get the published pointer from the given slot
+ *
+ * @param slot      the pointer slot
+ *
+ * @return          the pointer
+ */
+static __tb_inline__ tb_pointer_t dx_pointer_get(tb_pointer_t const* slot)
+{
+    tb_assert_static(sizeof(tb_atomic_t) == sizeof(tb_pointer_t));
+    return (tb_pointer_t)tb_atomic_get((tb_atomic_t*)slot);
+}
+
+/* publish the pointer to the empty slot, it is safe for multiple threads
+ *
+ * @param slot      the pointer slot
+ * @param data      the pointer
+ *
+ * @return          the published pointer, it is not data if another thread has published it before
+ */
+static __tb_inline__ tb_pointer_t dx_pointer_publish(tb_pointer_t* slot, tb_pointer_t data)
+{
+    tb_long_t expected = 0;
+    if (tb_atomic_compare_and_swap((tb_atomic_t*)slot, &expected, (tb_long_t)data)) return data;
+    return (tb_pointer_t)expected;
+}
+
 #endif
 
 
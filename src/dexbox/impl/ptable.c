@@ -0,0 +1,119 @@
+/*!A lightweight dex file parsing library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2015-2020, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        ptable.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "ptable.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t dx_ptable_init(dx_ptable_ref_t table, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(table, tb_false);
+
+    // init it
+    table->pages = tb_null;
+    table->size  = size;
+    tb_check_return_val(size, tb_true);
+
+    // init the page directory
+    table->pages = tb_nalloc0_type((size + DX_PTABLE_PAGE_MASK) >> DX_PTABLE_PAGE_SHIFT, tb_pointer_t*);
+    tb_assert_and_check_return_val(table->pages, tb_false);
+
+    // ok
+    return tb_true;
+}
+tb_void_t dx_ptable_exit(dx_ptable_ref_t table)
+{
+    // check
+    tb_assert_and_check_return(table);
+
+    // exit all pages
+    if (table->pages)
+    {
+        tb_size_t i = 0;
+        tb_size_t n = (table->size + DX_PTABLE_PAGE_MASK) >> DX_PTABLE_PAGE_SHIFT;
+        for (i = 0; i < n; i++)
+        {
+            if (table->pages[i]) tb_free(table->pages[i]);
+        }
+        tb_free(table->pages);
+    }
+
+    // clear it
+    table->pages = tb_null;
+    table->size  = 0;
+}
+tb_void_t dx_ptable_clear(dx_ptable_ref_t table)
+{
+    // check
+    tb_assert_and_check_return(table);
+
+    // free all pages and keep the page directory
+    if (table->pages)
+    {
+        tb_size_t i = 0;
+        tb_size_t n = (table->size + DX_PTABLE_PAGE_MASK) >> DX_PTABLE_PAGE_SHIFT;
+        for (i = 0; i < n; i++)
+        {
+            if (table->pages[i]) tb_free(table->pages[i]);
+            table->pages[i] = tb_null;
+        }
+    }
+}
+tb_pointer_t dx_ptable_publish(dx_ptable_ref_t table, tb_size_t index, tb_pointer_t data)
+{
+    // check
+    tb_assert_and_check_return_val(table && table->pages && index < table->size && data, tb_null);
+
+    // init this page at the first time
+    tb_pointer_t** ppage = &table->pages[index >> DX_PTABLE_PAGE_SHIFT];
+    tb_pointer_t*  page = (tb_pointer_t*)dx_pointer_get((tb_pointer_t const*)ppage);
+    if (!page)
+    {
+        // make a new page
+        tb_pointer_t* page_new = tb_nalloc0_type(DX_PTABLE_PAGE_SIZE, tb_pointer_t);
+        tb_assert_and_check_return_val(page_new, tb_null);
+
+        // publish it, another thread may have published its page
+        page = (tb_pointer_t*)dx_pointer_publish((tb_pointer_t*)ppage, page_new);
+        if (page != page_new) tb_free(page_new);
+    }
+
+    // publish the pointer
+    return dx_pointer_publish(&page[index & DX_PTABLE_PAGE_MASK], data);
+}
+tb_bool_t dx_ptable_remove(dx_ptable_ref_t table, tb_size_t index, tb_pointer_t data)
+{
+    // check
+    tb_assert_and_check_return_val(table && index < table->size && data, tb_false);
+
+    // get the page, it is never freed until the table is exited
+    tb_pointer_t* page = table->pages? (tb_pointer_t*)dx_pointer_get((tb_pointer_t const*)&table->pages[index >> DX_PTABLE_PAGE_SHIFT]) : tb_null;
+    tb_check_return_val(page, tb_false);
+
+    // remove it if it is still this pointer
+    tb_long_t expected = (tb_long_t)data;
+    return tb_atomic_compare_and_swap((tb_atomic_t*)&page[index & DX_PTABLE_PAGE_MASK], &expected, 0);
+}
@@ -0,0 +1,142 @@
+/*!A lightweight dex file parsing library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2015-2020, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        ptable.h
+ *
+ */
+#ifndef DX_IMPL_PTABLE_H
+#define DX_IMPL_PTABLE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the page size of the pointer table, 256 pointers per page
+#define DX_PTABLE_PAGE_SHIFT        (8)
+#define DX_PTABLE_PAGE_SIZE         (1 << DX_PTABLE_PAGE_SHIFT)
+#define DX_PTABLE_PAGE_MASK         (DX_PTABLE_PAGE_SIZE - 1)
+
+// the failed pointer, it is published to cache the failure and avoid building it again
+#define DX_PTABLE_FAILED            ((tb_pointer_t)1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/* the two-level paged pointer table
+ *
+ * only the page directory is allocated when it is initialized,
+ * and the pages will be allocated when they are written at the first time.
+ */
+typedef struct __dx_ptable_t
+{
+    // the pages
+    tb_pointer_t**          pages;
+
+    // the pointer count
+    tb_size_t               size;
+
+}dx_ptable_t, *dx_ptable_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init the pointer table
+ *
+ * @param table     the pointer table
+ * @param size      the pointer count
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           dx_ptable_init(dx_ptable_ref_t table, tb_size_t size);
+
+/* exit the pointer table
+ *
+ * @param table     the pointer table
+ */
+tb_void_t           dx_ptable_exit(dx_ptable_ref_t table);
+
+/* clear all pointers, the pages will be freed and allocated again when they are written
+ *
+ * it is not safe for multiple threads, the table must not be accessed when it is being cleared.
+ *
+ * @param table     the pointer table
+ */
+tb_void_t           dx_ptable_clear(dx_ptable_ref_t table);
+
+/* publish the pointer to the empty slot, the page will be allocated if it does not exist
+ *
+ * it is safe for multiple threads, the first published pointer will be kept.
+ *
+ * @param table     the pointer table
+ * @param index     the index
+ * @param data      the pointer
+ *
+ * @return          the published pointer, tb_null if failed
+ */
+tb_pointer_t        dx_ptable_publish(dx_ptable_ref_t table, tb_size_t index, tb_pointer_t data);
+
+/* remove the published pointer, the slot will be empty if it is still the given pointer
+ *
+ * @param table     the pointer table
+ * @param index     the index
+ * @param data      the pointer
+ *
+ * @return          tb_true if it has been removed
+ */
+tb_bool_t           dx_ptable_remove(dx_ptable_ref_t table, tb_size_t index, tb_pointer_t data);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+
+/* get the pointer
+ *
+ * @param table     the pointer table
+ * @param index     the index
+ *
+ * @return          the pointer, tb_null if it has been not set
+ */
+static __tb_inline__ tb_pointer_t dx_ptable_get(dx_ptable_ref_t table, tb_size_t index)
+{
+    // check
+    tb_assert(index < table->size);
+
+    // get it, the page and pointer may be published by other threads
+    tb_pointer_t* page = table->pages? (tb_pointer_t*)dx_pointer_get((tb_pointer_t const*)&table->pages[index >> DX_PTABLE_PAGE_SHIFT]) : tb_null;
+    return page? dx_pointer_get(&page[index & DX_PTABLE_PAGE_MASK]) : tb_null;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
+
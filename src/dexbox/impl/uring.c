@@ -0,0 +1,293 @@
+/*!A lightweight dex file parsing library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2015-2020, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        uring.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "uring"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "uring.h"
+#if defined(DX_CONFIG_HAVE_LIBURING) && defined(TB_CONFIG_OS_LINUX)
+#   include <liburing.h>
+#   include <sys/stat.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#   include <errno.h>
+#endif
+
+#if defined(DX_CONFIG_HAVE_LIBURING) && defined(TB_CONFIG_OS_LINUX)
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the io_uring reader type
+typedef struct __dx_uring_t
+{
+    // the ring
+    struct io_uring         ring;
+
+    // the queue depth
+    tb_size_t               depth;
+
+}dx_uring_t;
+
+// the read request type
+typedef struct __dx_uring_req_t
+{
+    // the path index
+    tb_size_t               index;
+
+    // the file descriptor
+    tb_int_t                fd;
+
+    // the file data
+    tb_byte_t*              data;
+
+    // the file size
+    tb_size_t               size;
+
+    // the read size
+    tb_size_t               read;
+
+}dx_uring_req_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t dx_uring_submit(dx_uring_t* uring, dx_uring_req_t* req)
+{
+    // get a submission entry, it will be always ok because the requests are not more than the queue depth
+    struct io_uring_sqe* sqe = io_uring_get_sqe(&uring->ring);
+    tb_assert_and_check_return_val(sqe, tb_false);
+
+    // read the left data
+    io_uring_prep_read(sqe, req->fd, req->data + req->read, (tb_uint32_t)(req->size - req->read), (tb_uint64_t)req->read);
+    io_uring_sqe_set_data(sqe, req);
+    return tb_true;
+}
+static tb_bool_t dx_uring_open(dx_uring_req_t* req, tb_char_t const* path)
+{
+    // open file
+    req->fd = path? open(path, O_RDONLY) : -1;
+    tb_check_return_val(req->fd >= 0, tb_false);
+
+    // get the file size and make data, the data is aligned for dx_file_load_from_data()
+    struct stat st = {0};
+    if (!fstat(req->fd, &st) && S_ISREG(st.st_mode) && st.st_size > 0 && (tb_hize_t)st.st_size <= TB_MAXU32)
+    {
+        req->size = (tb_size_t)st.st_size;
+        req->read = 0;
+        req->data = (tb_byte_t*)tb_align_malloc(req->size, 8);
+    }
+
+    // failed?
+    if (!req->data)
+    {
+        close(req->fd);
+        req->fd = -1;
+        return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+dx_uring_ref_t dx_uring_init(tb_size_t depth)
+{
+    // check
+    tb_assert_and_check_return_val(depth, tb_null);
+
+    // make uring
+    dx_uring_t* uring = tb_malloc0_type(dx_uring_t);
+    tb_assert_and_check_return_val(uring, tb_null);
+
+    // init ring, it may be not supported by the old kernel or be disabled by seccomp
+    tb_int_t ret = io_uring_queue_init((tb_uint32_t)depth, &uring->ring, 0);
+    if (ret < 0)
+    {
+        // trace
+        tb_trace_d("init io_uring failed: %d", ret);
+
+        tb_free(uring);
+        return tb_null;
+    }
+    uring->depth = depth;
+
+    // ok
+    return (dx_uring_ref_t)uring;
+}
+tb_void_t dx_uring_exit(dx_uring_ref_t self)
+{
+    // check
+    dx_uring_t* uring = (dx_uring_t*)self;
+    tb_assert_and_check_return(uring);
+
+    // exit ring
+    io_uring_queue_exit(&uring->ring);
+    tb_free(uring);
+}
+tb_size_t dx_uring_read(dx_uring_ref_t self, tb_char_t const** paths, tb_size_t size, dx_uring_func_t func, tb_cpointer_t udata)
+{
+    // check
+    dx_uring_t* uring = (dx_uring_t*)self;
+    tb_assert_and_check_return_val(uring && paths && func, 0);
+
+    // make requests
+    dx_uring_req_t*     reqs = tb_nalloc0_type(uring->depth, dx_uring_req_t);
+    dx_uring_req_t**    frees = tb_nalloc0_type(uring->depth, dx_uring_req_t*);
+    tb_size_t           i = 0;
+    tb_size_t           nfree = 0;
+    tb_size_t           next = 0;
+    tb_size_t           pending = 0;
+    tb_size_t           count = 0;
+    tb_bool_t           stop = tb_false;
+    do
+    {
+        // check
+        tb_assert_and_check_break(reqs && frees);
+
+        // all requests are free now
+        for (i = 0; i < uring->depth; i++) 
+        {
+            reqs[i].fd = -1;
+            frees[nfree++] = &reqs[i];
+        }
+
+        // read files
+        while ((!stop && next < size) || pending)
+        {
+            // fill the queue with the next files
+            while (!stop && next < size && nfree)
+            {
+                dx_uring_req_t* req = frees[--nfree];
+                req->index  = next++;
+                req->data   = tb_null;
+                if (dx_uring_open(req, paths[req->index]) && dx_uring_submit(uring, req)) pending++;
+                else
+                {
+                    // failed
+                    if (req->fd >= 0) close(req->fd);
+                    if (req->data) tb_align_free(req->data);
+                    req->fd     = -1;
+                    req->data   = tb_null;
+                    frees[nfree++] = req;
+                    if (!func(req->index, tb_null, 0, udata)) stop = tb_true;
+                }
+            }
+            tb_check_continue(pending);
+
+            // submit all reads at once and wait the completed reads
+            tb_int_t ret = io_uring_submit_and_wait(&uring->ring, 1);
+            if (ret < 0 && ret != -EINTR && ret != -EAGAIN) 
+            {
+                // trace
+                tb_trace_e("submit io_uring failed: %d", ret);
+
+                // the pending reads are failed, but we cannot free their data which may be still written by the kernel
+                for (i = 0; i < uring->depth; i++)
+                {
+                    if (reqs[i].fd >= 0 && reqs[i].data)
+                    {
+                        close(reqs[i].fd);
+                        if (!stop && !func(reqs[i].index, tb_null, 0, udata)) stop = tb_true;
+                    }
+                }
+
+                // the left files are failed too
+                for (; !stop && next < size; next++)
+                {
+                    if (!func(next, tb_null, 0, udata)) stop = tb_true;
+                }
+                break;
+            }
+
+            // handle the completed reads
+            struct io_uring_cqe* cqe = tb_null;
+            while (!io_uring_peek_cqe(&uring->ring, &cqe))
+            {
+                dx_uring_req_t* req = (dx_uring_req_t*)io_uring_cqe_get_data(cqe);
+                tb_int_t        res = cqe->res;
+                io_uring_cqe_seen(&uring->ring, cqe);
+                tb_assert_and_check_continue(req);
+
+                // read the left data if it was interrupted or only partially read
+                if (res == -EINTR || res == -EAGAIN || (res > 0 && (req->read += (tb_size_t)res) < req->size))
+                {
+                    if (!stop && dx_uring_submit(uring, req)) continue;
+                    res = -1;
+                }
+
+                // this request is done
+                pending--;
+                close(req->fd);
+                req->fd = -1;
+                frees[nfree++] = req;
+
+                // pass the data to the callback, we need only free it if be stopped
+                if (stop || res <= 0 || req->read != req->size)
+                {
+                    tb_align_free(req->data);
+                    if (!stop && !func(req->index, tb_null, 0, udata)) stop = tb_true;
+                }
+                else
+                {
+                    count++;
+                    if (!func(req->index, req->data, req->size, udata)) stop = tb_true;
+                }
+                req->data = tb_null;
+            }
+        }
+
+    } while (0);
+
+    // exit requests
+    if (frees) tb_free(frees);
+    if (reqs) tb_free(reqs);
+
+    // trace
+    tb_trace_d("read %lu/%lu files", count, size);
+
+    // ok
+    return count;
+}
+#else
+dx_uring_ref_t dx_uring_init(tb_size_t depth)
+{
+    // not supported, uses the stream instead of it
+    return tb_null;
+}
+tb_void_t dx_uring_exit(dx_uring_ref_t uring)
+{
+    // not supported, uses the stream instead of it
+}
+tb_size_t dx_uring_read(dx_uring_ref_t uring, tb_char_t const** paths, tb_size_t size, dx_uring_func_t func, tb_cpointer_t udata)
+{
+    // not supported, uses the stream instead of it
+    return 0;
+}
+#endif
@@ -0,0 +1,92 @@
+/*!A lightweight dex file parsing library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2015-2020, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        uring.h
+ *
+ */
+#ifndef DX_IMPL_URING_H
+#define DX_IMPL_URING_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the io_uring reader ref type
+typedef __dx_typeref__(uring);
+
+/* the callback of reading files
+ *
+ * @param index     the path index
+ * @param data      the file data allocated by tb_align_malloc(size, 8), it is owned by the callback, tb_null if failed
+ * @param size      the file size
+ * @param udata     the user data
+ *
+ * @return          tb_false to stop reading
+ */
+typedef tb_bool_t   (*dx_uring_func_t)(tb_size_t index, tb_byte_t* data, tb_size_t size, tb_cpointer_t udata);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init the io_uring reader
+ *
+ * @param depth     the maximum count of the files which are being read at the same time
+ *
+ * @return          the reader, tb_null if io_uring is not supported, e.g. not linux, no liburing or the old kernel
+ */
+dx_uring_ref_t      dx_uring_init(tb_size_t depth);
+
+/* exit the io_uring reader
+ *
+ * @param uring     the reader
+ */
+tb_void_t           dx_uring_exit(dx_uring_ref_t uring);
+
+/* read the whole local files 
+ *
+ * the reads of many files will be submitted at once, and the callback will be called once for each path
+ * in the completion order until it returns tb_false.
+ *
+ * @param uring     the reader
+ * @param paths     the local file paths, the callback will get tb_null for the null path
+ * @param size      the path count
+ * @param func      the callback
+ * @param udata     the user data
+ *
+ * @return          the read file count
+ */
+tb_size_t           dx_uring_read(dx_uring_ref_t uring, tb_char_t const** paths, tb_size_t size, dx_uring_func_t func, tb_cpointer_t udata);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
+
@@ -0,0 +1,684 @@
+/*!A lightweight dex file parsing library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2015-2020, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        validate.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "validate"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "validate.h"
+#include "annotation.h"
+#include "code.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the no index value
+#define DX_VALIDATE_NO_INDEX            (0xffffffff)
+
+// the endian tag of the little-endian dex file
+#define DX_VALIDATE_ENDIAN_TAG          (0x12345678)
+
+// the size of the code_item header before insns
+#define DX_VALIDATE_CODE_HEADER_SIZE    (16)
+
+// the size of the annotations_directory_item header before the annotation lists
+#define DX_VALIDATE_ANNOTATIONS_HEADER_SIZE (16)
+
+// the maximum count of the typed catch handlers in one encoded_catch_handler
+#define DX_VALIDATE_CATCH_MAXN          (65536)
+
+// the maximum depth of the nested encoded arrays and annotations
+#define DX_VALIDATE_VALUE_DEPTH         (32)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the dex try item type: try_item
+typedef struct __dx_try_item_t
+{
+    // the start address of the block of code covered by this entry
+    tb_uint32_t             start_addr;
+
+    // the number of 16-bit code units covered by this entry
+    tb_uint16_t             insn_count;
+
+    // the offset in bytes from the start of the encoded_catch_hander_list
+    tb_uint16_t             handler_off;
+
+}dx_try_item_t, *dx_try_item_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_bool_t dx_validate_uleb128(tb_byte_t const** pp, tb_byte_t const* e, tb_uint32_t* pvalue)
+{
+    // read the uleb128 value with five bytes at most
+    tb_byte_t const*    p = *pp;
+    tb_byte_t const*    q = p + 5;
+    tb_uint32_t         value = 0;
+    tb_size_t           shift = 0;
+    if (q > e) q = e;
+    while (p < q)
+    {
+        // the fifth byte can only contain the high four bits
+        tb_byte_t b = *p++;
+        if (shift == 28 && b > 0x0f) return tb_false;
+        value |= (tb_uint32_t)(b & 0x7f) << shift;
+        if (!(b & 0x80))
+        {
+            *pp     = p;
+            *pvalue = value;
+            return tb_true;
+        }
+        shift += 7;
+    }
+    return tb_false;
+}
+static __tb_inline__ tb_bool_t dx_validate_sleb128(tb_byte_t const** pp, tb_byte_t const* e, tb_sint32_t* pvalue)
+{
+    // read the sleb128 value with five bytes at most
+    tb_byte_t const*    p = *pp;
+    tb_byte_t const*    q = p + 5;
+    tb_uint32_t         value = 0;
+    tb_size_t           shift = 0;
+    if (q > e) q = e;
+    while (p < q)
+    {
+        tb_byte_t b = *p++;
+        value |= (tb_uint32_t)(b & 0x7f) << shift;
+        shift += 7;
+        if (!(b & 0x80))
+        {
+            // extend the sign bit
+            if (shift < 32 && (b & 0x40)) value |= ~(tb_uint32_t)0 << shift;
+
+            *pp     = p;
+            *pvalue = (tb_sint32_t)value;
+            return tb_true;
+        }
+    }
+    return tb_false;
+}
+static __tb_inline__ tb_bool_t dx_validate_range(dx_file_t* dexfile, tb_uint32_t offset, tb_size_t count, tb_size_t itemsize, tb_size_t align)
+{
+    // the empty range is always valid
+    tb_check_return_val(count, tb_true);
+
+    // check it
+    return !(offset & (align - 1)) && (tb_hize_t)offset + (tb_hize_t)count * itemsize <= dexfile->size;
+}
+static tb_bool_t dx_validate_type_list(dx_file_t* dexfile, tb_uint32_t offset)
+{
+    // no list?
+    tb_check_return_val(offset, tb_true);
+
+    // check the list size
+    if (!dx_validate_range(dexfile, offset, 1, sizeof(tb_uint32_t), 4)) return tb_false;
+
+    // check the list items
+    dx_type_list_ref_t list = (dx_type_list_ref_t)(dexfile->data + offset);
+    if (!dx_validate_range(dexfile, offset + sizeof(tb_uint32_t), list->size, sizeof(dx_type_item_t), 1)) return tb_false;
+
+    // check the type indexes
+    tb_uint32_t i = 0;
+    tb_uint32_t type_ids_size = dexfile->header->type_ids_size;
+    for (i = 0; i < list->size; i++)
+    {
+        if (list->list[i].type_idx >= type_ids_size) return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t dx_validate_catch_handler(dx_file_t* dexfile, dx_code_t const* code, tb_byte_t const** pp, tb_byte_t const* e)
+{
+    // check the handler count, it is negative if there is a catch-all handler
+    tb_sint32_t size = 0;
+    if (!dx_validate_sleb128(pp, e, &size) || size < -DX_VALIDATE_CATCH_MAXN || size > DX_VALIDATE_CATCH_MAXN) return tb_false;
+
+    // check the typed handlers
+    tb_uint32_t type_idx = 0;
+    tb_uint32_t address = 0;
+    tb_sint32_t n = size < 0? -size : size;
+    while (n--)
+    {
+        if (!dx_validate_uleb128(pp, e, &type_idx) || type_idx >= dexfile->header->type_ids_size) return tb_false;
+        if (!dx_validate_uleb128(pp, e, &address) || address >= code->insns_size) return tb_false;
+    }
+
+    // check the catch-all handler
+    return size > 0 || (dx_validate_uleb128(pp, e, &address) && address < code->insns_size);
+}
+static tb_bool_t dx_validate_value(dx_file_t* dexfile, tb_byte_t const** pp, tb_byte_t const* e, tb_size_t type, tb_size_t arg)
+{
+    // get the maximum argument and the index bound of this value type
+    dx_header_ref_t header = dexfile->header;
+    tb_size_t       maxarg = 0;
+    tb_uint32_t     maxidx = 0;
+    switch (type)
+    {
+    case DX_DEX_VALUE_BYTE:             maxarg = 0;                                 break;
+    case DX_DEX_VALUE_SHORT:
+    case DX_DEX_VALUE_CHAR:             maxarg = 1;                                 break;
+    case DX_DEX_VALUE_INT:
+    case DX_DEX_VALUE_FLOAT:
+    case DX_DEX_VALUE_METHOD_HANDLE:    maxarg = 3;                                 break;
+    case DX_DEX_VALUE_LONG:
+    case DX_DEX_VALUE_DOUBLE:           maxarg = 7;                                 break;
+    case DX_DEX_VALUE_METHOD_TYPE:      maxarg = 3; maxidx = header->proto_ids_size;  break;
+    case DX_DEX_VALUE_STRING:           maxarg = 3; maxidx = header->string_ids_size; break;
+    case DX_DEX_VALUE_TYPE:             maxarg = 3; maxidx = header->type_ids_size;   break;
+    case DX_DEX_VALUE_FIELD:
+    case DX_DEX_VALUE_ENUM:             maxarg = 3; maxidx = header->field_ids_size;  break;
+    case DX_DEX_VALUE_METHOD:           maxarg = 3; maxidx = header->method_ids_size; break;
+    case DX_DEX_VALUE_NULL:             return !arg;
+    case DX_DEX_VALUE_BOOLEAN:          return arg <= 1;
+    default:                            return tb_false;
+    }
+
+    // check the value data
+    tb_byte_t const* p = *pp;
+    if (arg > maxarg || (tb_size_t)(e - p) <= arg) return tb_false;
+
+    // check the index
+    if (maxidx)
+    {
+        tb_uint32_t index = 0;
+        tb_size_t   i = 0;
+        for (i = 0; i <= arg; i++) index |= (tb_uint32_t)p[i] << (i << 3);
+        if (index >= maxidx) return tb_false;
+    }
+
+    // skip it
+    *pp = p + arg + 1;
+    return tb_true;
+}
+static tb_bool_t dx_validate_encoded(dx_file_t* dexfile, tb_byte_t const** pp, tb_byte_t const* e, tb_size_t type, tb_size_t depth)
+{
+    // check the annotation type
+    tb_byte_t const*    p = *pp;
+    tb_uint32_t         index = 0;
+    dx_header_ref_t     header = dexfile->header;
+    if (type == DX_DEX_VALUE_ANNOTATION && (!dx_validate_uleb128(&p, e, &index) || index >= header->type_ids_size)) return tb_false;
+
+    /* check all elements of the encoded_array or all name-value pairs of the encoded_annotation,
+     * each element takes one byte at least, so this loop is always bounded by the file size
+     */
+    tb_uint32_t size = 0;
+    if (!dx_validate_uleb128(&p, e, &size)) return tb_false;
+    while (size--)
+    {
+        // check the element name
+        if (type == DX_DEX_VALUE_ANNOTATION && (!dx_validate_uleb128(&p, e, &index) || index >= header->string_ids_size)) return tb_false;
+
+        // get the value type and argument
+        tb_check_return_val(p < e, tb_false);
+        tb_size_t value_type = *p & 0x1f;
+        tb_size_t value_arg  = *p >> 5;
+        p++;
+
+        // check the value
+        if (value_type == DX_DEX_VALUE_ARRAY || value_type == DX_DEX_VALUE_ANNOTATION)
+        {
+            if (value_arg || depth >= DX_VALIDATE_VALUE_DEPTH || !dx_validate_encoded(dexfile, &p, e, value_type, depth + 1)) return tb_false;
+        }
+        else if (!dx_validate_value(dexfile, &p, e, value_type, value_arg)) return tb_false;
+    }
+
+    // ok
+    *pp = p;
+    return tb_true;
+}
+static tb_bool_t dx_validate_static_values(dx_file_t* dexfile, tb_uint32_t offset)
+{
+    // no values?
+    tb_check_return_val(offset, tb_true);
+    tb_check_return_val(offset < dexfile->size, tb_false);
+
+    // check the encoded_array_item
+    tb_byte_t const* p = dexfile->data + offset;
+    return dx_validate_encoded(dexfile, &p, dexfile->data + dexfile->size, DX_DEX_VALUE_ARRAY, 0);
+}
+static tb_bool_t dx_validate_annotation_set(dx_file_t* dexfile, tb_uint32_t offset)
+{
+    // no set?
+    tb_check_return_val(offset, tb_true);
+
+    // check the set size and entries
+    if (!dx_validate_range(dexfile, offset, 1, sizeof(tb_uint32_t), 4)) return tb_false;
+    tb_uint32_t const* set = (tb_uint32_t const*)(dexfile->data + offset);
+    if (!dx_validate_range(dexfile, offset + sizeof(tb_uint32_t), set[0], sizeof(tb_uint32_t), 1)) return tb_false;
+
+    // check the annotation_items, the visibility is build, runtime or system
+    tb_uint32_t         i = 0;
+    tb_byte_t const*    e = dexfile->data + dexfile->size;
+    for (i = 1; i <= set[0]; i++)
+    {
+        if (!set[i] || set[i] >= dexfile->size) return tb_false;
+
+        tb_byte_t const* p = dexfile->data + set[i];
+        if (*p++ > 2 || !dx_validate_encoded(dexfile, &p, e, DX_DEX_VALUE_ANNOTATION, 0)) return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t dx_validate_annotations(dx_file_t* dexfile, tb_uint32_t offset)
+{
+    // no annotations?
+    tb_check_return_val(offset, tb_true);
+
+    // check the annotations_directory_item header
+    if (!dx_validate_range(dexfile, offset, 1, DX_VALIDATE_ANNOTATIONS_HEADER_SIZE, 4)) return tb_false;
+
+    // check the field, method and parameter annotation lists, each item is a pair of index and offset
+    tb_uint32_t const*  directory = (tb_uint32_t const*)(dexfile->data + offset);
+    tb_hize_t           items_size = (tb_hize_t)directory[1] + directory[2] + directory[3];
+    if ((tb_hize_t)offset + DX_VALIDATE_ANNOTATIONS_HEADER_SIZE + (items_size << 3) > dexfile->size) return tb_false;
+
+    // check the class annotations
+    if (!dx_validate_annotation_set(dexfile, directory[0])) return tb_false;
+
+    // check the field and method annotations
+    tb_uint32_t         i = 0;
+    dx_header_ref_t     header = dexfile->header;
+    tb_uint32_t const*  item = directory + 4;
+    for (i = 0; i < directory[1]; i++, item += 2)
+    {
+        if (item[0] >= header->field_ids_size || !dx_validate_annotation_set(dexfile, item[1])) return tb_false;
+    }
+    for (i = 0; i < directory[2]; i++, item += 2)
+    {
+        if (item[0] >= header->method_ids_size || !dx_validate_annotation_set(dexfile, item[1])) return tb_false;
+    }
+
+    // check the parameter annotations, they are the annotation_set_ref_lists
+    for (i = 0; i < directory[3]; i++, item += 2)
+    {
+        if (item[0] >= header->method_ids_size) return tb_false;
+        tb_check_continue(item[1]);
+
+        if (!dx_validate_range(dexfile, item[1], 1, sizeof(tb_uint32_t), 4)) return tb_false;
+        tb_uint32_t const* list = (tb_uint32_t const*)(dexfile->data + item[1]);
+        if (!dx_validate_range(dexfile, item[1] + sizeof(tb_uint32_t), list[0], sizeof(tb_uint32_t), 1)) return tb_false;
+
+        tb_uint32_t j = 0;
+        for (j = 1; j <= list[0]; j++)
+        {
+            if (!dx_validate_annotation_set(dexfile, list[j])) return tb_false;
+        }
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t dx_validate_insns(dx_code_t const* code)
+{
+    // walk all instructions by their widths, the whole instruction must be in the code
+    tb_size_t           pc = 0;
+    tb_size_t           insns_size = code->insns_size;
+    tb_uint16_t const*  insns = code->insns;
+    while (pc < insns_size)
+    {
+        // the payload header must be in the code
+        tb_size_t           left = insns_size - pc;
+        tb_uint16_t const*  instr = insns + pc;
+        if (instr[0] == DX_INSTR_IDENT_SPARSE_SWITCH_PAYLOAD && left < 2) return tb_false;
+        if ((instr[0] == DX_INSTR_IDENT_PACKED_SWITCH_PAYLOAD || instr[0] == DX_INSTR_IDENT_FILL_ARRAY_DATA) && left < 4) return tb_false;
+
+        tb_size_t width = dx_instr_width(instr);
+        if (!width || width > left) return tb_false;
+
+        // the keys of the sparse-switch payload must be sorted
+        if (instr[0] == DX_INSTR_IDENT_SPARSE_SWITCH_PAYLOAD && !dx_instr_sparse_switch_sorted(instr)) return tb_false;
+        pc += width;
+    }
+    return tb_true;
+}
+static tb_bool_t dx_validate_code(dx_file_t* dexfile, tb_uint32_t offset)
+{
+    // no code?
+    tb_check_return_val(offset, tb_true);
+
+    // check the code header
+    if (!dx_validate_range(dexfile, offset, 1, DX_VALIDATE_CODE_HEADER_SIZE, 4)) return tb_false;
+
+    // check the registers
+    dx_code_t const* code = (dx_code_t const*)(dexfile->data + offset);
+    if (code->ins_size > code->registers_size) return tb_false;
+
+    // check the instructions
+    tb_hize_t insns_end = (tb_hize_t)offset + DX_VALIDATE_CODE_HEADER_SIZE + ((tb_hize_t)code->insns_size << 1);
+    if (insns_end > dexfile->size) return tb_false;
+    if (!dx_validate_insns(code)) return tb_false;
+
+    // check the tries and the handler list after them
+    if (code->tries_size)
+    {
+        tb_hize_t tries_off = (insns_end + 3) & ~(tb_hize_t)3;
+        tb_hize_t tries_end = tries_off + (tb_hize_t)code->tries_size * sizeof(dx_try_item_t);
+        if (tries_end >= dexfile->size) return tb_false;
+
+        // check all handlers in the encoded_catch_handler_list
+        tb_uint32_t         i = 0;
+        tb_uint32_t         n = 0;
+        tb_byte_t const*    list = dexfile->data + tries_end;
+        tb_byte_t const*    p = list;
+        tb_byte_t const*    e = dexfile->data + dexfile->size;
+        if (!dx_validate_uleb128(&p, e, &n)) return tb_false;
+        while (n--)
+        {
+            if (!dx_validate_catch_handler(dexfile, code, &p, e)) return tb_false;
+        }
+
+        // check the tries, each handler_off must point to a complete handler in this list
+        tb_size_t           list_size = p - list;
+        dx_try_item_ref_t   tries = (dx_try_item_ref_t)(dexfile->data + tries_off);
+        for (i = 0; i < code->tries_size; i++)
+        {
+            if ((tb_hize_t)tries[i].start_addr + tries[i].insn_count > code->insns_size) return tb_false;
+            if (tries[i].handler_off >= list_size) return tb_false;
+
+            p = list + tries[i].handler_off;
+            if (!dx_validate_catch_handler(dexfile, code, &p, list + list_size)) return tb_false;
+        }
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t dx_validate_class_data(dx_file_t* dexfile, tb_uint32_t offset)
+{
+    // no class data?
+    tb_check_return_val(offset, tb_true);
+    tb_check_return_val(offset < dexfile->size, tb_false);
+
+    // read the class data header
+    tb_byte_t const*    p = dexfile->data + offset;
+    tb_byte_t const*    e = dexfile->data + dexfile->size;
+    tb_uint32_t         sizes[4];
+    tb_size_t           i = 0;
+    for (i = 0; i < 4; i++)
+    {
+        if (!dx_validate_uleb128(&p, e, &sizes[i])) return tb_false;
+    }
+
+    /* check the static fields, instance fields, direct methods and virtual methods,
+     * the index of each list is started from zero and encoded by the difference
+     */
+    tb_uint32_t field_ids_size  = dexfile->header->field_ids_size;
+    tb_uint32_t method_ids_size = dexfile->header->method_ids_size;
+    for (i = 0; i < 4; i++)
+    {
+        tb_uint32_t n = sizes[i];
+        tb_uint32_t maxn = i < 2? field_ids_size : method_ids_size;
+        tb_uint32_t index = 0;
+        tb_uint32_t diff = 0;
+        tb_uint32_t access_flags = 0;
+        tb_uint32_t code_off = 0;
+        while (n--)
+        {
+            // check the index, it is always less than maxn here
+            if (!dx_validate_uleb128(&p, e, &diff) || diff >= maxn - index) return tb_false;
+            index += diff;
+
+            // skip the access flags
+            if (!dx_validate_uleb128(&p, e, &access_flags)) return tb_false;
+
+            // check the code
+            if (i >= 2 && (!dx_validate_uleb128(&p, e, &code_off) || !dx_validate_code(dexfile, code_off))) return tb_false;
+        }
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t dx_validate_map(dx_file_t* dexfile)
+{
+    // check the map list size
+    dx_header_ref_t header = dexfile->header;
+    if (!header->map_off || !dx_validate_range(dexfile, header->map_off, 1, sizeof(tb_uint32_t), 4)) return tb_false;
+
+    // check the map items
+    dx_map_list_ref_t map = (dx_map_list_ref_t)(dexfile->data + header->map_off);
+    if (!dx_validate_range(dexfile, header->map_off + sizeof(tb_uint32_t), map->size, sizeof(dx_map_item_t), 1)) return tb_false;
+
+    // the map items must be sorted by the offset and the id tables must be the same as the header
+    tb_uint32_t         i = 0;
+    tb_uint32_t         offset = 0;
+    tb_bool_t           has_map = tb_false;
+    dx_map_item_ref_t   item = map->list;
+    for (i = 0; i < map->size; i++, item++)
+    {
+        // check the offset
+        if (item->offset < offset || (item->size && item->offset >= dexfile->size)) return tb_false;
+        offset = item->offset;
+
+        // check the item
+        switch (item->type)
+        {
+        case DX_MAP_TYPE_HEADER_ITEM:
+            if (item->offset || item->size != 1) return tb_false;
+            break;
+        case DX_MAP_TYPE_STRING_ID_ITEM:
+            if (item->offset != header->string_ids_off || item->size != header->string_ids_size) return tb_false;
+            break;
+        case DX_MAP_TYPE_TYPE_ID_ITEM:
+            if (item->offset != header->type_ids_off || item->size != header->type_ids_size) return tb_false;
+            break;
+        case DX_MAP_TYPE_PROTO_ID_ITEM:
+            if (item->offset != header->proto_ids_off || item->size != header->proto_ids_size) return tb_false;
+            break;
+        case DX_MAP_TYPE_FIELD_ID_ITEM:
+            if (item->offset != header->field_ids_off || item->size != header->field_ids_size) return tb_false;
+            break;
+        case DX_MAP_TYPE_METHOD_ID_ITEM:
+            if (item->offset != header->method_ids_off || item->size != header->method_ids_size) return tb_false;
+            break;
+        case DX_MAP_TYPE_CLASS_DEF_ITEM:
+            if (item->offset != header->class_defs_off || item->size != header->class_defs_size) return tb_false;
+            break;
+        case DX_MAP_TYPE_MAP_LIST:
+            if (item->offset != header->map_off || item->size != 1) return tb_false;
+            has_map = tb_true;
+            break;
+        default:
+            // the data items will be checked by the references to them
+            break;
+        }
+    }
+
+    // ok?
+    return has_map;
+}
+static tb_bool_t dx_validate_ids(dx_file_t* dexfile)
+{
+    // check the bounds of all id tables
+    dx_header_ref_t header = dexfile->header;
+    return  dx_validate_range(dexfile, header->string_ids_off,  header->string_ids_size,  sizeof(dx_string_id_t),  4)
+        &&  dx_validate_range(dexfile, header->type_ids_off,    header->type_ids_size,    sizeof(dx_type_id_t),    4)
+        &&  dx_validate_range(dexfile, header->proto_ids_off,   header->proto_ids_size,   sizeof(dx_proto_id_t),   4)
+        &&  dx_validate_range(dexfile, header->field_ids_off,   header->field_ids_size,   sizeof(dx_field_id_t),   4)
+        &&  dx_validate_range(dexfile, header->method_ids_off,  header->method_ids_size,  sizeof(dx_method_id_t),  4)
+        &&  dx_validate_range(dexfile, header->class_defs_off,  header->class_defs_size,  sizeof(dx_class_def_t),  4)
+        &&  header->type_ids_size <= 65536 && header->proto_ids_size <= 65536;
+}
+static tb_bool_t dx_validate_strings(dx_file_t* dexfile)
+{
+    // check all strings, each string must be terminated in this dex file
+    tb_uint32_t         i = 0;
+    tb_uint32_t         n = dexfile->header->string_ids_size;
+    tb_uint32_t         length = 0;
+    tb_byte_t const*    e = dexfile->data + dexfile->size;
+    for (i = 0; i < n; i++)
+    {
+        tb_uint32_t offset = dexfile->string_ids[i].string_data_off;
+        tb_check_return_val(offset < dexfile->size, tb_false);
+
+        tb_byte_t const* p = dexfile->data + offset;
+        if (!dx_validate_uleb128(&p, e, &length)) return tb_false;
+        tb_check_return_val(tb_strnlen((tb_char_t const*)p, e - p) < (tb_size_t)(e - p), tb_false);
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t dx_validate_members(dx_file_t* dexfile)
+{
+    // check types
+    tb_uint32_t     i = 0;
+    dx_header_ref_t header = dexfile->header;
+    tb_uint32_t     string_ids_size = header->string_ids_size;
+    tb_uint32_t     type_ids_size = header->type_ids_size;
+    for (i = 0; i < type_ids_size; i++)
+    {
+        if (dexfile->type_ids[i].descriptor_idx >= string_ids_size) return tb_false;
+    }
+
+    // check protos
+    for (i = 0; i < header->proto_ids_size; i++)
+    {
+        dx_proto_id_ref_t proto_id = &dexfile->proto_ids[i];
+        if (    proto_id->shorty_idx >= string_ids_size
+            ||  proto_id->return_type_idx >= type_ids_size
+            ||  !dx_validate_type_list(dexfile, proto_id->parameters_off))
+            return tb_false;
+    }
+
+    // check fields
+    for (i = 0; i < header->field_ids_size; i++)
+    {
+        dx_field_id_ref_t field_id = &dexfile->field_ids[i];
+        if (    field_id->class_idx >= type_ids_size
+            ||  field_id->type_idx >= type_ids_size
+            ||  field_id->name_idx >= string_ids_size)
+            return tb_false;
+    }
+
+    // check methods
+    for (i = 0; i < header->method_ids_size; i++)
+    {
+        dx_method_id_ref_t method_id = &dexfile->method_ids[i];
+        if (    method_id->class_idx >= type_ids_size
+            ||  method_id->proto_idx >= header->proto_ids_size
+            ||  method_id->name_idx >= string_ids_size)
+            return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t dx_validate_classes(dx_file_t* dexfile)
+{
+    // check all classes
+    tb_uint32_t     i = 0;
+    dx_header_ref_t header = dexfile->header;
+    for (i = 0; i < header->class_defs_size; i++)
+    {
+        dx_class_def_ref_t class_def = &dexfile->class_defs[i];
+        if (    class_def->class_idx >= header->type_ids_size
+            ||  (class_def->superclass_idx != DX_VALIDATE_NO_INDEX && class_def->superclass_idx >= header->type_ids_size)
+            ||  (class_def->source_file_idx != DX_VALIDATE_NO_INDEX && class_def->source_file_idx >= header->string_ids_size)
+            ||  !dx_validate_annotations(dexfile, class_def->annotations_off)
+            ||  !dx_validate_static_values(dexfile, class_def->static_values_off)
+            ||  !dx_validate_type_list(dexfile, class_def->interfaces_off)
+            ||  !dx_validate_class_data(dexfile, class_def->class_data_off))
+            return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t dx_validate_header(dx_file_t* dexfile)
+{
+    // check
+    tb_assert_and_check_return_val(dexfile && dexfile->header && dexfile->data, tb_false);
+
+    // check the header
+    dx_header_ref_t header = dexfile->header;
+    tb_check_return_val(header->header_size == sizeof(dx_header_t) && header->endian_tag == DX_VALIDATE_ENDIAN_TAG, tb_false);
+
+    // check the id tables
+    return dx_validate_ids(dexfile);
+}
+tb_bool_t dx_validate_file(dx_file_t* dexfile)
+{
+    // check
+    tb_assert_and_check_return_val(dexfile && dexfile->header && dexfile->data, tb_false);
+
+    // done
+    tb_char_t const* failed = tb_null;
+    do
+    {
+        // check the header and the id tables
+        if (!dx_validate_header(dexfile))
+        {
+            failed = "header";
+            break;
+        }
+
+        // check the map list
+        if (!dx_validate_map(dexfile))
+        {
+            failed = "map_list";
+            break;
+        }
+
+        // check the string data
+        if (!dx_validate_strings(dexfile))
+        {
+            failed = "string_data";
+            break;
+        }
+
+        // check the types, protos, fields and methods
+        if (!dx_validate_members(dexfile))
+        {
+            failed = "members";
+            break;
+        }
+
+        // check the classes, class_data, code_items, static values and annotations
+        if (!dx_validate_classes(dexfile))
+        {
+            failed = "classes";
+            break;
+        }
+
+    } while (0);
+
+    // trace
+    tb_trace_d("validate: %s", failed? failed : "ok");
+
+    // ok?
+    return !failed;
+}
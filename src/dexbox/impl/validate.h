@@ -0,0 +1,69 @@
+/*!A lightweight dex file parsing library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2015-2020, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        validate.h
+ *
+ */
+#ifndef DX_IMPL_VALIDATE_H
+#define DX_IMPL_VALIDATE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "file.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* validate the header and the bounds of all id tables
+ *
+ * it only reads the header, so it is always checked when loading.
+ *
+ * @param dexfile   the dex file
+ *
+ * @return          tb_true if the header and all id tables are valid
+ */
+tb_bool_t           dx_validate_header(dx_file_t* dexfile);
+
+/* validate the structure of the dex file in one pass
+ *
+ * it walks the map_list and checks the bounds of all id tables, string data, type lists,
+ * class_data, code_items and their catch handlers, static values and annotations, and all indexes in them.
+ *
+ * the id tables must have been attached to the dex file.
+ *
+ * @param dexfile   the dex file
+ *
+ * @return          tb_true if all offsets and indexes in this dex file are valid
+ */
+tb_bool_t           dx_validate_file(dx_file_t* dexfile);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
+
@@ -0,0 +1,318 @@
+/*!A lightweight dex file parsing library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2015-2020, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        zip.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "zip"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "zip.h"
+#include "file.h"
+#include "mmap.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the signature of the end of central directory record
+#define DX_ZIP_EOCD_SIGNATURE           (0x06054b50)
+
+// the size of the end of central directory record
+#define DX_ZIP_EOCD_SIZE                (22)
+
+// the signature of the central directory file header
+#define DX_ZIP_CDFH_SIGNATURE           (0x02014b50)
+
+// the size of the central directory file header
+#define DX_ZIP_CDFH_SIZE                (46)
+
+// the signature of the local file header
+#define DX_ZIP_LFH_SIGNATURE            (0x04034b50)
+
+// the size of the local file header
+#define DX_ZIP_LFH_SIZE                 (30)
+
+// the maximum comment size of the archive
+#define DX_ZIP_COMMENT_MAXN             (0xffff)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t dx_zip_inflate(tb_byte_t const* data, tb_size_t size, tb_byte_t* out, tb_size_t out_size)
+{
+#if defined(TB_CONFIG_MODULE_HAVE_ZIP) && defined(TB_CONFIG_PACKAGE_HAVE_ZLIB)
+    // init the raw deflate stream
+    tb_zip_ref_t inflater = tb_zip_init(TB_ZIP_ALGO_ZLIBRAW, TB_ZIP_ACTION_INFLATE);
+    tb_assert_and_check_return_val(inflater, tb_false);
+
+    // inflate it to the output buffer directly
+    tb_static_stream_t ist;
+    tb_static_stream_t ost;
+    tb_static_stream_init(&ist, (tb_byte_t*)data, size);
+    tb_static_stream_init(&ost, out, out_size);
+    while (tb_static_stream_left(&ost))
+    {
+        if (tb_zip_spak(inflater, &ist, &ost, -1) <= 0) break;
+    }
+
+    // exit the stream
+    tb_zip_exit(inflater);
+
+    // ok?
+    return !tb_static_stream_left(&ost);
+#else
+    // trace
+    tb_trace_e("inflate: not supported, please enable zip module and zlib package for tbox!");
+    return tb_false;
+#endif
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t dx_zip_init(dx_zip_ref_t zip, tb_char_t const* url)
+{
+    // check
+    tb_assert_and_check_return_val(zip && url, tb_false);
+
+    // init it
+    tb_memset(zip, 0, sizeof(dx_zip_t));
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // is local file? map it directly
+        zip->path = dx_mmap_path(url);
+        if (zip->path) zip->data = dx_mmap_init(zip->path, &zip->size);
+        if (zip->data) zip->owner = DX_FILE_OWNER_MMAP;
+        else
+        {
+            // read the whole archive
+            tb_stream_ref_t stream = tb_stream_init_from_url(url);
+            tb_assert_and_check_break(stream);
+            if (tb_stream_open(stream) && (zip->size = (tb_size_t)tb_stream_size(stream)) > 0)
+            {
+                tb_byte_t* data = (tb_byte_t*)tb_align_malloc(zip->size, 8);
+                if (data && tb_stream_bread(stream, data, zip->size)) zip->data = data;
+                else if (data) tb_align_free(data);
+            }
+            tb_stream_exit(stream);
+            tb_check_break(zip->data);
+            zip->owner = DX_FILE_OWNER_ALLOC;
+        }
+        tb_check_break(zip->size >= DX_ZIP_EOCD_SIZE);
+
+        // find the end of central directory record backward, it may be followed by the archive comment
+        tb_byte_t const* eocd = tb_null;
+        tb_byte_t const* p = zip->data + zip->size - DX_ZIP_EOCD_SIZE;
+        tb_byte_t const* e = zip->size > DX_ZIP_EOCD_SIZE + DX_ZIP_COMMENT_MAXN? p - DX_ZIP_COMMENT_MAXN : zip->data;
+        for (; p >= e; p--)
+        {
+            if (tb_bits_get_u32_le(p) == DX_ZIP_EOCD_SIGNATURE)
+            {
+                eocd = p;
+                break;
+            }
+        }
+        tb_check_break(eocd);
+
+        // get the central directory, zip64 is not supported
+        tb_size_t cd_size   = tb_bits_get_u32_le(eocd + 12);
+        tb_size_t cd_offset = tb_bits_get_u32_le(eocd + 16);
+        tb_assert_and_check_break(cd_offset + cd_size <= (tb_size_t)(eocd - zip->data));
+        zip->cd         = zip->data + cd_offset;
+        zip->cd_size    = cd_size;
+        zip->count      = tb_bits_get_u16_le(eocd + 10);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok) dx_zip_exit(zip);
+
+    // trace
+    tb_trace_d("init %s: %lu entries", url, zip->count);
+
+    // ok?
+    return ok;
+}
+tb_void_t dx_zip_exit(dx_zip_ref_t zip)
+{
+    // check
+    tb_assert_and_check_return(zip);
+
+    // exit the archive data
+    if (zip->data)
+    {
+        if (zip->owner == DX_FILE_OWNER_MMAP) dx_mmap_exit(zip->data, zip->size);
+        else if (zip->owner == DX_FILE_OWNER_ALLOC) tb_align_free(zip->data);
+    }
+
+    // clear it
+    tb_memset(zip, 0, sizeof(dx_zip_t));
+}
+tb_bool_t dx_zip_find(dx_zip_ref_t zip, tb_char_t const* name, dx_zip_entry_ref_t entry)
+{
+    // check
+    tb_assert_and_check_return_val(zip && zip->cd && name && entry, tb_false);
+
+    // find it in the central directory
+    tb_size_t           i = 0;
+    tb_size_t           n = tb_strlen(name);
+    tb_byte_t const*    p = zip->cd;
+    tb_byte_t const*    e = zip->cd + zip->cd_size;
+    for (i = 0; i < zip->count && p + DX_ZIP_CDFH_SIZE <= e; i++)
+    {
+        // check signature
+        tb_assert_and_check_break(tb_bits_get_u32_le(p) == DX_ZIP_CDFH_SIGNATURE);
+
+        // get the name
+        tb_size_t name_size     = tb_bits_get_u16_le(p + 28);
+        tb_size_t extra_size    = tb_bits_get_u16_le(p + 30);
+        tb_size_t comment_size  = tb_bits_get_u16_le(p + 32);
+        tb_check_break(p + DX_ZIP_CDFH_SIZE + name_size <= e);
+
+        // is this entry?
+        if (name_size == n && !tb_strncmp((tb_char_t const*)p + DX_ZIP_CDFH_SIZE, name, n))
+        {
+            // get the local file header, the data follows it
+            tb_size_t           lfh_offset = tb_bits_get_u32_le(p + 42);
+            tb_byte_t const*    lfh = zip->data + lfh_offset;
+            tb_assert_and_check_return_val(lfh_offset + DX_ZIP_LFH_SIZE <= zip->size && tb_bits_get_u32_le(lfh) == DX_ZIP_LFH_SIGNATURE, tb_false);
+
+            // save entry
+            entry->method   = tb_bits_get_u16_le(p + 10);
+            entry->csize    = tb_bits_get_u32_le(p + 20);
+            entry->size     = tb_bits_get_u32_le(p + 24);
+            entry->offset   = lfh_offset + DX_ZIP_LFH_SIZE + tb_bits_get_u16_le(lfh + 26) + tb_bits_get_u16_le(lfh + 28);
+            tb_assert_and_check_return_val(entry->offset <= zip->size && entry->csize <= zip->size - entry->offset, tb_false);
+
+            // ok
+            return tb_true;
+        }
+
+        // the next entry
+        p += DX_ZIP_CDFH_SIZE + name_size + extra_size + comment_size;
+    }
+
+    // not found
+    return tb_false;
+}
+dx_file_ref_t dx_zip_load_entry(dx_zip_ref_t zip, dx_zip_entry_ref_t entry, tb_size_t checksum)
+{
+    // check
+    tb_assert_and_check_return_val(zip && entry, tb_null);
+    tb_check_return_val(entry->size, tb_null);
+
+    // done
+    tb_byte_t const*    base = tb_null;
+    tb_size_t           base_size = 0;
+    tb_size_t           owner = DX_FILE_OWNER_NONE;
+    tb_byte_t const*    data = tb_null;
+    dx_file_ref_t       dexfile = tb_null;
+    do
+    {
+        // the stored entry?
+        if (entry->method == DX_ZIP_METHOD_STORED)
+        {
+            // check size
+            tb_assert_and_check_break(entry->csize == entry->size);
+
+            // it has been aligned by zipalign? map this entry directly
+            if (zip->path && zip->owner == DX_FILE_OWNER_MMAP && !(entry->offset & 3))
+            {
+                data = dx_mmap_init_range(zip->path, entry->offset, entry->size, &base, &base_size);
+                if (data) owner = DX_FILE_OWNER_MMAP;
+            }
+
+            // copy it to the aligned buffer
+            if (!data)
+            {
+                tb_byte_t* buffer = (tb_byte_t*)tb_align_malloc(entry->size, 8);
+                tb_assert_and_check_break(buffer);
+
+                tb_memcpy(buffer, zip->data + entry->offset, entry->size);
+                data = base = buffer;
+                base_size = entry->size;
+                owner = DX_FILE_OWNER_ALLOC;
+            }
+        }
+        // the deflated entry? inflate it to the aligned buffer
+        else if (entry->method == DX_ZIP_METHOD_DEFLATED)
+        {
+            tb_byte_t* buffer = (tb_byte_t*)tb_align_malloc(entry->size, 8);
+            tb_assert_and_check_break(buffer);
+
+            data = base = buffer;
+            base_size = entry->size;
+            owner = DX_FILE_OWNER_ALLOC;
+            if (!dx_zip_inflate(zip->data + entry->offset, entry->csize, buffer, entry->size)) break;
+        }
+        else
+        {
+            // trace
+            tb_trace_e("load entry: unknown compression method %lu", entry->method);
+            break;
+        }
+
+        // load dex from the entry data
+        dexfile = dx_file_load_from_data(data, entry->size, checksum);
+        tb_check_break(dexfile);
+
+        // mark as owner of the entry data
+        ((dx_file_t*)dexfile)->base         = base;
+        ((dx_file_t*)dexfile)->base_size    = base_size;
+        ((dx_file_t*)dexfile)->owner        = owner;
+
+    } while (0);
+
+    // failed? exit the entry data
+    if (!dexfile && base)
+    {
+        if (owner == DX_FILE_OWNER_MMAP) dx_mmap_exit(base, base_size);
+        else if (owner == DX_FILE_OWNER_ALLOC) tb_align_free(base);
+    }
+
+    // trace
+    tb_trace_d("load entry: method: %lu, offset: %lu, size: %lu, %s", entry->method, entry->offset, entry->size, owner == DX_FILE_OWNER_MMAP? "mapped" : "copied");
+
+    // ok?
+    return dexfile;
+}
+dx_file_ref_t dx_zip_load(dx_zip_ref_t zip, tb_char_t const* name, tb_size_t checksum)
+{
+    // check
+    tb_assert_and_check_return_val(zip && name, tb_null);
+
+    // find entry
+    dx_zip_entry_t entry;
+    if (!dx_zip_find(zip, name, &entry)) return tb_null;
+
+    // load it
+    return dx_zip_load_entry(zip, &entry, checksum);
+}
@@ -0,0 +1,152 @@
+/*!A lightweight dex file parsing library
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2015-2020, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        zip.h
+ *
+ */
+#ifndef DX_IMPL_ZIP_H
+#define DX_IMPL_ZIP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the compression method: stored
+#define DX_ZIP_METHOD_STORED        (0)
+
+// the compression method: deflated
+#define DX_ZIP_METHOD_DEFLATED      (8)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the zip archive type
+typedef struct __dx_zip_t
+{
+    // the local file path
+    tb_char_t const*        path;
+
+    // the archive data
+    tb_byte_t const*        data;
+
+    // the archive size
+    tb_size_t               size;
+
+    // the owner of the archive data
+    tb_size_t               owner;
+
+    // the central directory
+    tb_byte_t const*        cd;
+
+    // the central directory size
+    tb_size_t               cd_size;
+
+    // the entry count
+    tb_size_t               count;
+
+}dx_zip_t, *dx_zip_ref_t;
+
+// the zip entry type
+typedef struct __dx_zip_entry_t
+{
+    // the compression method
+    tb_size_t               method;
+
+    // the offset of the entry data in the archive
+    tb_size_t               offset;
+
+    // the compressed size
+    tb_size_t               csize;
+
+    // the uncompressed size
+    tb_size_t               size;
+
+}dx_zip_entry_t, *dx_zip_entry_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init the zip archive and locate the central directory
+ *
+ * the local archive will be mapped into memory, otherwise it will be read into memory.
+ *
+ * @param zip       the zip archive
+ * @param url       the archive url
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           dx_zip_init(dx_zip_ref_t zip, tb_char_t const* url);
+
+/* exit the zip archive
+ *
+ * @param zip       the zip archive
+ */
+tb_void_t           dx_zip_exit(dx_zip_ref_t zip);
+
+/* find the entry with the given name
+ *
+ * @param zip       the zip archive
+ * @param name      the entry name, e.g. "classes.dex"
+ * @param entry     the entry
+ *
+ * @return          tb_true if found
+ */
+tb_bool_t           dx_zip_find(dx_zip_ref_t zip, tb_char_t const* name, dx_zip_entry_ref_t entry);
+
+/* load the dex file from the entry found by dx_zip_find()
+ *
+ * the stored and 4-byte aligned entry will be mapped directly, 
+ * the deflated entry will be inflated into the aligned buffer owned by the dex file.
+ *
+ * @param zip       the zip archive
+ * @param entry     the entry
+ * @param checksum  the checksum mode
+ *
+ * @return          the dex file
+ */
+dx_file_ref_t       dx_zip_load_entry(dx_zip_ref_t zip, dx_zip_entry_ref_t entry, tb_size_t checksum);
+
+/* find the entry with the given name and load the dex file from it
+ *
+ * @param zip       the zip archive
+ * @param name      the entry name
+ * @param checksum  the checksum mode
+ *
+ * @return          the dex file
+ */
+dx_file_ref_t       dx_zip_load(dx_zip_ref_t zip, tb_char_t const* name, tb_size_t checksum);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
+
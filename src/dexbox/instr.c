@@ -30,16 +30,15 @@
  */
 #include "dexbox.h"
 #include "impl/impl.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define DX_INSTR_SSE2
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros 
  */
 
-// identifying pseudo-opcode format
-#define DX_INSTR_IDENT_PACKED_SWITCH_PAYLOAD        (0x0100)
-#define DX_INSTR_IDENT_SPARSE_SWITCH_PAYLOAD        (0x0200)
-#define DX_INSTR_IDENT_FILL_ARRAY_DATA              (0x0300)
-
 // get vA from the instruction code
 #define DX_INSTR_A(instr_unit)                      (((tb_uint16_t)(instr_unit) >> 8) & 0x0f)
 
@@ -55,497 +54,555 @@
 // fetch four bytes from the instruction offset
 #define DX_FETCH_u4(instr, offset)                  ((instr)[(offset)] | ((tb_uint32_t)((instr)[(offset) + 1]) << 16))
 
-/* //////////////////////////////////////////////////////////////////////////////////////
- * types 
- */
+// the maximum key count of the sparse-switch which will be compared by simd directly
+#define DX_INSTR_SPARSE_SWITCH_SIMD_MAXN            (16)
 
-// the instruction info table type
-typedef struct __dx_instr_info_table_t
-{
-    // the instruction formats
-    tb_uint8_t const*       formats;
+// make the packed instruction info, width(8) | flags(8) | index_type(8) | format(8)
+#define DX_INSTR_INFO(format, index_type, flags, width) \
+                                                    ((tb_uint32_t)(format) | ((tb_uint32_t)(index_type) << 8) | ((tb_uint32_t)(flags) << 16) | ((tb_uint32_t)(width) << 24))
 
-    // the instruction index types
-    tb_uint8_t const*       index_types;
+// get the format from the packed instruction info
+#define DX_INSTR_INFO_FORMAT(info)                  ((info) & 0xff)
 
-    // the instruction flags
-    tb_uint8_t const*       flags;
+// get the index type from the packed instruction info
+#define DX_INSTR_INFO_INDEX_TYPE(info)              (((info) >> 8) & 0xff)
 
-    // the instruction widths
-    tb_uint8_t const*       widths;
+// get the flags from the packed instruction info
+#define DX_INSTR_INFO_FLAGS(info)                   (((info) >> 16) & 0xff)
 
-}dx_instr_info_table_t;
+// get the width from the packed instruction info
+#define DX_INSTR_INFO_WIDTH(info)                   ((info) >> 24)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types 
+ */
+
+// the instruction decoder type, it decodes the operands of one instruction format
+typedef tb_bool_t (*dx_instr_decoder_t)(dx_instruction_ref_t instruction, tb_uint16_t const* instr, tb_uint16_t instr_unit);
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals 
  */
 
-// the instruction width table
-static tb_uint8_t g_instr_width_table[] = 
+// the packed instruction info table, only one load for the format, index type, flags and width of each opcode
+static tb_uint32_t const g_instr_infos[] = 
 {
-    // BEGIN(dexbox-widths)
-    1, 1, 2, 3, 1, 2, 3, 1, 2, 3, 1, 1, 1, 1, 1, 1,
-    1, 1, 1, 2, 3, 2, 2, 3, 5, 2, 2, 3, 2, 1, 1, 2,
-    2, 1, 2, 2, 3, 3, 3, 1, 1, 2, 3, 3, 3, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 0, 0,
-    0, 0, 0, 0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 3,
-    3, 3, 3, 0, 3, 3, 3, 3, 3, 0, 0, 1, 1, 1, 1, 1,
-    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
-    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 0, 2, 3, 3,
-    3, 1, 2, 0, 0, 0, 0, 0, 0, 0, 4, 4, 3, 3, 2, 2,
-    // END(dexbox-widths)
+    // BEGIN(dexbox-infos)
+    DX_INSTR_INFO(DX_INSTR_FMT_10x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 00 nop
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 01 move
+    DX_INSTR_INFO(DX_INSTR_FMT_22x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 02 move/from16
+    DX_INSTR_INFO(DX_INSTR_FMT_32x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 3), // 03 move/16
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 04 move-wide
+    DX_INSTR_INFO(DX_INSTR_FMT_22x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 05 move-wide/from16
+    DX_INSTR_INFO(DX_INSTR_FMT_32x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 3), // 06 move-wide/16
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 07 move-object
+    DX_INSTR_INFO(DX_INSTR_FMT_22x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 08 move-object/from16
+    DX_INSTR_INFO(DX_INSTR_FMT_32x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 3), // 09 move-object/16
+    DX_INSTR_INFO(DX_INSTR_FMT_11x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 0a move-result
+    DX_INSTR_INFO(DX_INSTR_FMT_11x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 0b move-result-wide
+    DX_INSTR_INFO(DX_INSTR_FMT_11x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 0c move-result-object
+    DX_INSTR_INFO(DX_INSTR_FMT_11x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 0d move-exception
+    DX_INSTR_INFO(DX_INSTR_FMT_10x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_RETURN, 1), // 0e return-void
+    DX_INSTR_INFO(DX_INSTR_FMT_11x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_RETURN, 1), // 0f return
+    DX_INSTR_INFO(DX_INSTR_FMT_11x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_RETURN, 1), // 10 return-wide
+    DX_INSTR_INFO(DX_INSTR_FMT_11x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_RETURN, 1), // 11 return-object
+    DX_INSTR_INFO(DX_INSTR_FMT_11n, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 12 const/4
+    DX_INSTR_INFO(DX_INSTR_FMT_21s, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 13 const/16
+    DX_INSTR_INFO(DX_INSTR_FMT_31i, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 3), // 14 const
+    DX_INSTR_INFO(DX_INSTR_FMT_21h, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 15 const/high16
+    DX_INSTR_INFO(DX_INSTR_FMT_21s, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 16 const-wide/16
+    DX_INSTR_INFO(DX_INSTR_FMT_31i, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 3), // 17 const-wide/32
+    DX_INSTR_INFO(DX_INSTR_FMT_51l, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 5), // 18 const-wide
+    DX_INSTR_INFO(DX_INSTR_FMT_21h, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 19 const-wide/high16
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_STRING_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 1a const-string
+    DX_INSTR_INFO(DX_INSTR_FMT_31c, DX_INSTR_INDEX_TYPE_STRING_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 3), // 1b const-string/jumbo
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_TYPE_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 1c const-class
+    DX_INSTR_INFO(DX_INSTR_FMT_11x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 1), // 1d monitor-enter
+    DX_INSTR_INFO(DX_INSTR_FMT_11x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 1), // 1e monitor-exit
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_TYPE_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 1f check-cast
+    DX_INSTR_INFO(DX_INSTR_FMT_22c, DX_INSTR_INDEX_TYPE_TYPE_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 20 instance-of
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 1), // 21 array-length
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_TYPE_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 22 new-instance
+    DX_INSTR_INFO(DX_INSTR_FMT_22c, DX_INSTR_INDEX_TYPE_TYPE_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 23 new-array
+    DX_INSTR_INFO(DX_INSTR_FMT_35c, DX_INSTR_INDEX_TYPE_TYPE_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 3), // 24 filled-new-array
+    DX_INSTR_INFO(DX_INSTR_FMT_3rc, DX_INSTR_INDEX_TYPE_TYPE_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 3), // 25 filled-new-array/range
+    DX_INSTR_INFO(DX_INSTR_FMT_31t, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 3), // 26 fill-array-data
+    DX_INSTR_INFO(DX_INSTR_FMT_11x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_THROW, 1), // 27 throw
+    DX_INSTR_INFO(DX_INSTR_FMT_10t, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_BRANCH, 1), // 28 goto
+    DX_INSTR_INFO(DX_INSTR_FMT_20t, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_BRANCH, 2), // 29 goto/16
+    DX_INSTR_INFO(DX_INSTR_FMT_30t, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_BRANCH, 3), // 2a goto/32
+    DX_INSTR_INFO(DX_INSTR_FMT_31t, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_SWITCH, 3), // 2b packed-switch
+    DX_INSTR_INFO(DX_INSTR_FMT_31t, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_SWITCH, 3), // 2c sparse-switch
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 2d cmpl-float
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 2e cmpg-float
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 2f cmpl-double
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 30 cmpg-double
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 31 cmp-long
+    DX_INSTR_INFO(DX_INSTR_FMT_22t, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH, 2), // 32 if-eq
+    DX_INSTR_INFO(DX_INSTR_FMT_22t, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH, 2), // 33 if-ne
+    DX_INSTR_INFO(DX_INSTR_FMT_22t, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH, 2), // 34 if-lt
+    DX_INSTR_INFO(DX_INSTR_FMT_22t, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH, 2), // 35 if-ge
+    DX_INSTR_INFO(DX_INSTR_FMT_22t, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH, 2), // 36 if-gt
+    DX_INSTR_INFO(DX_INSTR_FMT_22t, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH, 2), // 37 if-le
+    DX_INSTR_INFO(DX_INSTR_FMT_21t, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH, 2), // 38 if-eqz
+    DX_INSTR_INFO(DX_INSTR_FMT_21t, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH, 2), // 39 if-nez
+    DX_INSTR_INFO(DX_INSTR_FMT_21t, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH, 2), // 3a if-ltz
+    DX_INSTR_INFO(DX_INSTR_FMT_21t, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH, 2), // 3b if-gez
+    DX_INSTR_INFO(DX_INSTR_FMT_21t, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH, 2), // 3c if-gtz
+    DX_INSTR_INFO(DX_INSTR_FMT_21t, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH, 2), // 3d if-lez
+    DX_INSTR_INFO(DX_INSTR_FMT_00x, DX_INSTR_INDEX_TYPE_UNKNOWN, 0, 0), // 3e unused-3e
+    DX_INSTR_INFO(DX_INSTR_FMT_00x, DX_INSTR_INDEX_TYPE_UNKNOWN, 0, 0), // 3f unused-3f
+    DX_INSTR_INFO(DX_INSTR_FMT_00x, DX_INSTR_INDEX_TYPE_UNKNOWN, 0, 0), // 40 unused-40
+    DX_INSTR_INFO(DX_INSTR_FMT_00x, DX_INSTR_INDEX_TYPE_UNKNOWN, 0, 0), // 41 unused-41
+    DX_INSTR_INFO(DX_INSTR_FMT_00x, DX_INSTR_INDEX_TYPE_UNKNOWN, 0, 0), // 42 unused-42
+    DX_INSTR_INFO(DX_INSTR_FMT_00x, DX_INSTR_INDEX_TYPE_UNKNOWN, 0, 0), // 43 unused-43
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 44 aget
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 45 aget-wide
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 46 aget-object
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 47 aget-boolean
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 48 aget-byte
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 49 aget-char
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 4a aget-short
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 4b aput
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 4c aput-wide
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 4d aput-object
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 4e aput-boolean
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 4f aput-byte
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 50 aput-char
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 51 aput-short
+    DX_INSTR_INFO(DX_INSTR_FMT_22c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 52 iget
+    DX_INSTR_INFO(DX_INSTR_FMT_22c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 53 iget-wide
+    DX_INSTR_INFO(DX_INSTR_FMT_22c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 54 iget-object
+    DX_INSTR_INFO(DX_INSTR_FMT_22c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 55 iget-boolean
+    DX_INSTR_INFO(DX_INSTR_FMT_22c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 56 iget-byte
+    DX_INSTR_INFO(DX_INSTR_FMT_22c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 57 iget-char
+    DX_INSTR_INFO(DX_INSTR_FMT_22c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 58 iget-short
+    DX_INSTR_INFO(DX_INSTR_FMT_22c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 59 iput
+    DX_INSTR_INFO(DX_INSTR_FMT_22c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 5a iput-wide
+    DX_INSTR_INFO(DX_INSTR_FMT_22c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 5b iput-object
+    DX_INSTR_INFO(DX_INSTR_FMT_22c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 5c iput-boolean
+    DX_INSTR_INFO(DX_INSTR_FMT_22c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 5d iput-byte
+    DX_INSTR_INFO(DX_INSTR_FMT_22c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 5e iput-char
+    DX_INSTR_INFO(DX_INSTR_FMT_22c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 5f iput-short
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 60 sget
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 61 sget-wide
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 62 sget-object
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 63 sget-boolean
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 64 sget-byte
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 65 sget-char
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 66 sget-short
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 67 sput
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 68 sput-wide
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 69 sput-object
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 6a sput-boolean
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 6b sput-byte
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 6c sput-char
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 6d sput-short
+    DX_INSTR_INFO(DX_INSTR_FMT_35c, DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE, 3), // 6e invoke-virtual
+    DX_INSTR_INFO(DX_INSTR_FMT_35c, DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE, 3), // 6f invoke-super
+    DX_INSTR_INFO(DX_INSTR_FMT_35c, DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE, 3), // 70 invoke-direct
+    DX_INSTR_INFO(DX_INSTR_FMT_35c, DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE, 3), // 71 invoke-static
+    DX_INSTR_INFO(DX_INSTR_FMT_35c, DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE, 3), // 72 invoke-interface
+    DX_INSTR_INFO(DX_INSTR_FMT_00x, DX_INSTR_INDEX_TYPE_UNKNOWN, 0, 0), // 73 unused-73
+    DX_INSTR_INFO(DX_INSTR_FMT_3rc, DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE, 3), // 74 invoke-virtual/range
+    DX_INSTR_INFO(DX_INSTR_FMT_3rc, DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE, 3), // 75 invoke-super/range
+    DX_INSTR_INFO(DX_INSTR_FMT_3rc, DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE, 3), // 76 invoke-direct/range
+    DX_INSTR_INFO(DX_INSTR_FMT_3rc, DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE, 3), // 77 invoke-static/range
+    DX_INSTR_INFO(DX_INSTR_FMT_3rc, DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE, 3), // 78 invoke-interface/range
+    DX_INSTR_INFO(DX_INSTR_FMT_00x, DX_INSTR_INDEX_TYPE_UNKNOWN, 0, 0), // 79 unused-79
+    DX_INSTR_INFO(DX_INSTR_FMT_00x, DX_INSTR_INDEX_TYPE_UNKNOWN, 0, 0), // 7a unused-7a
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 7b neg-int
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 7c not-int
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 7d neg-long
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 7e not-long
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 7f neg-float
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 80 neg-double
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 81 int-to-long
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 82 int-to-float
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 83 int-to-double
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 84 long-to-int
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 85 long-to-float
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 86 long-to-double
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 87 float-to-int
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 88 float-to-long
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 89 float-to-double
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 8a double-to-int
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 8b double-to-long
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 8c double-to-float
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 8d int-to-byte
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 8e int-to-char
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // 8f int-to-short
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 90 add-int
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 91 sub-int
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 92 mul-int
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 93 div-int
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 94 rem-int
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 95 and-int
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 96 or-int
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 97 xor-int
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 98 shl-int
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 99 shr-int
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 9a ushr-int
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 9b add-long
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 9c sub-long
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // 9d mul-long
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 9e div-long
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // 9f rem-long
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // a0 and-long
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // a1 or-long
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // a2 xor-long
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // a3 shl-long
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // a4 shr-long
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // a5 ushr-long
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // a6 add-float
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // a7 sub-float
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // a8 mul-float
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // a9 div-float
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // aa rem-float
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // ab add-double
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // ac sub-double
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // ad mul-double
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // ae div-double
+    DX_INSTR_INFO(DX_INSTR_FMT_23x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // af rem-double
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // b0 add-int/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // b1 sub-int/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // b2 mul-int/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 1), // b3 div-int/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 1), // b4 rem-int/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // b5 and-int/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // b6 or-int/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // b7 xor-int/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // b8 shl-int/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // b9 shr-int/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // ba ushr-int/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // bb add-long/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // bc sub-long/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // bd mul-long/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 1), // be div-long/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 1), // bf rem-long/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // c0 and-long/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // c1 or-long/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // c2 xor-long/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // c3 shl-long/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // c4 shr-long/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // c5 ushr-long/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // c6 add-float/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // c7 sub-float/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // c8 mul-float/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // c9 div-float/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // ca rem-float/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // cb add-double/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // cc sub-double/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // cd mul-double/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // ce div-double/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_12x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 1), // cf rem-double/2addr
+    DX_INSTR_INFO(DX_INSTR_FMT_22s, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // d0 add-int/lit16
+    DX_INSTR_INFO(DX_INSTR_FMT_22s, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // d1 rsub-int
+    DX_INSTR_INFO(DX_INSTR_FMT_22s, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // d2 mul-int/lit16
+    DX_INSTR_INFO(DX_INSTR_FMT_22s, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // d3 div-int/lit16
+    DX_INSTR_INFO(DX_INSTR_FMT_22s, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // d4 rem-int/lit16
+    DX_INSTR_INFO(DX_INSTR_FMT_22s, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // d5 and-int/lit16
+    DX_INSTR_INFO(DX_INSTR_FMT_22s, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // d6 or-int/lit16
+    DX_INSTR_INFO(DX_INSTR_FMT_22s, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // d7 xor-int/lit16
+    DX_INSTR_INFO(DX_INSTR_FMT_22b, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // d8 add-int/lit8
+    DX_INSTR_INFO(DX_INSTR_FMT_22b, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // d9 rsub-int/lit8
+    DX_INSTR_INFO(DX_INSTR_FMT_22b, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // da mul-int/lit8
+    DX_INSTR_INFO(DX_INSTR_FMT_22b, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // db div-int/lit8
+    DX_INSTR_INFO(DX_INSTR_FMT_22b, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // dc rem-int/lit8
+    DX_INSTR_INFO(DX_INSTR_FMT_22b, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // dd and-int/lit8
+    DX_INSTR_INFO(DX_INSTR_FMT_22b, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // de or-int/lit8
+    DX_INSTR_INFO(DX_INSTR_FMT_22b, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // df xor-int/lit8
+    DX_INSTR_INFO(DX_INSTR_FMT_22b, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // e0 shl-int/lit8
+    DX_INSTR_INFO(DX_INSTR_FMT_22b, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // e1 shr-int/lit8
+    DX_INSTR_INFO(DX_INSTR_FMT_22b, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_CONTINUE, 2), // e2 ushr-int/lit8
+    DX_INSTR_INFO(DX_INSTR_FMT_22c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // e3 +iget-volatile
+    DX_INSTR_INFO(DX_INSTR_FMT_22c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // e4 +iput-volatile
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // e5 +sget-volatile
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // e6 +sput-volatile
+    DX_INSTR_INFO(DX_INSTR_FMT_22c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // e7 +iget-object-volatile
+    DX_INSTR_INFO(DX_INSTR_FMT_22c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // e8 +iget-wide-volatile
+    DX_INSTR_INFO(DX_INSTR_FMT_22c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // e9 +iput-wide-volatile
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // ea +sget-wide-volatile
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // eb +sput-wide-volatile
+    DX_INSTR_INFO(DX_INSTR_FMT_00x, DX_INSTR_INDEX_TYPE_UNKNOWN, 0, 0), // ec ^breakpoint
+    DX_INSTR_INFO(DX_INSTR_FMT_20bc, DX_INSTR_INDEX_TYPE_VARIES, DX_INSTR_FLAGS_CAN_THROW, 2), // ed ^throw-verification-error
+    DX_INSTR_INFO(DX_INSTR_FMT_35mi, DX_INSTR_INDEX_TYPE_INLINE_METHOD, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 3), // ee +execute-inline
+    DX_INSTR_INFO(DX_INSTR_FMT_3rmi, DX_INSTR_INDEX_TYPE_INLINE_METHOD, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 3), // ef +execute-inline/range
+    DX_INSTR_INFO(DX_INSTR_FMT_35c, DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE, 3), // f0 +invoke-object-init/range
+    DX_INSTR_INFO(DX_INSTR_FMT_10x, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_FLAGS_CAN_RETURN, 1), // f1 +return-void-barrier
+    DX_INSTR_INFO(DX_INSTR_FMT_22cs, DX_INSTR_INDEX_TYPE_FIELD_OFFSET, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // f2 +iget-quick
+    DX_INSTR_INFO(DX_INSTR_FMT_00x, DX_INSTR_INDEX_TYPE_UNKNOWN, 0, 0), // f3 unused-f3
+    DX_INSTR_INFO(DX_INSTR_FMT_00x, DX_INSTR_INDEX_TYPE_UNKNOWN, 0, 0), // f4 unused-f4
+    DX_INSTR_INFO(DX_INSTR_FMT_00x, DX_INSTR_INDEX_TYPE_UNKNOWN, 0, 0), // f5 unused-f5
+    DX_INSTR_INFO(DX_INSTR_FMT_00x, DX_INSTR_INDEX_TYPE_UNKNOWN, 0, 0), // f6 unused-f6
+    DX_INSTR_INFO(DX_INSTR_FMT_00x, DX_INSTR_INDEX_TYPE_UNKNOWN, 0, 0), // f7 unused-f7
+    DX_INSTR_INFO(DX_INSTR_FMT_00x, DX_INSTR_INDEX_TYPE_UNKNOWN, 0, 0), // f8 unused-f8
+    DX_INSTR_INFO(DX_INSTR_FMT_00x, DX_INSTR_INDEX_TYPE_UNKNOWN, 0, 0), // f9 unused-f9
+    DX_INSTR_INFO(DX_INSTR_FMT_45cc, DX_INSTR_INDEX_TYPE_METHOD_AND_PROTO_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE, 4), // fa invoke-polymorphic
+    DX_INSTR_INFO(DX_INSTR_FMT_4rcc, DX_INSTR_INDEX_TYPE_METHOD_AND_PROTO_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE, 4), // fb invoke-polymorphic/range
+    DX_INSTR_INFO(DX_INSTR_FMT_35c, DX_INSTR_INDEX_TYPE_CALL_SITE_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE, 3), // fc invoke-custom
+    DX_INSTR_INFO(DX_INSTR_FMT_3rc, DX_INSTR_INDEX_TYPE_CALL_SITE_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE, 3), // fd invoke-custom/range
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_METHOD_HANDLE_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // fe const-method-handle
+    DX_INSTR_INFO(DX_INSTR_FMT_21c, DX_INSTR_INDEX_TYPE_PROTO_REF, DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW, 2), // ff const-method-type
+    // END(dexbox-infos)
 };
 
-// the instruction flags table
-static tb_uint8_t g_instr_flags_table[] = 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation 
+ */
+static __tb_inline__ tb_uint16_t dx_instr_get_opcode(tb_uint16_t instr_unit) 
 {
-    // BEGIN(dexbox-flags)
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_RETURN,
-    DX_INSTR_FLAGS_CAN_RETURN,
-    DX_INSTR_FLAGS_CAN_RETURN,
-    DX_INSTR_FLAGS_CAN_RETURN,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_BRANCH,
-    DX_INSTR_FLAGS_CAN_BRANCH,
-    DX_INSTR_FLAGS_CAN_BRANCH,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_SWITCH,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_SWITCH,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_BRANCH,
-    0,
-    0,
-    0,
-    0,
-    0,
-    0,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
-    0,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
-    0,
-    0,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    0,
-    DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
-    DX_INSTR_FLAGS_CAN_RETURN,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    0,
-    0,
-    0,
-    0,
-    0,
-    0,
-    0,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW|DX_INSTR_FLAGS_INVOKE,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    DX_INSTR_FLAGS_CAN_CONTINUE|DX_INSTR_FLAGS_CAN_THROW,
-    // END(dexbox-flags)
-};
-
-// the instruction format table
-static tb_uint8_t g_instr_format_table[] = 
+    /* get opcode
+     *
+     * all 256 opcodes are defined now, e.g. 0xff is const-method-type, 
+     * so it is not the prefix of the extended opcodes of the old dalvik anymore.
+     */
+    return instr_unit & 0xff;
+}
+static __tb_inline__ tb_uint32_t dx_instr_get_info(tb_uint16_t opcode)
 {
-    // BEGIN(dexbox-formats)
-    DX_INSTR_FMT_10x, DX_INSTR_FMT_12x, DX_INSTR_FMT_22x, DX_INSTR_FMT_32x, DX_INSTR_FMT_12x, DX_INSTR_FMT_22x, DX_INSTR_FMT_32x,
-    DX_INSTR_FMT_12x, DX_INSTR_FMT_22x, DX_INSTR_FMT_32x, DX_INSTR_FMT_11x, DX_INSTR_FMT_11x, DX_INSTR_FMT_11x, DX_INSTR_FMT_11x,
-    DX_INSTR_FMT_10x, DX_INSTR_FMT_11x, DX_INSTR_FMT_11x, DX_INSTR_FMT_11x, DX_INSTR_FMT_11n, DX_INSTR_FMT_21s, DX_INSTR_FMT_31i,
-    DX_INSTR_FMT_21h, DX_INSTR_FMT_21s, DX_INSTR_FMT_31i, DX_INSTR_FMT_51l, DX_INSTR_FMT_21h, DX_INSTR_FMT_21c, DX_INSTR_FMT_31c,
-    DX_INSTR_FMT_21c, DX_INSTR_FMT_11x, DX_INSTR_FMT_11x, DX_INSTR_FMT_21c, DX_INSTR_FMT_22c, DX_INSTR_FMT_12x, DX_INSTR_FMT_21c,
-    DX_INSTR_FMT_22c, DX_INSTR_FMT_35c, DX_INSTR_FMT_3rc, DX_INSTR_FMT_31t, DX_INSTR_FMT_11x, DX_INSTR_FMT_10t, DX_INSTR_FMT_20t,
-    DX_INSTR_FMT_30t, DX_INSTR_FMT_31t, DX_INSTR_FMT_31t, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x,
-    DX_INSTR_FMT_23x, DX_INSTR_FMT_22t, DX_INSTR_FMT_22t, DX_INSTR_FMT_22t, DX_INSTR_FMT_22t, DX_INSTR_FMT_22t, DX_INSTR_FMT_22t,
-    DX_INSTR_FMT_21t, DX_INSTR_FMT_21t, DX_INSTR_FMT_21t, DX_INSTR_FMT_21t, DX_INSTR_FMT_21t, DX_INSTR_FMT_21t, DX_INSTR_FMT_00x,
-    DX_INSTR_FMT_00x, DX_INSTR_FMT_00x, DX_INSTR_FMT_00x, DX_INSTR_FMT_00x, DX_INSTR_FMT_00x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x,
-    DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x,
-    DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c,
-    DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c,
-    DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c,
-    DX_INSTR_FMT_21c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c,
-    DX_INSTR_FMT_21c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c, DX_INSTR_FMT_35c, DX_INSTR_FMT_35c,
-    DX_INSTR_FMT_35c, DX_INSTR_FMT_35c, DX_INSTR_FMT_35c, DX_INSTR_FMT_00x, DX_INSTR_FMT_3rc, DX_INSTR_FMT_3rc, DX_INSTR_FMT_3rc,
-    DX_INSTR_FMT_3rc, DX_INSTR_FMT_3rc, DX_INSTR_FMT_00x, DX_INSTR_FMT_00x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x,
-    DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x,
-    DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x,
-    DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x,
-    DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x,
-    DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x,
-    DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x,
-    DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x, DX_INSTR_FMT_23x,
-    DX_INSTR_FMT_23x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x,
-    DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x,
-    DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x,
-    DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x,
-    DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_12x, DX_INSTR_FMT_22s, DX_INSTR_FMT_22s,
-    DX_INSTR_FMT_22s, DX_INSTR_FMT_22s, DX_INSTR_FMT_22s, DX_INSTR_FMT_22s, DX_INSTR_FMT_22s, DX_INSTR_FMT_22s, DX_INSTR_FMT_22b,
-    DX_INSTR_FMT_22b, DX_INSTR_FMT_22b, DX_INSTR_FMT_22b, DX_INSTR_FMT_22b, DX_INSTR_FMT_22b, DX_INSTR_FMT_22b, DX_INSTR_FMT_22b,
-    DX_INSTR_FMT_22b, DX_INSTR_FMT_22b, DX_INSTR_FMT_22b, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c,
-    DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_22c, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c, DX_INSTR_FMT_00x, DX_INSTR_FMT_20bc,
-    DX_INSTR_FMT_35mi, DX_INSTR_FMT_3rmi, DX_INSTR_FMT_35c, DX_INSTR_FMT_10x, DX_INSTR_FMT_22cs, DX_INSTR_FMT_00x, DX_INSTR_FMT_00x,
-    DX_INSTR_FMT_00x, DX_INSTR_FMT_00x, DX_INSTR_FMT_00x, DX_INSTR_FMT_00x, DX_INSTR_FMT_00x, DX_INSTR_FMT_45cc, DX_INSTR_FMT_4rcc,
-    DX_INSTR_FMT_35c, DX_INSTR_FMT_3rc, DX_INSTR_FMT_21c, DX_INSTR_FMT_21c,
-    // END(dexbox-formats)
-};
+    // check
+    tb_assert(opcode < tb_arrayn(g_instr_infos));
 
-// the instruction index type table
-static tb_uint8_t g_instr_index_type_table[] =
+    // get it
+    return g_instr_infos[opcode];
+}
+static tb_bool_t dx_instr_decode_00x(dx_instruction_ref_t instruction, tb_uint16_t const* instr, tb_uint16_t instr_unit)
 {
-    // BEGIN(dexbox-index-types)
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_STRING_REF,
-    DX_INSTR_INDEX_TYPE_STRING_REF, DX_INSTR_INDEX_TYPE_TYPE_REF, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_TYPE_REF, DX_INSTR_INDEX_TYPE_TYPE_REF,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_TYPE_REF, DX_INSTR_INDEX_TYPE_TYPE_REF,
-    DX_INSTR_INDEX_TYPE_TYPE_REF, DX_INSTR_INDEX_TYPE_TYPE_REF, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_UNKNOWN,
-    DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_UNKNOWN,
-    DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
-    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
-    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
-    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
-    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
-    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
-    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
-    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
-    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
-    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_METHOD_REF,
-    DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_INDEX_TYPE_METHOD_REF,
-    DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_METHOD_REF,
-    DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_INDEX_TYPE_METHOD_REF,
-    DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_UNKNOWN,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE,
-    DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_FIELD_REF,
-    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
-    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF,
-    DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_FIELD_REF, DX_INSTR_INDEX_TYPE_UNKNOWN,
-    DX_INSTR_INDEX_TYPE_VARIES, DX_INSTR_INDEX_TYPE_INLINE_METHOD, DX_INSTR_INDEX_TYPE_INLINE_METHOD,
-    DX_INSTR_INDEX_TYPE_METHOD_REF, DX_INSTR_INDEX_TYPE_NONE, DX_INSTR_INDEX_TYPE_FIELD_OFFSET,
-    DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_UNKNOWN,
-    DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_UNKNOWN,
-    DX_INSTR_INDEX_TYPE_UNKNOWN, DX_INSTR_INDEX_TYPE_METHOD_AND_PROTO_REF, DX_INSTR_INDEX_TYPE_METHOD_AND_PROTO_REF,
-    DX_INSTR_INDEX_TYPE_CALL_SITE_REF, DX_INSTR_INDEX_TYPE_CALL_SITE_REF, DX_INSTR_INDEX_TYPE_METHOD_HANDLE_REF,
-    DX_INSTR_INDEX_TYPE_PROTO_REF,
-    // END(dexbox-index-types)
-};
+    // trace
+    tb_trace_e("invalid instruction, code: %x, format: %u, opcode: %u", instr_unit, instruction->format, instruction->opcode);
 
-// the instruction info table
-static dx_instr_info_table_t g_instr_info = 
+    // failed
+    tb_assert(0);
+    return tb_false;
+}
+static tb_bool_t dx_instr_decode_10x(dx_instruction_ref_t instruction, tb_uint16_t const* instr, tb_uint16_t instr_unit)
 {
-    g_instr_format_table
-,   g_instr_index_type_table
-,   g_instr_flags_table
-,   g_instr_width_table
-};
+    // op, nothing to do; copy the AA bits out for the verifier 
+    instruction->vA = DX_INSTR_AA(instr_unit);
+    return tb_true;
+}
+static tb_bool_t dx_instr_decode_12x(dx_instruction_ref_t instruction, tb_uint16_t const* instr, tb_uint16_t instr_unit)
+{
+    // op vA, vB
+    instruction->vA = DX_INSTR_A(instr_unit);
+    instruction->vB = DX_INSTR_B(instr_unit);
+    return tb_true;
+}
+static tb_bool_t dx_instr_decode_11n(dx_instruction_ref_t instruction, tb_uint16_t const* instr, tb_uint16_t instr_unit)
+{
+    // op vA, #+B
+    instruction->vA = DX_INSTR_A(instr_unit);
 
+    // sign extend 4-bit value
+    instruction->vB = (tb_sint32_t)((tb_uint32_t)DX_INSTR_B(instr_unit) << 28) >> 28; 
+    return tb_true;
+}
+static tb_bool_t dx_instr_decode_11x(dx_instruction_ref_t instruction, tb_uint16_t const* instr, tb_uint16_t instr_unit)
+{
+    // op vAA
+    instruction->vA = DX_INSTR_AA(instr_unit);
+    return tb_true;
+}
+static tb_bool_t dx_instr_decode_10t(dx_instruction_ref_t instruction, tb_uint16_t const* instr, tb_uint16_t instr_unit)
+{
+    // op +AA, sign-extend 8-bit value
+    instruction->vA = (tb_sint8_t)DX_INSTR_AA(instr_unit);              
+    return tb_true;
+}
+static tb_bool_t dx_instr_decode_20t(dx_instruction_ref_t instruction, tb_uint16_t const* instr, tb_uint16_t instr_unit)
+{
+    // op +AAAA, sign-extend 16-bit value
+    instruction->vA = (tb_sint16_t)DX_FETCH_u2(instr, 1);
+    return tb_true;
+}
+static tb_bool_t dx_instr_decode_21c(dx_instruction_ref_t instruction, tb_uint16_t const* instr, tb_uint16_t instr_unit)
+{
+    /* op vAA, thing@BBBB
+     * op vAA, vBBBB (22x)
+     * [opt] op AA, thing@BBBB (20bc)
+     * op vAA, #+BBBB0000[00000000] (21h)
+     *
+     * the value of 21h should be treated as right-zero-extended, but we don't actually do that here.
+     * among other things, we don't know if it's the top bits of a 32-bit or 64-bit value.
+     */
+    instruction->vA = DX_INSTR_AA(instr_unit);
+    instruction->vB = DX_FETCH_u2(instr, 1);
+    return tb_true;
+}
+static tb_bool_t dx_instr_decode_21s(dx_instruction_ref_t instruction, tb_uint16_t const* instr, tb_uint16_t instr_unit)
+{
+    // op vAA, #+BBBB or op vAA, +BBBB (21t)
+    instruction->vA = DX_INSTR_AA(instr_unit);
 
-/* //////////////////////////////////////////////////////////////////////////////////////
- * private implementation 
- */
-static __tb_inline__ tb_uint16_t dx_instr_get_opcode(tb_uint16_t instr_unit) 
+    // sign-extend 16-bit value
+    instruction->vB = (tb_sint16_t)DX_FETCH_u2(instr, 1);                   
+    return tb_true;
+}
+static tb_bool_t dx_instr_decode_23x(dx_instruction_ref_t instruction, tb_uint16_t const* instr, tb_uint16_t instr_unit)
 {
-    // get opcode
-    tb_uint16_t low_byte = instr_unit & 0xff;
-    return (low_byte != 0xff)? low_byte : ((instr_unit >> 8) | 0x100);
+    // op vAA, vBB, vCC
+    instruction->vA = DX_INSTR_AA(instr_unit);
+    instruction->vB = DX_FETCH_u2(instr, 1) & 0xff;
+    instruction->vC = DX_FETCH_u2(instr, 1) >> 8;
+    return tb_true;
 }
-static __tb_inline__ tb_uint8_t dx_instr_get_width_from_opcode(tb_uint16_t opcode)
+static tb_bool_t dx_instr_decode_22b(dx_instruction_ref_t instruction, tb_uint16_t const* instr, tb_uint16_t instr_unit)
 {
-    // check
-    tb_assert(opcode < tb_arrayn(g_instr_width_table));
+    // op vAA, vBB, #+CC, sign-extend 8-bit value
+    instruction->vA = DX_INSTR_AA(instr_unit);
+    instruction->vB = DX_FETCH_u2(instr, 1) & 0xff;
+    instruction->vC = (tb_sint8_t)(DX_FETCH_u2(instr, 1) >> 8);
+    return tb_true;
+}
+static tb_bool_t dx_instr_decode_22s(dx_instruction_ref_t instruction, tb_uint16_t const* instr, tb_uint16_t instr_unit)
+{
+    // op vA, vB, #+CCCC or op vA, vB, +CCCC (22t)
+    instruction->vA = DX_INSTR_A(instr_unit);
+    instruction->vB = DX_INSTR_B(instr_unit); 
 
-    // get it
-    return g_instr_info.widths[opcode];
+    // sign-extend 16-bit value
+    instruction->vC = (tb_sint16_t)DX_FETCH_u2(instr, 1);
+    return tb_true;
 }
-static __tb_inline__ tb_uint8_t dx_instr_get_format_from_opcode(tb_uint16_t opcode)
+static tb_bool_t dx_instr_decode_22c(dx_instruction_ref_t instruction, tb_uint16_t const* instr, tb_uint16_t instr_unit)
 {
-    // check
-    tb_assert(opcode < tb_arrayn(g_instr_format_table));
+    // op vA, vB, thing@CCCC or [opt] op vA, vB, field offset CCCC (22cs)
+    instruction->vA = DX_INSTR_A(instr_unit);
+    instruction->vB = DX_INSTR_B(instr_unit);
+    instruction->vC = DX_FETCH_u2(instr, 1);
+    return tb_true;
+}
+static tb_bool_t dx_instr_decode_30t(dx_instruction_ref_t instruction, tb_uint16_t const* instr, tb_uint16_t instr_unit)
+{
+    // op +AAAAAAAA, signed 32-bit value
+    instruction->vA = DX_FETCH_u4(instr, 1);                     
+    return tb_true;
+}
+static tb_bool_t dx_instr_decode_31t(dx_instruction_ref_t instruction, tb_uint16_t const* instr, tb_uint16_t instr_unit)
+{
+    // op vAA, +BBBBBBBB or op vAA, string@BBBBBBBB (31c) or op vAA, #+BBBBBBBB (31i)
+    instruction->vA = DX_INSTR_AA(instr_unit);
 
-    // get it
-    return g_instr_info.formats[opcode];
+    // 32-bit value
+    instruction->vB = DX_FETCH_u4(instr, 1);
+    return tb_true;
 }
-static __tb_inline__ tb_uint8_t dx_instr_get_index_type_from_opcode(tb_uint16_t opcode)
+static tb_bool_t dx_instr_decode_32x(dx_instruction_ref_t instruction, tb_uint16_t const* instr, tb_uint16_t instr_unit)
 {
-    // check
-    tb_assert(opcode < tb_arrayn(g_instr_index_type_table));
+    // op vAAAA, vBBBB
+    instruction->vA = DX_FETCH_u2(instr, 1);
+    instruction->vB = DX_FETCH_u2(instr, 2);
+    return tb_true;
+}
+static tb_bool_t dx_instr_decode_35c(dx_instruction_ref_t instruction, tb_uint16_t const* instr, tb_uint16_t instr_unit)
+{
+    /* op {vC, vD, vE, vF, vG}, thing@BBBB
+     * [opt] invoke-virtual+super (35ms)
+     * [opt] inline invoke (35mi)
+     */
+    instruction->vA = DX_INSTR_B(instr_unit);
+    instruction->vB = DX_FETCH_u2(instr, 1);
 
-    // get it
-    return g_instr_info.index_types[opcode];
+    // get registers
+    tb_uint16_t regs = DX_FETCH_u2(instr, 2);
+
+    // copy the argument registers into the arg[] array, and also copy the first argument (if any) into vC. 
+    tb_uint32_t count = instruction->vA;
+    switch (count) 
+    {
+    case 5: 
+        {
+            // a fifth argument is verboten for inline invokes.
+            if (instruction->format == DX_INSTR_FMT_35mi) 
+            {
+                // trace
+                tb_trace_e("Invalid arg count in 35mi (5)");
+
+                // failed
+                tb_assert(0);
+                return tb_false;
+            }
+
+            /* per note at the top of this format decoder, 
+             * the fifth argument comes from the A field in the instruction, 
+             * but it's labeled G in the spec.
+             */
+            instruction->arg[4] = DX_INSTR_A(instr_unit);
+        }
+    case 4: instruction->arg[3] = (regs >> 12) & 0x0f;
+    case 3: instruction->arg[2] = (regs >> 8) & 0x0f;
+    case 2: instruction->arg[1] = (regs >> 4) & 0x0f;
+    case 1: instruction->vC = instruction->arg[0] = regs & 0x0f; break;
+    case 0: break; // valid, but no need to do anything.
+    default:
+        {
+            // trace
+            tb_trace_e("invalid argument count %u in 35c/35ms/35mi", count);
+
+            // failed
+            tb_assert(0);
+            return tb_false;
+        }
+    }
+    return tb_true;
+}
+static tb_bool_t dx_instr_decode_3rc(dx_instruction_ref_t instruction, tb_uint16_t const* instr, tb_uint16_t instr_unit)
+{
+    /* op {vCCCC .. v(CCCC+AA-1)}, meth@BBBB
+     * [opt] invoke-virtual+super/range (3rms)
+     * [opt] execute-inline/range (3rmi)
+     */
+    instruction->vA = DX_INSTR_AA(instr_unit);
+    instruction->vB = DX_FETCH_u2(instr, 1);
+    instruction->vC = DX_FETCH_u2(instr, 2);
+    return tb_true;
 }
+static tb_bool_t dx_instr_decode_51l(dx_instruction_ref_t instruction, tb_uint16_t const* instr, tb_uint16_t instr_unit)
+{
+    // op vAA, #+BBBBBBBBBBBBBBBB
+    instruction->vA       = DX_INSTR_AA(instr_unit);
+    instruction->vB_wide  = DX_FETCH_u4(instr, 1) | ((tb_uint64_t)DX_FETCH_u4(instr, 3) << 32);
+    return tb_true;
+}
+
+// the instruction decoders, indexed by the instruction format
+static dx_instr_decoder_t const g_instr_decoders[] = 
+{
+    dx_instr_decode_00x     // 00x
+,   dx_instr_decode_10x     // 10x
+,   dx_instr_decode_12x     // 12x
+,   dx_instr_decode_11n     // 11n
+,   dx_instr_decode_11x     // 11x
+,   dx_instr_decode_10t     // 10t
+,   dx_instr_decode_21c     // 20bc
+,   dx_instr_decode_20t     // 20t
+,   dx_instr_decode_21c     // 22x
+,   dx_instr_decode_21s     // 21t
+,   dx_instr_decode_21s     // 21s
+,   dx_instr_decode_21c     // 21h
+,   dx_instr_decode_21c     // 21c
+,   dx_instr_decode_23x     // 23x
+,   dx_instr_decode_22b     // 22b
+,   dx_instr_decode_22s     // 22t
+,   dx_instr_decode_22s     // 22s
+,   dx_instr_decode_22c     // 22c
+,   dx_instr_decode_22c     // 22cs
+,   dx_instr_decode_30t     // 30t
+,   dx_instr_decode_32x     // 32x
+,   dx_instr_decode_31t     // 31i
+,   dx_instr_decode_31t     // 31t
+,   dx_instr_decode_31t     // 31c
+,   dx_instr_decode_35c     // 35c
+,   dx_instr_decode_35c     // 35ms
+,   dx_instr_decode_3rc     // 3rc
+,   dx_instr_decode_3rc     // 3rms
+,   dx_instr_decode_51l     // 51l
+,   dx_instr_decode_35c     // 35mi
+,   dx_instr_decode_3rc     // 3rmi
+,   dx_instr_decode_00x     // 45cc, not supported now
+,   dx_instr_decode_00x     // 4rcc, not supported now
+};
 #ifdef DX_DUMP_ENABLE
 static tb_char_t const* dx_instr_get_index_info(dx_file_ref_t file, dx_instruction_ref_t instruction, tb_string_ref_t index_info)
 {
@@ -725,13 +782,13 @@ static tb_char_t const* dx_instr_get_index_info(dx_file_ref_t file, dx_instructi
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation 
  */
-tb_uint8_t dx_instr_width(tb_uint16_t const* instr)
+tb_size_t dx_instr_width(tb_uint16_t const* instr)
 {
     // check
     tb_assert(instr);
 
     // get width
-    tb_uint8_t  width = 0;
+    tb_size_t   width = 0;
     tb_uint16_t instr_unit = DX_FETCH_u2(instr, 0);
     if (instr_unit == DX_INSTR_IDENT_PACKED_SWITCH_PAYLOAD) 
         width = 4 + (DX_FETCH_u2(instr, 1) << 1);
@@ -740,13 +797,13 @@ tb_uint8_t dx_instr_width(tb_uint16_t const* instr)
     else if (instr_unit == DX_INSTR_IDENT_FILL_ARRAY_DATA)
     {
         // the plus 1 is to round up for odd size and width.
-        tb_size_t w = DX_FETCH_u2(instr, 1);
-        tb_size_t n = DX_FETCH_u2(instr, 2) | (DX_FETCH_u2(instr, 3) << 16);
-        tb_assert(4 + (((n * w) + 1) >> 1) <= TB_MAXU32);
-        width = (tb_uint8_t)(4 + (((n * w) + 1) >> 1));
+        tb_hize_t w = DX_FETCH_u2(instr, 1);
+        tb_hize_t n = DX_FETCH_u4(instr, 2);
+        tb_hize_t v = 4 + (((n * w) + 1) >> 1);
+        width = (tb_size_t)(v <= TB_MAXU32? v : TB_MAXU32);
     }
     // get width from opcode
-    else width = dx_instr_get_width_from_opcode(dx_instr_get_opcode(instr_unit));
+    else width = DX_INSTR_INFO_WIDTH(dx_instr_get_info(dx_instr_get_opcode(instr_unit)));
     return width;
 }
 tb_bool_t dx_instr_decode(tb_uint16_t const* instr, dx_instruction_ref_t instruction)
@@ -754,229 +811,24 @@ tb_bool_t dx_instr_decode(tb_uint16_t const* instr, dx_instruction_ref_t instruc
     // check
     tb_assert(instr && instruction);
 
-    // get instruction data
-    instruction->instr = instr;
-
-    // get instruction code
-    tb_uint16_t instr_unit = DX_FETCH_u2(instr, 0);
-
-    // get instruction opcode
-    tb_uint16_t opcode = dx_instr_get_opcode(instr_unit);
-    instruction->opcode = opcode;
-
-    // get instruction width
-    instruction->width = dx_instr_width(instr);
-
-    // get instruction index type
-    instruction->index_type = dx_instr_get_index_type_from_opcode(opcode);
-
-    // get instruction format
-    instruction->format = dx_instr_get_format_from_opcode(opcode);
-    switch (instruction->format)
-    {
-    case DX_INSTR_FMT_10x:      // op
-        {
-            // nothing to do; copy the AA bits out for the verifier 
-            instruction->vA = DX_INSTR_AA(instr_unit);
-        }
-        break;
-    case DX_INSTR_FMT_12x:      // op vA, vB
-        {
-            instruction->vA = DX_INSTR_A(instr_unit);
-            instruction->vB = DX_INSTR_B(instr_unit);
-        }
-        break;
-    case DX_INSTR_FMT_11n:      // op vA, #+B
-        {
-            instruction->vA = DX_INSTR_A(instr_unit);
-            
-            // sign extend 4-bit value
-            instruction->vB = (tb_sint32_t)(DX_INSTR_B(instr_unit) << 28) >> 28; 
-        }
-        break;
-    case DX_INSTR_FMT_11x:      // op vAA
-        {
-            instruction->vA = DX_INSTR_AA(instr_unit);
-        }
-        break;
-    case DX_INSTR_FMT_10t:      // op +AA
-        {
-            // sign-extend 8-bit value
-            instruction->vA = (tb_sint8_t)DX_INSTR_AA(instr_unit);              
-        }
-        break;
-    case DX_INSTR_FMT_20t:      // op +AAAA
-        {
-            // sign-extend 16-bit value
-            instruction->vA = (tb_sint16_t)DX_FETCH_u2(instr, 1);
-        }
-        break;
-    case DX_INSTR_FMT_20bc:     // [opt] op AA, thing@BBBB
-    case DX_INSTR_FMT_21c:      // op vAA, thing@BBBB
-    case DX_INSTR_FMT_22x:      // op vAA, vBBBB
-        {
-            instruction->vA = DX_INSTR_AA(instr_unit);
-            instruction->vB = DX_FETCH_u2(instr, 1);
-        }
-        break;
-    case DX_INSTR_FMT_21s:      // op vAA, #+BBBB
-    case DX_INSTR_FMT_21t:      // op vAA, +BBBB
-        {
-            instruction->vA = DX_INSTR_AA(instr_unit);
-            
-            // sign-extend 16-bit value
-            instruction->vB = (tb_sint16_t)DX_FETCH_u2(instr, 1);                   
-        }
-        break;
-    case DX_INSTR_FMT_21h:      // op vAA, #+BBBB0000[00000000]
-        {
-            instruction->vA = DX_INSTR_AA(instr_unit);
-
-            /* the value should be treated as right-zero-extended, but we don't actually do that here.
-             * among other things, we don't know if it's the top bits of a 32-bit or 64-bit value.
-             */
-            instruction->vB = DX_FETCH_u2(instr, 1);
-        }
-        break;
-    case DX_INSTR_FMT_23x:      // op vAA, vBB, vCC
-        {
-            instruction->vA = DX_INSTR_AA(instr_unit);
-            instruction->vB = DX_FETCH_u2(instr, 1) & 0xff;
-            instruction->vC = DX_FETCH_u2(instr, 1) >> 8;
-        }
-        break;
-    case DX_INSTR_FMT_22b:      // op vAA, vBB, #+CC
-        {
-            // sign-extend 8-bit value
-            instruction->vA = DX_INSTR_AA(instr_unit);
-            instruction->vB = DX_FETCH_u2(instr, 1) & 0xff;
-            instruction->vC = (tb_sint8_t)(DX_FETCH_u2(instr, 1) >> 8);
-        }
-        break;
-    case DX_INSTR_FMT_22s:      // op vA, vB, #+CCCC
-    case DX_INSTR_FMT_22t:      // op vA, vB, +CCCC
-        {
-            instruction->vA = DX_INSTR_A(instr_unit);
-            instruction->vB = DX_INSTR_B(instr_unit); 
-            
-            // sign-extend 16-bit value
-            instruction->vC = (tb_sint16_t) DX_FETCH_u2(instr, 1);
-        }
-        break;
-    case DX_INSTR_FMT_22c:      // op vA, vB, thing@CCCC
-    case DX_INSTR_FMT_22cs:     // [opt] op vA, vB, field offset CCCC
-        {
-            instruction->vA = DX_INSTR_A(instr_unit);
-            instruction->vB = DX_INSTR_B(instr_unit);
-            instruction->vC = DX_FETCH_u2(instr, 1);
-        }
-        break;
-    case DX_INSTR_FMT_30t:      // op +AAAAAAAA
-        {
-            // signed 32-bit value
-            instruction->vA = DX_FETCH_u4(instr, 1);                     
-        }
-        break;
-    case DX_INSTR_FMT_31t:      // op vAA, +BBBBBBBB
-    case DX_INSTR_FMT_31c:      // op vAA, string@BBBBBBBB
-        {
-            instruction->vA = DX_INSTR_AA(instr_unit);
-                     
-            // 32-bit value
-            instruction->vB = DX_FETCH_u4(instr, 1);
-        }
-        break;
-    case DX_INSTR_FMT_32x:      // op vAAAA, vBBBB
-        {
-            instruction->vA = DX_FETCH_u2(instr, 1);
-            instruction->vB = DX_FETCH_u2(instr, 2);
-        }
-        break;
-    case DX_INSTR_FMT_31i:      // op vAA, #+BBBBBBBB
-        {
-            instruction->vA = DX_INSTR_AA(instr_unit);
-                    
-            // signed 32-bit value
-            instruction->vB = DX_FETCH_u4(instr, 1);
-        }
-        break;
-    case DX_INSTR_FMT_35c:      // op {vC, vD, vE, vF, vG}, thing@BBBB
-    case DX_INSTR_FMT_35ms:     // [opt] invoke-virtual+super
-    case DX_INSTR_FMT_35mi:     // [opt] inline invoke
-        {
-            // get vA/B
-            instruction->vA = DX_INSTR_B(instr_unit);
-            instruction->vB = DX_FETCH_u2(instr, 1);
+    // get instruction code and opcode
+    tb_uint16_t instr_unit  = DX_FETCH_u2(instr, 0);
+    tb_uint16_t opcode      = dx_instr_get_opcode(instr_unit);
 
-            // get registers
-            tb_uint16_t regs = DX_FETCH_u2(instr, 2);
-
-            // copy the argument registers into the arg[] array, and also copy the first argument (if any) into vC. 
-            tb_uint32_t count = instruction->vA;
-            switch (count) 
-            {
-            case 5: 
-                {
-                    // a fifth argument is verboten for inline invokes.
-                    if (instruction->format == DX_INSTR_FMT_35mi) 
-                    {
-                        // trace
-                        tb_trace_e("Invalid arg count in 35mi (5)");
-
-                        // failed
-                        tb_assert(0);
-                        return tb_false;
-                    }
-
-                    /* per note at the top of this format decoder, 
-                     * the fifth argument comes from the A field in the instruction, 
-                     * but it's labeled G in the spec.
-                     */
-                    instruction->arg[4] = DX_INSTR_A(instr_unit);
-            }
-            case 4: instruction->arg[3] = (regs >> 12) & 0x0f;
-            case 3: instruction->arg[2] = (regs >> 8) & 0x0f;
-            case 2: instruction->arg[1] = (regs >> 4) & 0x0f;
-            case 1: instruction->vC = instruction->arg[0] = regs & 0x0f; break;
-            case 0: break; // valid, but no need to do anything.
-            default:
-                {
-                    // trace
-                    tb_trace_e("invalid argument count %u in 35c/35ms/35mi", count);
+    // get the packed instruction info
+    tb_uint32_t info        = dx_instr_get_info(opcode);
+    instruction->instr      = instr;
+    instruction->opcode     = opcode;
+    instruction->format     = DX_INSTR_INFO_FORMAT(info);
+    instruction->index_type = DX_INSTR_INFO_INDEX_TYPE(info);
+    instruction->flags      = DX_INSTR_INFO_FLAGS(info);
 
-                    // failed
-                    tb_assert(0);
-                    return tb_false;
-                }
-            }
-        }
-        break;
-    case DX_INSTR_FMT_3rc:      // op {vCCCC .. v(CCCC+AA-1)}, meth@BBBB
-    case DX_INSTR_FMT_3rms:     // [opt] invoke-virtual+super/range
-    case DX_INSTR_FMT_3rmi:     // [opt] execute-inline/range
-        {
-            instruction->vA = DX_INSTR_AA(instr_unit);
-            instruction->vB = DX_FETCH_u2(instr, 1);
-            instruction->vC = DX_FETCH_u2(instr, 2);
-        }
-        break;
-    case DX_INSTR_FMT_51l:      // op vAA, #+BBBBBBBBBBBBBBBB
-        {
-            instruction->vA       = DX_INSTR_AA(instr_unit);
-            instruction->vB_wide  = DX_FETCH_u4(instr, 1) | ((tb_uint64_t)DX_FETCH_u4(instr, 3) << 32);
-        }
-        break;
-    default:
-        {
-            // trace
-            tb_trace_e("invalid instruction, code: %x, format: %lu, opcode: %u", instr_unit, instruction->format, opcode);
+    // get instruction width, only the payload pseudo-instructions of nop need to compute it
+    instruction->width      = opcode? DX_INSTR_INFO_WIDTH(info) : (tb_uint32_t)dx_instr_width(instr);
 
-            // failed
-            tb_assert(0);
-            return tb_false;
-        }
-    }
-    return tb_true;
+    // decode the operands by the format
+    tb_assert(instruction->format < tb_arrayn(g_instr_decoders));
+    return g_instr_decoders[instruction->format](instruction, instr, instr_unit);
 }
 tb_long_t dx_instr_packed_switch(tb_uint16_t const* instr, tb_sint32_t value)
 {
@@ -1027,6 +879,96 @@ tb_long_t dx_instr_packed_switch(tb_uint16_t const* instr, tb_sint32_t value)
     // ok?
     return offset;
 }
+tb_long_t dx_instr_sparse_switch(tb_uint16_t const* instr, tb_sint32_t value)
+{
+    // check
+    tb_assert(instr);
+
+    /* done
+     *
+     * sparse-switch-payload format:
+     *  u2 ident            magic value(DX_INSTR_IDENT_SPARSE_SWITCH_PAYLOAD)
+     *  u2 size             number of entries in the table
+     *  s4 keys[size]       keys, sorted low-to-high
+     *  s4 targets[size]    branch targets, relative to switch opcode
+     *
+     * total size is (2 + size * 4) 16-bit code units.
+     */
+    tb_bool_t ok = tb_false;
+    tb_long_t offset = 0;
+    do
+    {
+        // get ident
+        tb_uint16_t ident = DX_FETCH_u2(instr, 0);
+        tb_assert_and_check_break(ident == DX_INSTR_IDENT_SPARSE_SWITCH_PAYLOAD);
+        
+        // get size
+        tb_size_t size = DX_FETCH_u2(instr, 1);
+        tb_check_break(size);
+
+        // find the key index
+        tb_size_t index = 0;
+#ifdef DX_INSTR_SSE2
+        if (size <= DX_INSTR_SPARSE_SWITCH_SIMD_MAXN)
+        {
+            // compare four keys at once, the keys are little-endian and the code units are too
+            tb_size_t           i = 0;
+            tb_uint32_t         mask = 0;
+            __m128i const       v = _mm_set1_epi32(value);
+            tb_byte_t const*    keys = (tb_byte_t const*)(instr + 2);
+            for (i = 0; i + 4 <= size && !mask; i += 4)
+                mask = (tb_uint32_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_loadu_si128((__m128i const*)(keys + (i << 2))), v)));
+            if (mask) index = i - 4 + tb_bits_fb1_u32_le(mask);
+            else
+            {
+                // compare the left keys
+                for (; i < size && (tb_sint32_t)DX_FETCH_u4(instr, 2 + (i << 1)) != value; i++) ;
+                index = i;
+            }
+            tb_check_break(index < size);
+        }
+        else
+#endif
+        {
+            // the branch-free binary search, the conditional move is used instead of the branch
+            tb_size_t n = size;
+            while (n > 1)
+            {
+                tb_size_t half = n >> 1;
+                index = (tb_sint32_t)DX_FETCH_u4(instr, 2 + ((index + half) << 1)) <= value? index + half : index;
+                n -= half;
+            }
+            tb_check_break((tb_sint32_t)DX_FETCH_u4(instr, 2 + (index << 1)) == value);
+        }
+
+        // get offset
+        offset = (tb_sint32_t)DX_FETCH_u4(instr, 2 + (size << 1) + (index << 1));
+
+        // ok
+        ok = tb_true;
+    
+    } while (0);
+
+    // failed? return the size of the sparse-switch instruction
+    if (!ok) offset = 3;
+
+    // ok?
+    return offset;
+}
+tb_bool_t dx_instr_sparse_switch_sorted(tb_uint16_t const* instr)
+{
+    // check
+    tb_assert_and_check_return_val(instr && DX_FETCH_u2(instr, 0) == DX_INSTR_IDENT_SPARSE_SWITCH_PAYLOAD, tb_false);
+
+    // the keys must be sorted low-to-high without the duplicate keys
+    tb_size_t i = 0;
+    tb_size_t size = DX_FETCH_u2(instr, 1);
+    for (i = 1; i < size; i++)
+    {
+        tb_check_return_val((tb_sint32_t)DX_FETCH_u4(instr, 2 + ((i - 1) << 1)) < (tb_sint32_t)DX_FETCH_u4(instr, 2 + (i << 1)), tb_false);
+    }
+    return tb_true;
+}
 #ifdef DX_DUMP_ENABLE
 tb_void_t dx_instr_dump(dx_instruction_ref_t instruction, tb_size_t instr_idx, dx_file_ref_t file)
 {
@@ -1081,7 +1023,7 @@ tb_void_t dx_instr_dump(dx_instruction_ref_t instruction, tb_size_t instr_idx, d
         index_info = dx_instr_get_index_info(file, instruction, &index_data);
 
     // dump opcode descriptor
-    switch (dx_instr_get_format_from_opcode(instruction->opcode)) 
+    switch (instruction->format) 
     {
     case DX_INSTR_FMT_10x:      // op
         break;
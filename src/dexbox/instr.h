@@ -31,6 +31,19 @@
  */
 __tb_extern_c_enter__
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the identifying pseudo-opcode of the packed-switch payload
+#define DX_INSTR_IDENT_PACKED_SWITCH_PAYLOAD        (0x0100)
+
+/// the identifying pseudo-opcode of the sparse-switch payload
+#define DX_INSTR_IDENT_SPARSE_SWITCH_PAYLOAD        (0x0200)
+
+/// the identifying pseudo-opcode of the fill-array-data payload
+#define DX_INSTR_IDENT_FILL_ARRAY_DATA              (0x0300)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -124,8 +137,8 @@ typedef struct __dx_instruction_t
     // the opcode
     tb_uint16_t         opcode;
 
-    // the width
-    tb_uint8_t          width;
+    // the width in the 16-bit code units, the payload pseudo-instructions may be larger than 255
+    tb_uint32_t         width;
 
     // the format
     tb_uint8_t          format;
@@ -133,6 +146,9 @@ typedef struct __dx_instruction_t
     // the index type
     tb_uint8_t          index_type;
 
+    // the control flow flags, e.g. DX_INSTR_FLAGS_CAN_BRANCH
+    tb_uint8_t          flags;
+
 }dx_instruction_t, *dx_instruction_ref_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -143,9 +159,9 @@ typedef struct __dx_instruction_t
  *
  * @param instr         the dex instruction 
  *
- * @return              the instruction width
+ * @return              the instruction width in the 16-bit code units, the payload pseudo-instructions may be larger than 255
  */
-tb_uint8_t              dx_instr_width(tb_uint16_t const* instr);
+tb_size_t               dx_instr_width(tb_uint16_t const* instr);
 
 /*! decode the instruction 
  *
@@ -165,6 +181,31 @@ tb_bool_t               dx_instr_decode(tb_uint16_t const* instr, dx_instruction
  */
 tb_long_t               dx_instr_packed_switch(tb_uint16_t const* instr, tb_sint32_t value);
 
+/*! sparse-switch the instruction 
+ *
+ * the keys are found by the branch-free binary search, or compared by simd if there are only a few keys.
+ *
+ * @note the keys must be sorted low-to-high, the result is undefined if dx_instr_sparse_switch_sorted() fails.
+ * the unsorted payloads are rejected by the structure validation, dx_code_switches() and dx_cfg_build(),
+ * so we need check it first only if the payload has been not checked by them.
+ *
+ * @param instr         the sparse-switch payload
+ * @param value         the test value
+ *
+ * @return              the frame pc offset, failed: the instruction size(3)
+ */
+tb_long_t               dx_instr_sparse_switch(tb_uint16_t const* instr, tb_sint32_t value);
+
+/*! are the keys of the sparse-switch payload sorted low-to-high?
+ *
+ * the payload with the unsorted or duplicate keys is malformed.
+ *
+ * @param instr         the sparse-switch payload, the whole payload must be in the code
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               dx_instr_sparse_switch_sorted(tb_uint16_t const* instr);
+
 #ifdef DX_DUMP_ENABLE
 /*! dump the instruction
  *
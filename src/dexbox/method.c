@@ -31,6 +31,39 @@
 #include "dexbox.h"
 #include "impl/impl.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation 
+ */
+static dx_proto_t* dx_method_get_proto(dx_file_t* dexfile, tb_size_t proto_idx)
+{
+    // check
+    tb_assert_and_check_return_val(proto_idx < dexfile->header->proto_ids_size, tb_null);
+
+    // init the shared protos at the first time
+    dx_proto_t* protos = (dx_proto_t*)dx_pointer_get((tb_pointer_t const*)&dexfile->protos);
+    if (!protos)
+    {
+        // make all protos with one pass over proto_ids
+        tb_size_t   i = 0;
+        tb_size_t   n = dexfile->header->proto_ids_size;
+        dx_proto_t* protos_new = tb_nalloc0_type(n, dx_proto_t);
+        tb_assert_and_check_return_val(protos_new, tb_null);
+        for (i = 0; i < n; i++)
+        {
+            protos_new[i].dexfile       = dexfile;
+            protos_new[i].proto_idx     = (tb_uint32_t)i;
+            protos_new[i].parameters    = dx_file_get_proto_parameters(dexfile, dx_file_get_proto_id(dexfile, i));
+        }
+
+        // publish it, another thread may have published it
+        protos = (dx_proto_t*)dx_pointer_publish(&dexfile->protos, protos_new);
+        if (protos != protos_new) tb_free(protos_new);
+    }
+
+    // ok
+    return protos + proto_idx;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation 
  */
@@ -43,6 +76,68 @@ dx_code_ref_t dx_method_code(dx_method_ref_t method)
     // get it
     return (dx_code_ref_t)dx_method_get_code(dexmethod->dexfile, dexmethod);
 }
+dx_code_predecode_ref_t dx_method_predecode(dx_method_ref_t method)
+{
+    // check
+    dx_method_t* dexmethod = (dx_method_t*)method;
+    tb_assert_and_check_return_val(dexmethod && dexmethod->dexfile, tb_null);
+
+    // get the cached predecoded code
+    dx_file_t* dexfile = dexmethod->dexfile;
+    tb_check_return_val(dexmethod->method_idx < dexfile->predecodes.size, tb_null);
+    tb_pointer_t predecode = dx_ptable_get(&dexfile->predecodes, dexmethod->method_idx);
+    if (!predecode)
+    {
+        // get code
+        dx_code_t* code = dx_method_get_code(dexfile, dexmethod);
+        tb_check_return_val(code, tb_null);
+
+        // predecode it to the codes arena of this dex file
+        dx_arena_ref_t arena = dx_file_codes_arena(dexfile);
+        tb_assert_and_check_return_val(arena, tb_null);
+
+        predecode = dx_code_predecode((dx_code_ref_t)code, arena);
+
+        /* publish it or the failure, the malformed code will not be predecoded again,
+         * another thread may have published it and ours will be freed with the arena
+         */
+        predecode = dx_ptable_publish(&dexfile->predecodes, dexmethod->method_idx, predecode? predecode : DX_PTABLE_FAILED);
+    }
+
+    // ok?
+    return predecode != DX_PTABLE_FAILED? (dx_code_predecode_ref_t)predecode : tb_null;
+}
+dx_code_switches_ref_t dx_method_switches(dx_method_ref_t method)
+{
+    // check
+    dx_method_t* dexmethod = (dx_method_t*)method;
+    tb_assert_and_check_return_val(dexmethod && dexmethod->dexfile, tb_null);
+
+    // get the cached jump tables
+    dx_file_t* dexfile = dexmethod->dexfile;
+    tb_check_return_val(dexmethod->method_idx < dexfile->switches.size, tb_null);
+    tb_pointer_t switches = dx_ptable_get(&dexfile->switches, dexmethod->method_idx);
+    if (!switches)
+    {
+        // get code
+        dx_code_t* code = dx_method_get_code(dexfile, dexmethod);
+        tb_check_return_val(code, tb_null);
+
+        // compile them to the codes arena of this dex file
+        dx_arena_ref_t arena = dx_file_codes_arena(dexfile);
+        tb_assert_and_check_return_val(arena, tb_null);
+
+        switches = dx_code_switches((dx_code_ref_t)code, arena);
+
+        /* publish them or the failure, the malformed payloads will not be compiled again,
+         * another thread may have published them and ours will be freed with the arena
+         */
+        switches = dx_ptable_publish(&dexfile->switches, dexmethod->method_idx, switches? switches : DX_PTABLE_FAILED);
+    }
+
+    // ok?
+    return switches != DX_PTABLE_FAILED? (dx_code_switches_ref_t)switches : tb_null;
+}
 tb_char_t const* dx_method_name(dx_method_ref_t method)
 {
     // check
@@ -62,20 +157,12 @@ dx_proto_ref_t dx_method_proto(dx_method_ref_t method)
     dx_method_t* dexmethod = (dx_method_t*)method;
     tb_assert_and_check_return_val(dexmethod && dexmethod->dexfile, tb_null);
 
-    // the proto hasn't been initialized?
-    if (!dexmethod->proto.dexfile)
-    {
-        // get the method id
-        dx_method_id_ref_t method_id = dx_file_get_method_id(dexmethod->dexfile, dexmethod->method_idx);
-        tb_assert_and_check_return_val(method_id, tb_null);
-       
-        // init proto
-        dexmethod->proto.dexfile = dexmethod->dexfile;
-        dexmethod->proto.proto_idx = method_id->proto_idx;
-    }
+    // get the method id
+    dx_method_id_ref_t method_id = dx_file_get_method_id(dexmethod->dexfile, dexmethod->method_idx);
+    tb_assert_and_check_return_val(method_id, tb_null);
 
-    // get it
-    return (dx_proto_ref_t)&dexmethod->proto;
+    // get the shared proto
+    return (dx_proto_ref_t)dx_method_get_proto(dexmethod->dexfile, method_id->proto_idx);
 }
 tb_size_t dx_method_access(dx_method_ref_t method)
 {
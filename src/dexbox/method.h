@@ -94,6 +94,27 @@ tb_size_t               dx_method_access(dx_method_ref_t method);
  */
 dx_file_ref_t           dx_method_dexfile(dx_method_ref_t method);
 
+/*! get the predecoded code of the method, it will be predecoded and cached at the first time
+ *
+ * the predecoded code is kept until the dex file is exited or dx_file_codes_clear() is called,
+ * so it is still valid even if the method has been evicted from the class cache.
+ *
+ * @param method        the dex method 
+ *
+ * @return              the predecoded code, tb_null if there is no code or the code is malformed
+ */
+dx_code_predecode_ref_t dx_method_predecode(dx_method_ref_t method);
+
+/*! get the precompiled switch jump tables of the method, they will be compiled and cached at the first time
+ *
+ * the jump tables are kept until the dex file is exited or dx_file_codes_clear() is called.
+ *
+ * @param method        the dex method 
+ *
+ * @return              the jump tables, tb_null if there is no code or the code is malformed
+ */
+dx_code_switches_ref_t  dx_method_switches(dx_method_ref_t method);
+
 #ifdef DX_DUMP_ENABLE
 /*! dump method
  *
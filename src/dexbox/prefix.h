@@ -85,6 +85,12 @@ typedef __dx_typeref__(method);
 /// the dex field ref type
 typedef __dx_typeref__(field);
 
+/// the arena ref type
+typedef __dx_typeref__(arena);
+
+/// the dex set ref type
+typedef __dx_typeref__(dexset);
+
 // the dex try type
 typedef struct __dx_try_t 
 {
@@ -51,8 +51,9 @@ tb_size_t dx_proto_param_size(dx_proto_ref_t proto)
         dx_proto_id_ref_t proto_id = dx_file_get_proto_id(dexproto->dexfile, dexproto->proto_idx);
         tb_assert_and_check_return_val(proto_id, 0);
 
-        // get parameters
-        dexproto->parameters = dx_file_get_proto_parameters(dexproto->dexfile, proto_id);
+        // get parameters, the shared proto without parameters will not be written
+        dx_type_list_ref_t parameters = dx_file_get_proto_parameters(dexproto->dexfile, proto_id);
+        if (parameters) dexproto->parameters = parameters;
     }
 
     // get count
@@ -0,0 +1,86 @@
+package com.dexbox;
+
+/* the switches of the switch bench, they are compiled to the payloads:
+ *
+ * packed:          the packed-switch with the dense keys
+ * sparse_small:    the sparse-switch with a few keys, they are compared by simd
+ * sparse_large:    the sparse-switch with many keys, they are found by the binary search
+ */
+public class _switch 
+{
+    static public int packed(int value) 
+    {
+        switch (value)
+        {
+        case 10: return 100;
+        case 11: return 101;
+        case 12: return 102;
+        case 13: return 103;
+        case 14: return 104;
+        case 15: return 105;
+        case 16: return 106;
+        case 17: return 107;
+        default: return -1;
+        }
+    }
+    static public int sparse_large(int value) 
+    {
+        switch (value)
+        {
+        case -5000: return 100;
+        case -4963: return 101;
+        case -4852: return 102;
+        case -4667: return 103;
+        case -4408: return 104;
+        case -4075: return 105;
+        case -3668: return 106;
+        case -3187: return 107;
+        case -2632: return 108;
+        case -2003: return 109;
+        case -1300: return 110;
+        case -523: return 111;
+        case 328: return 112;
+        case 1253: return 113;
+        case 2252: return 114;
+        case 3325: return 115;
+        case 4472: return 116;
+        case 5693: return 117;
+        case 6988: return 118;
+        case 8357: return 119;
+        case 9800: return 120;
+        case 11317: return 121;
+        case 12908: return 122;
+        case 14573: return 123;
+        case 16312: return 124;
+        case 18125: return 125;
+        case 20012: return 126;
+        case 21973: return 127;
+        case 24008: return 128;
+        case 26117: return 129;
+        case 28300: return 130;
+        case 30557: return 131;
+        case 32888: return 132;
+        case 35293: return 133;
+        case 37772: return 134;
+        case 40325: return 135;
+        case 42952: return 136;
+        case 45653: return 137;
+        case 48428: return 138;
+        case 51277: return 139;
+        default: return -1;
+        }
+    }
+    static public int sparse_small(int value) 
+    {
+        switch (value)
+        {
+        case -1000: return 100;
+        case -7: return 101;
+        case 3: return 102;
+        case 42: return 103;
+        case 1000: return 104;
+        case 65536: return 105;
+        default: return -1;
+        }
+    }
+}
@@ -2,7 +2,9 @@ set_project("dexbox")
 set_xmakever("2.3.3")
 
 add_rules("mode.debug", "mode.release", "mode.releasedbg")
-add_requires("tbox 1.6.5", {debug = is_mode("debug")})
+
+-- the zip module and zlib package of tbox are required to inflate the deflated dex entries of the apk files
+add_requires("tbox 1.6.5", {debug = is_mode("debug"), configs = {zip = true, zlib = true}})
 
 if is_plat("windows") then 
     if is_mode("release") then
@@ -20,12 +22,21 @@ option("dump")
     set_description("Enable or disable dump interfaces.")
 option_end()
 
+option("uring")
+    set_default(false)
+    set_showmenu(true)
+    add_links("uring")
+    add_cincludes("liburing.h")
+    add_defines("DX_CONFIG_HAVE_LIBURING")
+    set_description("Enable or disable the io_uring reader of the batch loader on linux, it requires liburing.")
+option_end()
+
 target("dexbox")
     set_kind("static")
     add_files("src/dexbox/**.c")
     add_defines("__tb_prefix__=\"dexbox\"")
     add_includedirs("src", {interface = true})
-    add_options("dump")
+    add_options("dump", "uring")
     add_packages("tbox")
 
 target("dexdump")
@@ -35,6 +46,15 @@ target("dexdump")
     set_kind("binary")
     add_deps("dexbox")
     add_files("src/demo/dexdump.c")
+    add_options("uring")
     set_rundir("$(projectdir)")
     add_packages("tbox")
 
+target("dexbench")
+    set_default(false)
+    set_kind("binary")
+    add_deps("dexbox")
+    add_files("src/demo/dexbench.c")
+    add_options("uring")
+    set_rundir("$(projectdir)")
+    add_packages("tbox")